@@ -148,6 +148,13 @@ typedef struct PyConfig {
     int dump_refs;
     wchar_t *dump_refs_file;
     int malloc_stats;
+    int malloc_arenas_huge_pages;
+    int malloc_arenas_retained;
+    int float_freelist_size;
+    int tuple_freelist_size;
+    int list_freelist_size;
+    int dict_freelist_size;
+    int adaptive_freelists;
     wchar_t *filesystem_encoding;
     wchar_t *filesystem_errors;
     wchar_t *pycache_prefix;
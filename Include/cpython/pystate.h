@@ -69,6 +69,26 @@ typedef struct _stack_chunk {
     PyObject * data[1]; /* Variable sized */
 } _PyStackChunk;
 
+/* Number of buckets of the GIL wait and hold time histograms: bucket 0
+   counts durations shorter than 1 microsecond, bucket i counts durations of
+   2**(i-1) to 2**i microseconds and the last bucket counts all the longer
+   ones. */
+#define _Py_GIL_HISTOGRAM_BUCKETS 24
+
+/* How a thread used the GIL, see sys._getgilstats().  The durations are
+   _PyTime_t values. */
+typedef struct {
+    uint64_t acquisitions;
+    int64_t wait_total;
+    int64_t wait_max;
+    /* Number of times the thread released the GIL after another thread
+       requested it. */
+    uint64_t forced_drops;
+    /* When the thread last took the GIL, or 0. */
+    int64_t hold_start;
+    uint64_t hold_histogram[_Py_GIL_HISTOGRAM_BUCKETS];
+} _PyGILThreadStats;
+
 // The PyThreadState typedef is in Include/pystate.h.
 struct _ts {
     /* See Python/ceval.c for comments explaining most fields */
@@ -168,6 +188,11 @@ struct _ts {
     _PyStackChunk *datastack_chunk;
     PyObject **datastack_top;
     PyObject **datastack_limit;
+    /* Small blocks freed by this thread, kept by pymalloc for reuse. */
+    struct _obmalloc_thread_cache *obmalloc_cache;
+    /* Rank of the thread under the priority GIL policy. */
+    int gil_priority;
+    _PyGILThreadStats gil_stats;
     /* XXX signal handlers should also be here */
 
 };
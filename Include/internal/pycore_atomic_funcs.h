@@ -5,6 +5,16 @@
 
    * value = _Py_atomic_size_get(&var)
    * _Py_atomic_size_set(&var, value)
+   * old = _Py_atomic_size_add(&var, value)
+
+   uintptr_t type:
+
+   * value = _Py_atomic_uintptr_get(&var)
+   * old = _Py_atomic_uintptr_add(&var, value)
+   * ok = _Py_atomic_uintptr_compare_exchange(&var, expected, value)
+
+   The read-modify-write functions (_add and _compare_exchange) are only
+   available if _Py_HAVE_ATOMIC_RMW is defined.
 
    Use sequentially-consistent ordering (__ATOMIC_SEQ_CST memory order):
    enforce total ordering with all other atomic functions.
@@ -37,6 +47,31 @@ static inline void _Py_atomic_size_set(Py_ssize_t *var, Py_ssize_t value)
     __atomic_store_n(var, value, __ATOMIC_SEQ_CST);
 }
 
+static inline Py_ssize_t _Py_atomic_size_add(Py_ssize_t *var, Py_ssize_t value)
+{
+    return __atomic_fetch_add(var, value, __ATOMIC_SEQ_CST);
+}
+
+static inline uintptr_t _Py_atomic_uintptr_get(uintptr_t *var)
+{
+    return __atomic_load_n(var, __ATOMIC_SEQ_CST);
+}
+
+static inline uintptr_t _Py_atomic_uintptr_add(uintptr_t *var, uintptr_t value)
+{
+    return __atomic_fetch_add(var, value, __ATOMIC_SEQ_CST);
+}
+
+static inline int
+_Py_atomic_uintptr_compare_exchange(uintptr_t *var, uintptr_t expected,
+                                    uintptr_t value)
+{
+    return __atomic_compare_exchange_n(var, &expected, value, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+#define _Py_HAVE_ATOMIC_RMW
+
 #elif defined(_MSC_VER)
 
 static inline Py_ssize_t _Py_atomic_size_get(Py_ssize_t *var)
@@ -72,6 +107,47 @@ static inline void _Py_atomic_size_set(Py_ssize_t *var, Py_ssize_t value)
 #endif
 }
 
+static inline Py_ssize_t _Py_atomic_size_add(Py_ssize_t *var, Py_ssize_t value)
+{
+#if SIZEOF_VOID_P == 8
+    Py_BUILD_ASSERT(sizeof(__int64) == sizeof(*var));
+    return _InterlockedExchangeAdd64((volatile __int64 *)var, value);
+#else
+    Py_BUILD_ASSERT(sizeof(long) == sizeof(*var));
+    return _InterlockedExchangeAdd((volatile long *)var, value);
+#endif
+}
+
+static inline uintptr_t _Py_atomic_uintptr_get(uintptr_t *var)
+{
+    return (uintptr_t)_Py_atomic_size_get((Py_ssize_t *)var);
+}
+
+static inline uintptr_t _Py_atomic_uintptr_add(uintptr_t *var, uintptr_t value)
+{
+    return (uintptr_t)_Py_atomic_size_add((Py_ssize_t *)var,
+                                          (Py_ssize_t)value);
+}
+
+static inline int
+_Py_atomic_uintptr_compare_exchange(uintptr_t *var, uintptr_t expected,
+                                    uintptr_t value)
+{
+#if SIZEOF_VOID_P == 8
+    Py_BUILD_ASSERT(sizeof(__int64) == sizeof(*var));
+    return (_InterlockedCompareExchange64((volatile __int64 *)var,
+                                          (__int64)value, (__int64)expected)
+            == (__int64)expected);
+#else
+    Py_BUILD_ASSERT(sizeof(long) == sizeof(*var));
+    return (_InterlockedCompareExchange((volatile long *)var,
+                                        (long)value, (long)expected)
+            == (long)expected);
+#endif
+}
+
+#define _Py_HAVE_ATOMIC_RMW
+
 #else
 // Fallback implementation using volatile
 
@@ -86,6 +162,12 @@ static inline void _Py_atomic_size_set(Py_ssize_t *var, Py_ssize_t value)
     volatile Py_ssize_t *volatile_var = (volatile Py_ssize_t *)var;
     *volatile_var = value;
 }
+
+static inline uintptr_t _Py_atomic_uintptr_get(uintptr_t *var)
+{
+    volatile uintptr_t *volatile_var = (volatile uintptr_t *)var;
+    return *volatile_var;
+}
 #endif
 
 #ifdef __cplusplus
@@ -30,6 +30,17 @@ PyAPI_FUNC(PyObject *) _PyObject_Call(
     PyObject *args,
     PyObject *kwargs);
 
+extern PyObject *const *_PyStack_UnpackDict(
+    PyThreadState *tstate,
+    PyObject *const *args,
+    Py_ssize_t nargs,
+    PyObject *kwargs,
+    PyObject **p_kwnames);
+
+extern void _PyStack_UnpackDict_FreeNoDecRef(
+    PyObject *const *stack,
+    PyObject *kwnames);
+
 
 // Static inline variant of public PyVectorcall_Function().
 static inline vectorcallfunc
@@ -66,6 +66,10 @@ extern void _PyEval_FiniGIL(PyInterpreterState *interp);
 
 extern void _PyEval_ReleaseLock(PyThreadState *tstate);
 
+extern void _PyEval_SetGILPolicy(int policy);
+extern int _PyEval_GetGILPolicy(void);
+extern void _PyEval_GetGILWaitHistogram(uint64_t *buckets);
+
 extern void _PyEval_DeactivateOpCache(void);
 
 
@@ -268,13 +268,19 @@ cache_backoff(_PyAdaptiveEntry *entry) {
 int _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache);
 int _Py_Specialize_StoreAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache);
 int _Py_Specialize_LoadGlobal(PyObject *globals, PyObject *builtins, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache);
+int _Py_Specialize_StoreGlobal(PyObject *globals, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache);
 int _Py_Specialize_LoadMethod(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache);
 int _Py_Specialize_BinarySubscr(PyObject *sub, PyObject *container, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache);
 int _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *instr);
 int _Py_Specialize_CallFunction(PyObject *callable, _Py_CODEUNIT *instr, int nargs, SpecializedCacheEntry *cache, PyObject *builtins);
+int _Py_Specialize_CallMethod(PyObject *callable, _Py_CODEUNIT *instr, int nargs, int is_method, SpecializedCacheEntry *cache);
+int _Py_Specialize_CallMethodKw(PyObject *callable, _Py_CODEUNIT *instr, int nargs, SpecializedCacheEntry *cache);
 void _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
                              SpecializedCacheEntry *cache);
 void _Py_Specialize_CompareOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache);
+void _Py_Specialize_ForIter(PyObject *iter, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache);
+void _Py_Specialize_UnpackSequence(PyObject *seq, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache);
+void _Py_Specialize_ContainsOp(PyObject *container, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache);
 
 #define PRINT_SPECIALIZATION_STATS 0
 #define PRINT_SPECIALIZATION_STATS_DETAILED 0
@@ -317,6 +323,16 @@ PyAPI_FUNC(PyObject*) _Py_GetSpecializationStats(void);
 #define STAT_DEC(opname, name) ((void)0)
 #endif
 
+/* Runtime opcode profile, see Python/specialize.c */
+void _PyOpcodeProfile_RecordMiss(PyCodeObject *co, _Py_CODEUNIT *instr);
+void _PyOpcodeProfile_RecordFailure(_Py_CODEUNIT *instr, int kind);
+void _PyOpcodeProfile_Clear(PyInterpreterState *interp);
+
+PyAPI_FUNC(void) _PyOpcodeProfile_SetEnabled(int enabled);
+PyAPI_FUNC(int) _PyOpcodeProfile_IsEnabled(void);
+PyAPI_FUNC(PyObject *) _PyOpcodeProfile_Get(void);
+PyAPI_FUNC(void) _PyOpcodeProfile_Reset(void);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,110 @@
+#ifndef Py_INTERNAL_FREELIST_H
+#define Py_INTERNAL_FREELIST_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* Capacity and counters of the free list of a builtin type.
+
+   The capacity is set at startup from PyConfig (see pycore_init_freelists()
+   in Python/pylifecycle.c).  If adaptive free lists are enabled, the capacity
+   doubles, up to _PyFreeList_ADAPTIVE_FACTOR times its initial value, when
+   both the allocations missing the free list and the deallocations finding
+   it full reach the capacity: the program allocates and frees objects in
+   bursts larger than the free list.  The capacity halves back toward its
+   initial value each time the free list is cleared (by a full collection)
+   if no deallocation found it full since the previous clear. */
+
+#define _PyFreeList_ADAPTIVE_FACTOR 16
+
+struct _Py_freelist_state {
+    /* Current and initial number of objects kept on the free list */
+    int capacity;
+    int initial_capacity;
+    int max_capacity;
+    /* Allocations served from the free list */
+    size_t hits;
+    /* Allocations which found the free list empty */
+    size_t misses;
+    /* Deallocations which found the free list full */
+    size_t overflows;
+    /* Misses and overflows since the capacity last changed */
+    size_t recent_misses;
+    size_t recent_overflows;
+};
+
+static inline void
+_PyFreeList_Init(struct _Py_freelist_state *fl, int capacity, int adaptive)
+{
+    assert(capacity >= 0);
+    fl->capacity = capacity;
+    fl->initial_capacity = capacity;
+    if (adaptive && capacity <= INT_MAX / _PyFreeList_ADAPTIVE_FACTOR) {
+        fl->max_capacity = capacity * _PyFreeList_ADAPTIVE_FACTOR;
+    }
+    else {
+        fl->max_capacity = capacity;
+    }
+    fl->recent_misses = 0;
+    fl->recent_overflows = 0;
+}
+
+static inline void
+_PyFreeList_Hit(struct _Py_freelist_state *fl)
+{
+    fl->hits++;
+}
+
+static inline void
+_PyFreeList_Miss(struct _Py_freelist_state *fl)
+{
+    fl->misses++;
+    fl->recent_misses++;
+}
+
+/* Record a deallocation which found the free list full.  Return 1 if the
+   capacity grew, so the object can be put on the free list, 0 otherwise. */
+static inline int
+_PyFreeList_Overflow(struct _Py_freelist_state *fl)
+{
+    fl->overflows++;
+    fl->recent_overflows++;
+    if (fl->capacity < fl->max_capacity
+        && fl->recent_overflows >= (size_t)fl->capacity
+        && fl->recent_misses >= (size_t)fl->capacity)
+    {
+        if (fl->capacity > fl->max_capacity / 2) {
+            fl->capacity = fl->max_capacity;
+        }
+        else {
+            fl->capacity *= 2;
+        }
+        fl->recent_misses = 0;
+        fl->recent_overflows = 0;
+        return 1;
+    }
+    return 0;
+}
+
+/* Called when the free list is cleared. */
+static inline void
+_PyFreeList_Decay(struct _Py_freelist_state *fl)
+{
+    if (fl->recent_overflows == 0 && fl->capacity > fl->initial_capacity) {
+        fl->capacity = Py_MAX(fl->capacity / 2, fl->initial_capacity);
+    }
+    fl->recent_misses = 0;
+    fl->recent_overflows = 0;
+}
+
+extern void _PyFreeList_DebugStats(FILE *out, const char *name,
+                                   const struct _Py_freelist_state *fl);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERNAL_FREELIST_H */
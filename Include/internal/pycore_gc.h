@@ -117,6 +117,112 @@ struct gc_generation {
                   generations */
 };
 
+/* Incremental collection of the oldest generation: see
+   gc_collect_increment() in Modules/gcmodule.c */
+struct gc_incremental_state {
+    /* Target duration of an increment in seconds, 0 if the oldest
+       generation is collected in one pass */
+    double pause_target;
+    /* Estimated number of objects examined per second */
+    double scan_rate;
+    /* Number of objects of the oldest generation which the current pass
+       of increments has not examined yet */
+    Py_ssize_t pass_remaining;
+    /* Number of objects of the oldest generation which survived the
+       increments of the current pass */
+    Py_ssize_t pass_survivors;
+    /* Total number of increments and of completed passes */
+    Py_ssize_t increments;
+    Py_ssize_t passes;
+};
+
+/* Parallel examination of the collected objects: see
+   deduce_unreachable_parallel() in Modules/gcmodule.c */
+struct gc_parallel_state {
+    /* Number of threads examining the objects of a collection, 1 if
+       collections are serial */
+    int threads;
+    /* Number of collections which used several threads */
+    Py_ssize_t collections;
+    /* Total wall time of the parallel phases of these collections, and
+       total time spent by all the threads in them */
+    _PyTime_t wall_time;
+    _PyTime_t work_time;
+    /* The threads-1 worker threads, started by gc.set_parallel() and
+       parked between the parallel phases: see Modules/gcmodule.c */
+    struct gc_parallel_pool *pool;
+};
+
+/* Policies choosing the collection thresholds: see gc_adapt_thresholds()
+   in Modules/gcmodule.c */
+#define _PyGC_POLICY_FIXED 0
+#define _PyGC_POLICY_ADAPTIVE 1
+
+struct gc_policy_state {
+    int policy;
+    /* Thresholds set by gc.set_threshold(): the adaptive policy moves the
+       thresholds of the young generations between these and a multiple of
+       them */
+    int base_threshold[NUM_GENERATIONS];
+    /* Fraction of long_lived_total which long_lived_pending must reach to
+       trigger a full collection */
+    double full_ratio;
+    /* Decaying average of the fraction of the objects examined by the
+       collections of each generation which survived them, -1.0 before the
+       first collection */
+    double survival[NUM_GENERATIONS];
+    /* Number of times the adaptive policy raised and lowered a threshold */
+    Py_ssize_t raised;
+    Py_ssize_t lowered;
+};
+
+/* Phases of a collection timed in gc events */
+enum _PyGC_Phase {
+    _PyGC_PHASE_UPDATE_REFS,
+    _PyGC_PHASE_SUBTRACT_REFS,
+    _PyGC_PHASE_MOVE_UNREACHABLE,
+    _PyGC_PHASE_WEAKREFS,
+    _PyGC_PHASE_FINALIZERS,
+    _PyGC_PHASE_DELETE_GARBAGE,
+    _PyGC_NPHASES
+};
+
+/* Number of types in the survivor histogram of a gc event */
+#define _PyGC_EVENT_TYPES 8
+/* Longest type name kept in a gc event, including the NUL */
+#define _PyGC_EVENT_TYPE_NAME 48
+
+/* Record of a collection: see gc.get_events() */
+struct gc_event {
+    /* Sequence number of the event, starting at 0 */
+    Py_ssize_t id;
+    int generation;
+    int incremental;
+    /* Performance counter at the start of the collection, and duration */
+    _PyTime_t start;
+    _PyTime_t duration;
+    _PyTime_t phases[_PyGC_NPHASES];
+    Py_ssize_t examined;
+    Py_ssize_t collected;
+    Py_ssize_t uncollectable;
+    Py_ssize_t survivors;
+    /* Types with the most survivors, in decreasing order */
+    int ntypes;
+    struct {
+        char name[_PyGC_EVENT_TYPE_NAME];
+        Py_ssize_t count;
+    } types[_PyGC_EVENT_TYPES];
+};
+
+/* Ring buffer of the last events */
+struct gc_event_buffer {
+    /* NULL if events are not recorded */
+    struct gc_event *events;
+    Py_ssize_t size;
+    /* Number of events recorded since the buffer was set */
+    Py_ssize_t count;
+};
+
 /* Running stats per generation */
 struct gc_generation_stats {
     /* total number of collections */
@@ -159,12 +265,22 @@ struct _gc_runtime_state {
        collections, and are awaiting to undergo a full collection for
        the first time. */
     Py_ssize_t long_lived_pending;
+    struct gc_incremental_state incremental;
+    struct gc_parallel_state parallel;
+    struct gc_event_buffer event_buffer;
+    struct gc_policy_state policy;
 };
 
 extern void _PyGC_InitState(struct _gc_runtime_state *);
 
 extern Py_ssize_t _PyGC_CollectNoFail(PyThreadState *tstate);
 
+extern void _PyGC_AfterFork(PyInterpreterState *interp);
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+extern int _PyGC_ShareObject(PyObject *op);
+#endif
+
 
 // Functions to clear types free lists
 extern void _PyTuple_ClearFreeList(PyInterpreterState *interp);
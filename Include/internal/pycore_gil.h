@@ -20,6 +20,21 @@ extern "C" {
 #undef FORCE_SWITCHING
 #define FORCE_SWITCHING
 
+/* GIL scheduling policies, see Python/ceval_gil.h. */
+#define _Py_GIL_POLICY_DEFAULT 0
+#define _Py_GIL_POLICY_PRIORITY 1
+
+/* A thread waiting for the GIL under the priority policy. */
+struct _gil_waiter {
+    struct _gil_waiter *next;
+    int priority;
+    /* Whether the thread is taking the GIL back after a blocking call. */
+    int after_io;
+    /* Set by the thread which handed the GIL over to this one. */
+    int granted;
+    PyCOND_T cond;
+};
+
 struct _gil_runtime_state {
     /* microseconds (the Python API uses seconds, though) */
     unsigned long interval;
@@ -42,6 +57,16 @@ struct _gil_runtime_state {
     PyCOND_T switch_cond;
     PyMUTEX_T switch_mutex;
 #endif
+    /* The scheduling policy, and the rank of the current holder and the
+       threads waiting in order under the priority policy.  Protected by
+       the mutex. */
+    int policy;
+    int holder_priority;
+    int holder_after_io;
+    struct _gil_waiter *waiters;
+    /* How long each acquisition of the GIL waited.  Protected by the
+       mutex. */
+    uint64_t wait_histogram[_Py_GIL_HISTOGRAM_BUCKETS];
 };
 
 #ifdef __cplusplus
@@ -10,6 +10,7 @@ extern "C" {
 
 #include "pycore_atomic.h"        // _Py_atomic_address
 #include "pycore_ast_state.h"     // struct ast_state
+#include "pycore_freelist.h"      // struct _Py_freelist_state
 #include "pycore_gil.h"           // struct _gil_runtime_state
 #include "pycore_gc.h"            // struct _gc_runtime_state
 #include "pycore_warnings.h"      // struct _warnings_runtime_state
@@ -39,6 +40,11 @@ struct _ceval_state {
     /* Request for dropping the GIL */
     _Py_atomic_int gil_drop_request;
     struct _pending_calls pending;
+    /* Runtime opcode profile: non-zero while enabled, the sampled
+       specialization misses and the samples waiting for a reason. */
+    int opcode_profile;
+    PyObject *opcode_profile_misses;
+    PyObject *opcode_profile_pending;
 #ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
     struct _gil_runtime_state gil;
 #endif
@@ -108,6 +114,7 @@ struct _Py_float_state {
        linked via abuse of their ob_type members. */
     int numfree;
     PyFloatObject *free_list;
+    struct _Py_freelist_state freelist;
 #endif
 };
 
@@ -117,7 +124,7 @@ struct _Py_float_state {
 #  define PyTuple_MAXSAVESIZE 20
 #endif
 #ifndef PyTuple_MAXFREELIST
-   // Maximum number of tuples of each size to save
+   // Default number of tuples of each size to save
 #  define PyTuple_MAXFREELIST 2000
 #endif
 
@@ -128,6 +135,8 @@ struct _Py_tuple_state {
        will be allocated. */
     PyTupleObject *free_list[PyTuple_MAXSAVESIZE];
     int numfree[PyTuple_MAXSAVESIZE];
+    /* The capacity is the number of tuples of each size kept */
+    struct _Py_freelist_state freelist;
 #endif
 };
 
@@ -138,8 +147,12 @@ struct _Py_tuple_state {
 
 struct _Py_list_state {
 #if PyList_MAXFREELIST > 0
-    PyListObject *free_list[PyList_MAXFREELIST];
+    /* Array of allocated_free_list items, of which the first numfree are
+       available PyListObjects */
+    PyListObject **free_list;
     int numfree;
+    int allocated_free_list;
+    struct _Py_freelist_state freelist;
 #endif
 };
 
@@ -150,10 +163,14 @@ struct _Py_list_state {
 struct _Py_dict_state {
 #if PyDict_MAXFREELIST > 0
     /* Dictionary reuse scheme to save calls to malloc and free */
-    PyDictObject *free_list[PyDict_MAXFREELIST];
+    PyDictObject **free_list;
     int numfree;
-    PyDictKeysObject *keys_free_list[PyDict_MAXFREELIST];
+    int allocated_free_list;
+    struct _Py_freelist_state freelist;
+    PyDictKeysObject **keys_free_list;
     int keys_numfree;
+    int allocated_keys_free_list;
+    struct _Py_freelist_state keys_freelist;
 #endif
 };
 
@@ -13,6 +13,12 @@ extern "C" {
 
 #define _PyList_ITEMS(op) (_PyList_CAST(op)->ob_item)
 
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t it_index;
+    PyListObject *it_seq; /* Set to NULL when iterator is exhausted */
+} _PyListIterObject;
+
 
 #ifdef __cplusplus
 }
@@ -21,10 +21,20 @@ static inline PyObject* _PyLong_GetZero(void)
 static inline PyObject* _PyLong_GetOne(void)
 { return (PyObject *)&_PyRuntime.small_ints[_PY_NSMALLNEGINTS+1]; }
 
+// Return a borrowed reference to the small int singleton for the value
+// of a byte. The function cannot return NULL.
+static inline PyObject* _PyLong_GetUnsignedChar(unsigned char i)
+{
+    Py_BUILD_ASSERT(_PY_NSMALLPOSINTS > 255);
+    return (PyObject *)&_PyRuntime.small_ints[_PY_NSMALLNEGINTS+i];
+}
+
 PyObject *_PyLong_Add(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Multiply(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Subtract(PyLongObject *left, PyLongObject *right);
 
+int _PyLong_AssignValue(PyObject **target, long value);
+
 /* Used by Python/mystrtoul.c, _PyBytes_FromHex(),
    _PyBytes_DecodeEscape(), etc. */
 PyAPI_DATA(unsigned char) _PyLong_DigitValue[256];
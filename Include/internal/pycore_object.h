@@ -54,6 +54,20 @@ _PyObject_InitVar(PyVarObject *op, PyTypeObject *typeobj, Py_ssize_t size)
     _PyObject_Init((PyObject *)op, typeobj);
 }
 
+/* Make an object immortal: see _Py_IsImmortal().  Its current references
+   are no longer counted by _Py_RefTotal, since they will never be released. */
+static inline void
+_Py_SetImmortal(PyObject *op)
+{
+#ifdef Py_REF_DEBUG
+    _Py_RefTotal -= Py_REFCNT(op);
+#endif
+    Py_SET_REFCNT(op, _Py_IMMORTAL_REFCNT);
+}
+
+/* Make all the interned strings of an interpreter immortal. */
+extern void _PyUnicode_ImmortalizeInterned(PyInterpreterState *interp);
+
 
 /* Tell the GC to track this object.
  *
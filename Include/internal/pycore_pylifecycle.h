@@ -70,10 +70,21 @@ extern PyStatus _PyErr_InitTypes(void);
 extern PyStatus _PyBuiltins_AddExceptions(PyObject * bltinmod);
 extern void _PyFloat_Init(void);
 extern int _PyFloat_InitTypes(void);
+extern void _PyFloat_InitFreeList(PyInterpreterState *interp, int capacity,
+                                  int adaptive);
+extern void _PyTuple_InitFreeList(PyInterpreterState *interp, int capacity,
+                                  int adaptive);
+extern int _PyList_InitFreeList(PyInterpreterState *interp, int capacity,
+                                int adaptive);
+extern int _PyDict_InitFreeList(PyInterpreterState *interp, int capacity,
+                                int adaptive);
 extern PyStatus _Py_HashRandomization_Init(const PyConfig *);
 
 extern PyStatus _PyTypes_Init(void);
 extern PyStatus _PyTypes_InitSlotDefs(void);
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+extern int _PyTypes_Share(void);
+#endif
 extern PyStatus _PyImportZip_Init(PyThreadState *tstate);
 extern PyStatus _PyGC_Init(PyInterpreterState *interp);
 extern PyStatus _PyAtExit_Init(PyInterpreterState *interp);
@@ -99,6 +99,15 @@ PyAPI_DATA(struct _PyTraceMalloc_Config) _Py_tracemalloc_config;
 void *_PyObject_VirtualAlloc(size_t size);
 void _PyObject_VirtualFree(void *, size_t size);
 
+/* Give the blocks of the pymalloc cache of a thread state back to the
+ * shared pools, free the cache and stop caching blocks for the thread state.
+ * Must be called with the GIL held: see PyThreadState_Clear(). */
+void _PyObject_ClearThreadCache(PyThreadState *tstate);
+
+/* Set how the memory of the pymalloc arenas is mapped and given back, from
+ * PyConfig.malloc_arenas_huge_pages and PyConfig.malloc_arenas_retained. */
+void _PyObject_SetArenaOptions(int huge_pages, int max_retained);
+
 
 #ifdef __cplusplus
 }
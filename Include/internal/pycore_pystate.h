@@ -156,6 +156,8 @@ PyAPI_FUNC(PyThreadState *) _PyThreadState_Swap(
 
 PyAPI_FUNC(PyStatus) _PyInterpreterState_Enable(_PyRuntimeState *runtime);
 
+extern PyObject* _PyThread_GetGILStats(void);
+
 #ifdef HAVE_FORK
 extern PyStatus _PyInterpreterState_DeleteExceptMain(_PyRuntimeState *runtime);
 extern PyStatus _PyGILState_Reinit(_PyRuntimeState *runtime);
@@ -107,6 +107,9 @@ typedef struct pyruntimestate {
     } xidregistry;
 
     unsigned long main_thread;
+    /* Incremented in the child process after each fork(), so that objects
+       which remember threads of the parent process can tell. */
+    unsigned long fork_generation;
 
     /* Small integers are preallocated in this array so that they
      * can be shared.
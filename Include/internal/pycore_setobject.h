@@ -0,0 +1,18 @@
+#ifndef Py_INTERNAL_SETOBJECT_H
+#define Py_INTERNAL_SETOBJECT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+// Return 1 if key is in the set or frozenset so, 0 if not, -1 on error.
+// A set key is looked up as a frozenset.  Used by CONTAINS_OP_SET.
+extern int _PySet_Contains(PySetObject *so, PyObject *key);
+
+#ifdef __cplusplus
+}
+#endif
+#endif   /* !Py_INTERNAL_SETOBJECT_H */
@@ -0,0 +1,65 @@
+#ifndef Py_INTERNAL_SLICEOBJECT_H
+#define Py_INTERNAL_SLICEOBJECT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* Helpers for the specialized slicing instructions of the interpreter. */
+
+// Store the value of a slice bound into *res if it is None (use dflt)
+// or an int of at most one digit. Return 0 for any other bound.
+static inline int
+_PySlice_SmallBound(PyObject *bound, Py_ssize_t dflt, Py_ssize_t *res)
+{
+    if (bound == Py_None) {
+        *res = dflt;
+        return 1;
+    }
+    if (!PyLong_CheckExact(bound) || (size_t)(Py_SIZE(bound) + 1) > 2) {
+        return 0;
+    }
+    *res = Py_SIZE(bound) * (Py_ssize_t)((PyLongObject *)bound)->ob_digit[0];
+    return 1;
+}
+
+// Unpack a slice without a step whose bounds are None or small ints, and
+// clip the bounds to length, as sequence slicing does.
+// Return 0 if the slice is not of that form.
+static inline int
+_PySlice_UnpackSmall(PyObject *slice, Py_ssize_t length,
+                     Py_ssize_t *start, Py_ssize_t *stop)
+{
+    PySliceObject *s = (PySliceObject *)slice;
+    Py_ssize_t lo, hi;
+    assert(PySlice_Check(slice));
+    if (s->step != Py_None ||
+        !_PySlice_SmallBound(s->start, 0, &lo) ||
+        !_PySlice_SmallBound(s->stop, length, &hi))
+    {
+        return 0;
+    }
+    if (lo < 0) {
+        lo = lo + length < 0 ? 0 : lo + length;
+    }
+    else if (lo > length) {
+        lo = length;
+    }
+    if (hi < 0) {
+        hi = hi + length < 0 ? 0 : hi + length;
+    }
+    else if (hi > length) {
+        hi = length;
+    }
+    *start = lo;
+    *stop = hi < lo ? lo : hi;
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif   /* !Py_INTERNAL_SLICEOBJECT_H */
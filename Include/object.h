@@ -132,6 +132,19 @@ static inline Py_ssize_t _Py_REFCNT(const PyObject *ob) {
 }
 #define Py_REFCNT(ob) _Py_REFCNT(_PyObject_CAST_CONST(ob))
 
+/* Immortal objects are never deallocated: Py_INCREF() and Py_DECREF() leave
+   their reference count unchanged, so that their memory is not written to
+   when they are used.  gc.freeze(immortal=True) makes objects immortal before
+   a fork() so that the pages they occupy stay shared with the child processes.
+
+   The reference count of an immortal object is large enough never to reach
+   zero, even when code compiled with older headers updates it. */
+#define _Py_IMMORTAL_REFCNT (PY_SSIZE_T_MAX >> 3)
+
+static inline int _Py_IsImmortal(const PyObject *ob) {
+    return ob->ob_refcnt >= _Py_IMMORTAL_REFCNT;
+}
+
 
 // bpo-39573: The Py_SET_TYPE() function must be used to set an object type.
 static inline PyTypeObject* _Py_TYPE(const PyObject *ob) {
@@ -477,6 +490,9 @@ static inline void _Py_INCREF(PyObject *op)
 #else
     // Non-limited C API and limited C API for Python 3.9 and older access
     // directly PyObject.ob_refcnt.
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
 #ifdef Py_REF_DEBUG
     _Py_RefTotal++;
 #endif
@@ -497,6 +513,9 @@ static inline void _Py_DECREF(
 #else
     // Non-limited C API and limited C API for Python 3.9 and older access
     // directly PyObject.ob_refcnt.
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
 #ifdef Py_REF_DEBUG
     _Py_RefTotal--;
 #endif
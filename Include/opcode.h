@@ -125,43 +125,82 @@ extern "C" {
 #define COMPARE_OP_FLOAT_JUMP            22
 #define COMPARE_OP_INT_JUMP              23
 #define COMPARE_OP_STR_JUMP              24
-#define BINARY_SUBSCR_ADAPTIVE           26
-#define BINARY_SUBSCR_GETITEM            27
-#define BINARY_SUBSCR_LIST_INT           28
-#define BINARY_SUBSCR_TUPLE_INT          29
-#define BINARY_SUBSCR_DICT               34
-#define STORE_SUBSCR_ADAPTIVE            36
-#define STORE_SUBSCR_LIST_INT            38
-#define STORE_SUBSCR_DICT                39
-#define CALL_FUNCTION_ADAPTIVE           40
-#define CALL_FUNCTION_BUILTIN_O          41
-#define CALL_FUNCTION_BUILTIN_FAST       42
-#define CALL_FUNCTION_LEN                43
-#define CALL_FUNCTION_ISINSTANCE         44
-#define CALL_FUNCTION_PY_SIMPLE          45
-#define JUMP_ABSOLUTE_QUICK              46
-#define LOAD_ATTR_ADAPTIVE               47
-#define LOAD_ATTR_INSTANCE_VALUE         48
-#define LOAD_ATTR_WITH_HINT              55
-#define LOAD_ATTR_SLOT                   56
-#define LOAD_ATTR_MODULE                 57
-#define LOAD_GLOBAL_ADAPTIVE             58
-#define LOAD_GLOBAL_MODULE               59
-#define LOAD_GLOBAL_BUILTIN              62
-#define LOAD_METHOD_ADAPTIVE             63
-#define LOAD_METHOD_CACHED               64
-#define LOAD_METHOD_CLASS                65
-#define LOAD_METHOD_MODULE               66
-#define LOAD_METHOD_NO_DICT              67
-#define STORE_ATTR_ADAPTIVE              75
-#define STORE_ATTR_INSTANCE_VALUE        76
-#define STORE_ATTR_SLOT                  77
-#define STORE_ATTR_WITH_HINT             78
-#define LOAD_FAST__LOAD_FAST             79
-#define STORE_FAST__LOAD_FAST            80
-#define LOAD_FAST__LOAD_CONST            81
-#define LOAD_CONST__LOAD_FAST            87
-#define STORE_FAST__STORE_FAST           88
+#define CONTAINS_OP_ADAPTIVE             26
+#define CONTAINS_OP_DICT                 27
+#define CONTAINS_OP_SET                  28
+#define CONTAINS_OP_STR                  29
+#define CONTAINS_OP_DICT_JUMP            34
+#define CONTAINS_OP_SET_JUMP             36
+#define CONTAINS_OP_STR_JUMP             38
+#define BINARY_SUBSCR_ADAPTIVE           39
+#define BINARY_SUBSCR_GETITEM            40
+#define BINARY_SUBSCR_LIST_INT           41
+#define BINARY_SUBSCR_TUPLE_INT          42
+#define BINARY_SUBSCR_DICT               43
+#define BINARY_SUBSCR_BYTES_INT          44
+#define BINARY_SUBSCR_BYTEARRAY_INT      45
+#define BINARY_SUBSCR_STR_INT            46
+#define BINARY_SUBSCR_SEQUENCE_INT       47
+#define BINARY_SUBSCR_LIST_SLICE         48
+#define BINARY_SUBSCR_STR_SLICE          55
+#define BINARY_SUBSCR_BYTES_SLICE        56
+#define STORE_SUBSCR_ADAPTIVE            57
+#define STORE_SUBSCR_LIST_INT            58
+#define STORE_SUBSCR_DICT                59
+#define STORE_SUBSCR_BYTEARRAY_INT       62
+#define CALL_FUNCTION_ADAPTIVE           63
+#define CALL_FUNCTION_BUILTIN_O          64
+#define CALL_FUNCTION_BUILTIN_FAST       65
+#define CALL_FUNCTION_LEN                66
+#define CALL_FUNCTION_ISINSTANCE         67
+#define CALL_FUNCTION_PY_SIMPLE          75
+#define JUMP_ABSOLUTE_QUICK              76
+#define LOAD_ATTR_ADAPTIVE               77
+#define LOAD_ATTR_INSTANCE_VALUE         78
+#define LOAD_ATTR_WITH_HINT              79
+#define LOAD_ATTR_SLOT                   80
+#define LOAD_ATTR_MODULE                 81
+#define LOAD_ATTR_PROPERTY               87
+#define LOAD_ATTR_CLASS                  88
+#define LOAD_ATTR_NONDESCRIPTOR         123
+#define LOAD_GLOBAL_ADAPTIVE            127
+#define LOAD_GLOBAL_MODULE              128
+#define LOAD_GLOBAL_BUILTIN             134
+#define STORE_GLOBAL_ADAPTIVE           140
+#define STORE_GLOBAL_MODULE             143
+#define LOAD_METHOD_ADAPTIVE            150
+#define LOAD_METHOD_CACHED              151
+#define LOAD_METHOD_CLASS               153
+#define LOAD_METHOD_MODULE              154
+#define LOAD_METHOD_NO_DICT             158
+#define STORE_ATTR_ADAPTIVE             159
+#define STORE_ATTR_INSTANCE_VALUE       167
+#define STORE_ATTR_SLOT                 168
+#define STORE_ATTR_WITH_HINT            169
+#define FOR_ITER_ADAPTIVE               170
+#define FOR_ITER_LIST                   171
+#define FOR_ITER_TUPLE                  172
+#define FOR_ITER_RANGE                  173
+#define FOR_ITER_GEN                    174
+#define UNPACK_SEQUENCE_ADAPTIVE        175
+#define UNPACK_SEQUENCE_LIST            176
+#define UNPACK_SEQUENCE_TUPLE           177
+#define UNPACK_SEQUENCE_TWO_TUPLE       178
+#define CALL_METHOD_ADAPTIVE            179
+#define CALL_METHOD_PY_SIMPLE           180
+#define CALL_METHOD_DESCRIPTOR_O        181
+#define CALL_METHOD_DESCRIPTOR_NOARGS   182
+#define CALL_METHOD_DESCRIPTOR_FAST     183
+#define CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS 184
+#define CALL_METHOD_KW_ADAPTIVE         185
+#define CALL_METHOD_KW_DESCRIPTOR_FAST_WITH_KEYWORDS 186
+#define LOAD_FAST__LOAD_FAST            187
+#define STORE_FAST__LOAD_FAST           188
+#define LOAD_FAST__LOAD_CONST           189
+#define LOAD_CONST__LOAD_FAST           190
+#define STORE_FAST__STORE_FAST          191
+#define IS_OP__POP_JUMP_IF_FALSE        192
+#define IS_OP__POP_JUMP_IF_TRUE         193
 #define DO_TRACING                      255
 #ifdef NEED_OPCODE_JUMP_TABLES
 static uint32_t _PyOpcode_RelativeJump[8] = {
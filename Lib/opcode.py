@@ -238,14 +238,29 @@ def jabs_op(name, op):
     "COMPARE_OP_FLOAT_JUMP",
     "COMPARE_OP_INT_JUMP",
     "COMPARE_OP_STR_JUMP",
+    "CONTAINS_OP_ADAPTIVE",
+    "CONTAINS_OP_DICT",
+    "CONTAINS_OP_SET",
+    "CONTAINS_OP_STR",
+    "CONTAINS_OP_DICT_JUMP",
+    "CONTAINS_OP_SET_JUMP",
+    "CONTAINS_OP_STR_JUMP",
     "BINARY_SUBSCR_ADAPTIVE",
     "BINARY_SUBSCR_GETITEM",
     "BINARY_SUBSCR_LIST_INT",
     "BINARY_SUBSCR_TUPLE_INT",
     "BINARY_SUBSCR_DICT",
+    "BINARY_SUBSCR_BYTES_INT",
+    "BINARY_SUBSCR_BYTEARRAY_INT",
+    "BINARY_SUBSCR_STR_INT",
+    "BINARY_SUBSCR_SEQUENCE_INT",
+    "BINARY_SUBSCR_LIST_SLICE",
+    "BINARY_SUBSCR_STR_SLICE",
+    "BINARY_SUBSCR_BYTES_SLICE",
     "STORE_SUBSCR_ADAPTIVE",
     "STORE_SUBSCR_LIST_INT",
     "STORE_SUBSCR_DICT",
+    "STORE_SUBSCR_BYTEARRAY_INT",
     "CALL_FUNCTION_ADAPTIVE",
     "CALL_FUNCTION_BUILTIN_O",
     "CALL_FUNCTION_BUILTIN_FAST",
@@ -258,9 +273,14 @@ def jabs_op(name, op):
     "LOAD_ATTR_WITH_HINT",
     "LOAD_ATTR_SLOT",
     "LOAD_ATTR_MODULE",
+    "LOAD_ATTR_PROPERTY",
+    "LOAD_ATTR_CLASS",
+    "LOAD_ATTR_NONDESCRIPTOR",
     "LOAD_GLOBAL_ADAPTIVE",
     "LOAD_GLOBAL_MODULE",
     "LOAD_GLOBAL_BUILTIN",
+    "STORE_GLOBAL_ADAPTIVE",
+    "STORE_GLOBAL_MODULE",
     "LOAD_METHOD_ADAPTIVE",
     "LOAD_METHOD_CACHED",
     "LOAD_METHOD_CLASS",
@@ -270,12 +290,31 @@ def jabs_op(name, op):
     "STORE_ATTR_INSTANCE_VALUE",
     "STORE_ATTR_SLOT",
     "STORE_ATTR_WITH_HINT",
+    "FOR_ITER_ADAPTIVE",
+    "FOR_ITER_LIST",
+    "FOR_ITER_TUPLE",
+    "FOR_ITER_RANGE",
+    "FOR_ITER_GEN",
+    "UNPACK_SEQUENCE_ADAPTIVE",
+    "UNPACK_SEQUENCE_LIST",
+    "UNPACK_SEQUENCE_TUPLE",
+    "UNPACK_SEQUENCE_TWO_TUPLE",
+    "CALL_METHOD_ADAPTIVE",
+    "CALL_METHOD_PY_SIMPLE",
+    "CALL_METHOD_DESCRIPTOR_O",
+    "CALL_METHOD_DESCRIPTOR_NOARGS",
+    "CALL_METHOD_DESCRIPTOR_FAST",
+    "CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS",
+    "CALL_METHOD_KW_ADAPTIVE",
+    "CALL_METHOD_KW_DESCRIPTOR_FAST_WITH_KEYWORDS",
     # Super instructions
     "LOAD_FAST__LOAD_FAST",
     "STORE_FAST__LOAD_FAST",
     "LOAD_FAST__LOAD_CONST",
     "LOAD_CONST__LOAD_FAST",
     "STORE_FAST__STORE_FAST",
+    "IS_OP__POP_JUMP_IF_FALSE",
+    "IS_OP__POP_JUMP_IF_TRUE",
 ]
 _specialization_stats = [
     "specialization_success",
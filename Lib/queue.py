@@ -295,6 +295,30 @@ def get(self, block=True, timeout=None):
             raise Empty
         return self._queue.popleft()
 
+    def put_many(self, items, /):
+        '''Put all the items of an iterable on the queue.
+
+        The items are added together: another thread cannot put items between
+        them.  This method never blocks.
+        '''
+        items = list(items)
+        self._queue.extend(items)
+        if items:
+            self._count.release(len(items))
+
+    def get_many(self, maxcount, block=True, timeout=None):
+        '''Remove and return a list of at most 'maxcount' items from the queue.
+
+        Wait for the first item as get() does, then also remove the items which
+        are immediately available, up to 'maxcount' items in all.
+        '''
+        if maxcount <= 0:
+            raise ValueError("'maxcount' must be positive")
+        items = [self.get(block, timeout)]
+        while len(items) < maxcount and self._count.acquire(False):
+            items.append(self._queue.popleft())
+        return items
+
     def put_nowait(self, item):
         '''Put an item into the queue without blocking.
 
@@ -5,7 +5,7 @@
 
 # aliases:
 from _xxsubinterpreters import (
-    ChannelError, ChannelNotFoundError, ChannelEmptyError,
+    ChannelError, ChannelNotFoundError, ChannelEmptyError, ChannelFullError,
     is_shareable,
 )
 
@@ -15,7 +15,7 @@
     'SendChannel', 'RecvChannel',
     'create_channel', 'list_all_channels', 'is_shareable',
     'ChannelError', 'ChannelNotFoundError',
-    'ChannelEmptyError',
+    'ChannelEmptyError', 'ChannelFullError',
     ]
 
 
@@ -97,12 +97,14 @@ def run(self, src_str, /, *, channels=None):
         _interpreters.run_string(self._id, src_str, channels)
 
 
-def create_channel():
+def create_channel(maxsize=0):
     """Return (recv, send) for a new cross-interpreter channel.
 
     The channel may be used to pass data safely between interpreters.
+    If maxsize is greater than zero, the channel holds at most maxsize
+    objects: sending more blocks until they are received.
     """
-    cid = _interpreters.channel_create()
+    cid = _interpreters.channel_create(maxsize)
     recv, send = RecvChannel(cid), SendChannel(cid)
     return recv, send
 
@@ -146,17 +148,24 @@ def id(self):
 class RecvChannel(_ChannelEnd):
     """The receiving end of a cross-interpreter channel."""
 
-    def recv(self, *, _sentinel=object(), _delay=10 / 1000):  # 10 milliseconds
+    def recv(self, timeout=None):
         """Return the next object from the channel.
 
         This blocks until an object has been sent, if none have been
-        sent already.
+        sent already.  If timeout is not None, this blocks for at most
+        timeout seconds and then fails with ChannelEmptyError.
         """
-        obj = _interpreters.channel_recv(self._id, _sentinel)
-        while obj is _sentinel:
-            time.sleep(_delay)
-            obj = _interpreters.channel_recv(self._id, _sentinel)
-        return obj
+        return _interpreters.channel_recv(self._id, block=True,
+                                          timeout=timeout)
+
+    def recv_many(self, maxcount, timeout=None):
+        """Return a list of the next objects from the channel.
+
+        At most maxcount objects are returned.  Otherwise this is the
+        same as recv().
+        """
+        return _interpreters.channel_recv_many(self._id, maxcount,
+                                               block=True, timeout=timeout)
 
     def recv_nowait(self, default=_NOT_SET):
         """Return the next object from the channel.
@@ -194,4 +203,14 @@ def send_nowait(self, obj):
         # XXX Note that at the moment channel_send() only ever returns
         # None.  This should be fixed when channel_send_wait() is added.
         # See bpo-32604 and gh-19829.
-        return _interpreters.channel_send(self._id, obj)
+        return _interpreters.channel_send(self._id, obj, block=False)
+
+    def send_many(self, objs, timeout=None):
+        """Send all the objects to the channel's receiving end at once.
+
+        If the channel is full, this blocks until there is room for all
+        of them, or for at most timeout seconds and then fails with
+        ChannelFullError.  Unlike send(), this does not wait for the
+        objects to be received.
+        """
+        _interpreters.channel_send_many(self._id, objs, timeout=timeout)
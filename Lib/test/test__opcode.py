@@ -92,5 +92,88 @@ def test_specialization_stats(self):
                 self.assertIsInstance(v, int)
 
 
+class OpcodeProfileTests(unittest.TestCase):
+    def setUp(self):
+        self.addCleanup(_opcode.reset_profile)
+        self.addCleanup(_opcode.disable_profile)
+        _opcode.reset_profile()
+
+    def get_samples(self, code):
+        return {key[1:]: count
+                for key, count in _opcode.get_profile().items()
+                if key[0] is code}
+
+    def test_enable_disable(self):
+        self.assertFalse(_opcode.is_profile_enabled())
+        _opcode.enable_profile()
+        self.assertTrue(_opcode.is_profile_enabled())
+        _opcode.disable_profile()
+        self.assertFalse(_opcode.is_profile_enabled())
+
+    def test_disabled_profile_records_nothing(self):
+        class A:
+            def __init__(self):
+                self.x = 1
+        class B:
+            x = 2
+        def f(o):
+            return o.x
+        for _ in range(100):
+            f(A())
+        for _ in range(100):
+            f(B())
+        self.assertEqual(_opcode.get_profile(), {})
+
+    def check_miss(self, cls, reason):
+        class A:
+            def __init__(self):
+                self.x = 1
+        def f(o):
+            return o.x
+        # A new code object, not specialized by the previous tests
+        f.__code__ = f.__code__.replace()
+        for _ in range(100):
+            f(A())
+        _opcode.enable_profile()
+        # Enough misses for a sample, then for another attempt to
+        # specialize the instruction.
+        for _ in range(200):
+            f(cls())
+        _opcode.disable_profile()
+        samples = self.get_samples(f.__code__)
+        self.assertEqual(len(samples), 1)
+        (offset, specialized, sample_reason), count = samples.popitem()
+        self.assertEqual(f.__code__.co_code[offset], opcode.opmap['LOAD_ATTR'])
+        # The sample is recorded for the specialized opcode that missed.
+        self.assertNotIn(specialized, opcode.opmap.values())
+        self.assertEqual(sample_reason, reason)
+        # Misses are sampled, not counted.
+        self.assertEqual(count, 1)
+
+    def test_sampled_miss(self):
+        class B:
+            def __init__(self):
+                self.y = 0
+                self.x = 2
+        # The instruction is specialized again for B.
+        self.check_miss(B, None)
+
+    def test_sampled_miss_reason(self):
+        class B:
+            def __getattribute__(self, name):
+                return 2
+        # The instruction can't be specialized for B, whose attribute
+        # lookup is overridden.
+        self.check_miss(B, 2)  # SPEC_FAIL_OVERRIDDEN
+
+    def test_reset(self):
+        class B:
+            x = 2
+        self.check_miss(B, None)
+        self.assertNotEqual(_opcode.get_profile(), {})
+        _opcode.reset_profile()
+        self.assertEqual(_opcode.get_profile(), {})
+
+
 if __name__ == "__main__":
     unittest.main()
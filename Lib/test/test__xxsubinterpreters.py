@@ -4,6 +4,7 @@
 import os
 import pickle
 import sys
+import sysconfig
 from textwrap import dedent
 import threading
 import time
@@ -314,6 +315,9 @@ def test_default_shareables(self):
                 'spam',
                 10,
                 -10,
+                # buffers
+                memoryview(b'spam'),
+                pickle.PickleBuffer(bytearray(b'spam')),
                 ]
         for obj in shareables:
             with self.subTest(obj):
@@ -840,6 +844,20 @@ def test_fork(self):
             content = file.read()
             self.assertEqual(content, expected)
 
+    @unittest.skipUnless(
+        sysconfig.get_config_var('EXPERIMENTAL_ISOLATED_SUBINTERPRETERS'),
+        'needs isolated subinterpreters')
+    def test_frozen_code_not_shared(self):
+        # An isolated interpreter runs in parallel with the others: it does
+        # not use the static code objects of the frozen modules, which it
+        # would write to.
+        out = _run_output(self.id, dedent("""
+            import sys, _frozen_importlib
+            code = _frozen_importlib._init_module_attrs.__code__
+            print(sys.getrefcount(code) < 1000)
+            """))
+        self.assertEqual(out.strip(), 'True')
+
     def test_already_running(self):
         with _running(self.id):
             with self.assertRaises(RuntimeError):
@@ -1726,6 +1744,250 @@ def test_channel_list_interpreters_invalid_args(self):
             interpreters.channel_list_interpreters(cid)
 
 
+class BoundedChannelTests(TestBase):
+
+    def test_create_invalid_maxsize(self):
+        with self.assertRaises(ValueError):
+            interpreters.channel_create(-1)
+
+    def test_send_full_nonblocking(self):
+        cid = interpreters.channel_create(2)
+        interpreters.channel_send(cid, 1)
+        interpreters.channel_send(cid, 2)
+        with self.assertRaises(interpreters.ChannelFullError):
+            interpreters.channel_send(cid, 3, block=False)
+        self.assertEqual(interpreters.channel_recv(cid), 1)
+        interpreters.channel_send(cid, 3, block=False)
+
+        self.assertEqual(interpreters.channel_recv_many(cid, 5), [2, 3])
+
+    def test_send_full_timeout(self):
+        cid = interpreters.channel_create(1)
+        interpreters.channel_send(cid, 1)
+        with self.assertRaises(interpreters.ChannelFullError):
+            interpreters.channel_send(cid, 2, timeout=0.01)
+        with self.assertRaises(ValueError):
+            interpreters.channel_send(cid, 2, timeout=-1)
+
+    def test_send_blocks_until_received(self):
+        cid = interpreters.channel_create(1)
+        interpreters.channel_send(cid, b'spam')
+
+        def f():
+            time.sleep(0.1)
+            interpreters.channel_recv(cid)
+        t = threading.Thread(target=f)
+        t.start()
+        interpreters.channel_send(cid, b'eggs')
+        t.join()
+
+        self.assertEqual(interpreters.channel_recv(cid), b'eggs')
+
+    def test_send_many_all_or_nothing(self):
+        cid = interpreters.channel_create(3)
+        interpreters.channel_send(cid, 1)
+        with self.assertRaises(interpreters.ChannelFullError):
+            interpreters.channel_send_many(cid, [2, 3, 4], block=False)
+        with self.assertRaises(ValueError):
+            interpreters.channel_send_many(cid, [2, 3, 4, 5])
+        with self.assertRaises(ValueError):
+            interpreters.channel_send_many(cid, [2, object()])
+        interpreters.channel_send_many(cid, [2, 3])
+
+        self.assertEqual(interpreters.channel_recv_many(cid, 5), [1, 2, 3])
+
+    def test_unbounded_never_full(self):
+        cid = interpreters.channel_create()
+        interpreters.channel_send_many(cid, range(1000), block=False)
+
+        self.assertEqual(interpreters.channel_recv_many(cid, 2000),
+                         list(range(1000)))
+
+    def test_recv_many(self):
+        cid = interpreters.channel_create()
+        interpreters.channel_send_many(cid, [b'spam', 'eggs', 10, None])
+
+        self.assertEqual(interpreters.channel_recv_many(cid, 3),
+                         [b'spam', 'eggs', 10])
+        self.assertEqual(interpreters.channel_recv_many(cid, 3), [None])
+        with self.assertRaises(interpreters.ChannelEmptyError):
+            interpreters.channel_recv_many(cid, 3)
+        with self.assertRaises(ValueError):
+            interpreters.channel_recv_many(cid, 0)
+
+    def test_recv_timeout(self):
+        cid = interpreters.channel_create()
+        with self.assertRaises(interpreters.ChannelEmptyError):
+            interpreters.channel_recv(cid, block=True, timeout=0.01)
+        obj = interpreters.channel_recv(cid, None, block=True, timeout=0.01)
+        self.assertIsNone(obj)
+        with self.assertRaises(interpreters.ChannelEmptyError):
+            interpreters.channel_recv_many(cid, 2, block=True, timeout=0.01)
+
+    def test_recv_blocks_until_sent(self):
+        cid = interpreters.channel_create(10)
+        count = 1000
+
+        def f():
+            for i in range(0, count, 10):
+                interpreters.channel_send_many(cid, range(i, i + 10))
+        t = threading.Thread(target=f)
+        t.start()
+        received = []
+        while len(received) < count:
+            received += interpreters.channel_recv_many(cid, 7, block=True)
+        t.join()
+
+        self.assertEqual(received, list(range(count)))
+
+    def test_blocked_recv_closed(self):
+        cid = interpreters.channel_create()
+        errors = []
+
+        def f():
+            try:
+                interpreters.channel_recv(cid, block=True)
+            except interpreters.ChannelClosedError as exc:
+                errors.append(exc)
+        threads = [threading.Thread(target=f) for _ in range(3)]
+        for t in threads:
+            t.start()
+        time.sleep(0.1)
+        interpreters.channel_close(cid)
+        for t in threads:
+            t.join()
+
+        self.assertEqual(len(errors), 3)
+
+    def test_blocked_send_destroyed(self):
+        cid = interpreters.channel_create(1)
+        interpreters.channel_send(cid, 1)
+        errors = []
+
+        def f():
+            try:
+                interpreters.channel_send(cid, 2)
+            except interpreters.ChannelClosedError as exc:
+                errors.append(exc)
+        t = threading.Thread(target=f)
+        t.start()
+        time.sleep(0.1)
+        interpreters.channel_destroy(cid)
+        t.join()
+
+        self.assertEqual(len(errors), 1)
+
+    def test_recv_blocking_other_interpreter(self):
+        cid = interpreters.channel_create(2)
+        interp = interpreters.create()
+        t = threading.Thread(target=interpreters.run_string, args=(interp,
+            dedent(f"""
+            import _xxsubinterpreters as _interpreters
+            for i in range(100):
+                _interpreters.channel_send({cid}, i)
+            """)))
+        t.start()
+        received = [interpreters.channel_recv(cid, block=True)
+                    for _ in range(100)]
+        t.join()
+
+        self.assertEqual(received, list(range(100)))
+
+
+class ChannelBufferTests(TestBase):
+
+    def test_memoryview_shares_memory(self):
+        cid = interpreters.channel_create()
+        data = bytearray(b'spam')
+        interpreters.channel_send(cid, memoryview(data))
+        view = interpreters.channel_recv(cid)
+
+        self.assertIsInstance(view, memoryview)
+        self.assertFalse(view.readonly)
+        view[0] = ord('S')
+        self.assertEqual(data, b'Spam')
+        # The buffer stays exported until the view is released.
+        with self.assertRaises(BufferError):
+            data.append(0)
+        view.release()
+        data.append(0)
+
+    def test_readonly(self):
+        cid = interpreters.channel_create()
+        interpreters.channel_send(cid, memoryview(b'spam'))
+        view = interpreters.channel_recv(cid)
+
+        self.assertTrue(view.readonly)
+        self.assertEqual(view, b'spam')
+        with self.assertRaises(TypeError):
+            view[0] = 0
+
+    def test_format_and_shape(self):
+        cid = interpreters.channel_create()
+        orig = memoryview(bytes(range(24))).cast('i', (2, 3))
+        interpreters.channel_send(cid, orig)
+        view = interpreters.channel_recv(cid)
+
+        self.assertEqual(view.format, 'i')
+        self.assertEqual(view.shape, (2, 3))
+        self.assertEqual(view.tolist(), orig.tolist())
+        self.assertEqual(bytes(view), bytes(orig))
+
+    def test_non_contiguous(self):
+        cid = interpreters.channel_create()
+        orig = memoryview(bytearray(range(10)))[::2]
+        interpreters.channel_send(cid, orig)
+        view = interpreters.channel_recv(cid)
+
+        self.assertEqual(view.tolist(), [0, 2, 4, 6, 8])
+        self.assertFalse(view.c_contiguous)
+
+    def test_pickle_buffer(self):
+        cid = interpreters.channel_create()
+        interpreters.channel_send(cid, pickle.PickleBuffer(b'spam'))
+        view = interpreters.channel_recv(cid)
+
+        self.assertIsInstance(view, memoryview)
+        self.assertEqual(view, b'spam')
+
+    def test_other_interpreter(self):
+        cid = interpreters.channel_create()
+        interp = interpreters.create()
+        interpreters.run_string(interp, dedent(f"""
+            import _xxsubinterpreters as _interpreters
+            data = bytearray(b'spam' * 1000)
+            _interpreters.channel_send({cid}, memoryview(data))
+            """))
+        view = interpreters.channel_recv(cid)
+        view[:4] = b'eggs'
+        out = _run_output(interp, dedent("""
+            print(bytes(data[:8]))
+            """))
+        self.assertEqual(out.strip(), "b'eggsspam'")
+        view.release()
+        out = _run_output(interp, dedent("""
+            data.append(0)
+            print(len(data))
+            """))
+        self.assertEqual(out.strip(), '4001')
+
+    def test_sender_destroyed(self):
+        # The buffer is leaked rather than freed: run in a subprocess.
+        script_helper.assert_python_ok('-c', dedent("""
+            import _xxsubinterpreters as _interpreters
+            cid = _interpreters.channel_create()
+            interp = _interpreters.create()
+            _interpreters.run_string(interp, f'''if 1:
+                import _xxsubinterpreters as _interpreters
+                _interpreters.channel_send({cid}, memoryview(b'spam'))
+                ''')
+            view = _interpreters.channel_recv(cid)
+            _interpreters.destroy(interp)
+            assert view == b'spam', view
+            view.release()
+            """))
+
+
 class ChannelReleaseTests(TestBase):
 
     # XXX Add more test coverage a la the tests for close().
@@ -64,6 +64,41 @@ def test_empty(self):
         a += a
         self.assertEqual(len(a), 0)
 
+    def test_getitem_specialization_by_name(self):
+        # Only array.array itself gets the specialized subscript, not
+        # another type with the same name.
+        Impostor = type("array.array", (), {
+            "__getitem__": lambda self, index: index * 2,
+        })
+        def get(a, index):
+            return a[index]
+        for _ in range(100):
+            self.assertEqual(get(Impostor(), 3), 6)
+        with self.assertRaises(TypeError):
+            for _ in range(100):
+                get(type("array.array", (), {})(), 0)
+
+    def test_getitem_specialization_module_instances(self):
+        # The specialized subscript keys on the sequence slots of the type,
+        # so arrays of several instances of the module and subclasses which
+        # override __getitem__ are indexed correctly.
+        fresh = import_helper.import_fresh_module('array')
+        arrays = [array.array('i', [1, 2, 3]), fresh.array('i', [1, 2, 3])]
+        def get(a, index):
+            return a[index]
+        for _ in range(100):
+            for a in arrays:
+                self.assertEqual(get(a, 2), 3)
+        del fresh
+        support.gc_collect()
+        self.assertEqual(get(arrays[1], 1), 2)
+        with self.assertRaises(IndexError):
+            get(arrays[1], 3)
+        class Sub(array.array):
+            def __getitem__(self, index):
+                return -index
+        self.assertEqual(get(Sub('i', [1, 2, 3]), 2), -2)
+
 
 # Machine format codes.
 #
@@ -679,6 +714,18 @@ def test_getitem(self):
         self.assertRaises(IndexError, a.__getitem__, len(self.example))
         self.assertRaises(IndexError, a.__getitem__, -len(self.example)-1)
 
+    def test_getitem_after_specialization(self):
+        def get(a, index):
+            return a[index]
+        a = array.array(self.typecode, self.example)
+        for _ in range(100):
+            self.assertEntryEqual(get(a, 1), self.example[1])
+        self.assertEntryEqual(get(a, -1), self.example[-1])
+        self.assertRaises(IndexError, get, a, len(self.example))
+        self.assertEqual(get(ArraySubclass(self.typecode, self.example), 0),
+                         self.example[0])
+        self.assertEqual(get(self.example, 0), self.example[0])
+
     def test_setitem(self):
         a = array.array(self.typecode, self.example)
         a[0] = a[-1]
@@ -285,6 +285,30 @@ def by(s):
         self.assertEqual(b[-5:100], by("world"))
         self.assertEqual(b[-100:5], by("Hello"))
 
+    def test_subscript_after_specialization(self):
+        # Repeated subscripts are specialized by the interpreter; the
+        # results must not change when the specialized forms miss.
+        def get(seq, index):
+            return seq[index]
+        def get_slice(seq, start, stop):
+            return seq[start:stop]
+        b = self.type2test(b"spam")
+        for _ in range(100):
+            self.assertEqual(get(b, 1), ord("p"))
+            self.assertEqual(get_slice(b, 1, 3), self.type2test(b"pa"))
+        self.assertEqual(get(b, -1), ord("m"))
+        self.assertEqual(get(b, Indexable(2)), ord("a"))
+        self.assertEqual(get(self.type2test(b"\xff"), 0), 255)
+        self.assertRaises(IndexError, get, b, 4)
+        self.assertRaises(IndexError, get, b, 2**40)
+        self.assertEqual(get_slice(b, -3, None), self.type2test(b"pam"))
+        self.assertEqual(get_slice(b, None, -10), self.type2test(b""))
+        self.assertEqual(get_slice(b, 3, 1), self.type2test(b""))
+        self.assertEqual(get_slice(b, -100, 100), b)
+        self.assertEqual(get_slice(b, 0, 2**40), b)
+        self.assertEqual(get_slice(self.type2test(b"eggs"), 1, 3),
+                         self.type2test(b"gg"))
+
     def test_extended_getslice(self):
         # Test extended slicing by comparing with list slicing.
         L = list(range(255))
@@ -1298,6 +1322,23 @@ def by(s):
         b = by("Hello, world")
         self.assertEqual(re.findall(br"\w+", b), [by("Hello"), by("world")])
 
+    def test_setitem_after_specialization(self):
+        def store(b, index, value):
+            b[index] = value
+        b = bytearray(4)
+        for _ in range(100):
+            for i in range(4):
+                store(b, i, i * 80)
+        self.assertEqual(b, bytearray([0, 80, 160, 240]))
+        store(b, -1, 1)
+        store(b, 0, Indexable(2))
+        self.assertEqual(b, bytearray([2, 80, 160, 1]))
+        self.assertRaises(ValueError, store, b, 0, 256)
+        self.assertRaises(ValueError, store, b, 0, -1)
+        self.assertRaises(TypeError, store, b, 0, None)
+        self.assertRaises(IndexError, store, b, 4, 0)
+        self.assertEqual(b, bytearray([2, 80, 160, 1]))
+
     def test_setitem(self):
         b = bytearray([1, 2, 3])
         b[1] = 100
@@ -9,6 +9,7 @@
 import itertools
 import gc
 import contextlib
+import sys
 
 
 class FunctionCalls(unittest.TestCase):
@@ -26,6 +27,39 @@ def fn(**kw):
         self.assertIsInstance(res, dict)
         self.assertEqual(list(res.items()), expected)
 
+    def test_star_args_errors(self):
+        def fn(a, b=2):
+            return a, b
+
+        self.assertEqual(fn(*(1,), **{'b': 3}), (1, 3))
+        self.assertEqual(fn(*(1,), **{}), (1, 2))
+        with self.assertRaisesRegex(TypeError, "keywords must be strings"):
+            fn(*(1,), **{1: 2})
+        with self.assertRaisesRegex(TypeError, "unexpected keyword argument"):
+            fn(*(1,), **{'c': 3})
+        with self.assertRaisesRegex(TypeError, "multiple values"):
+            fn(*(1,), **{'a': 3})
+
+    @cpython_only
+    def test_star_args_deep_recursion(self):
+        # Python-to-Python calls through CALL_FUNCTION_EX do not
+        # consume the C stack, so only the recursion limit applies.
+        def fn(n, **kwargs):
+            if n == 0:
+                return 0
+            return fn(*(n - 1,), **kwargs) + 1
+
+        depth = 10_000
+        old_limit = sys.getrecursionlimit()
+        sys.setrecursionlimit(depth + 100)
+        try:
+            self.assertEqual(fn(depth), depth)
+            self.assertEqual(fn(depth, key=1), depth)
+        finally:
+            sys.setrecursionlimit(old_limit)
+        with self.assertRaises(RecursionError):
+            fn(old_limit + 100)
+
 
 @cpython_only
 class CFunctionCallsErrorMessages(unittest.TestCase):
@@ -713,5 +747,57 @@ def test_multiple_values(self):
             A().method_two_args("x", "y", x="oops")
 
 
+class TestSpecializedMethodCalls(unittest.TestCase):
+    # Run each call site often enough for it to be specialized,
+    # then change what the site sees.
+
+    def test_method_descriptor_self_type(self):
+        def append(seq, x):
+            return list.append(seq, x)
+        class L(list):
+            pass
+        for i in range(100):
+            items = L() if i % 2 else []
+            append(items, i)
+            self.assertEqual(items, [i])
+        with self.assertRaises(TypeError):
+            append((), 1)
+
+    def test_method_descriptor_argument_count(self):
+        def pop(seq, *args):
+            return seq.pop(*args)
+        for i in range(100):
+            self.assertEqual(pop([1, 2]), 2)
+        self.assertEqual(pop([1, 2], 0), 1)
+        with self.assertRaises(TypeError):
+            pop([1, 2], 0, 1)
+
+    def test_method_descriptor_keywords(self):
+        def split(s, n):
+            return s.split(",", maxsplit=n)
+        class S:
+            def split(self, sep, maxsplit):
+                return maxsplit
+        for i in range(100):
+            self.assertEqual(split("a,b,c", 1), ["a", "b,c"])
+        self.assertEqual(split(S(), 1), 1)
+        with self.assertRaises(TypeError):
+            split("a,b,c", "1")
+
+    def test_python_method_changes(self):
+        class C:
+            def f(self, a, b=2):
+                return a + b
+        def call(obj):
+            return obj.f(1)
+        c = C()
+        for i in range(100):
+            self.assertEqual(call(c), 3)
+        C.f = lambda self, a: a
+        self.assertEqual(call(c), 1)
+        c.f = lambda a: -a
+        self.assertEqual(call(c), -1)
+
+
 if __name__ == "__main__":
     unittest.main()
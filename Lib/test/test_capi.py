@@ -829,6 +829,24 @@ def callback():
         t.start()
         t.join()
 
+    @threading_helper.reap_threads
+    def test_thread_state_delete(self):
+        # Thread states deleted without the GIL must not touch the memory
+        # allocator, which other threads use.
+        done = threading.Event()
+
+        def allocate():
+            while not done.is_set():
+                objects = [(i, str(i), [i]) for i in range(1000)]
+                del objects
+
+        threads = [threading.Thread(target=allocate) for i in range(3)]
+        with threading_helper.start_threads(threads):
+            try:
+                _testcapi._test_thread_state_delete(500)
+            finally:
+                done.set()
+
 
 class Test_testcapi(unittest.TestCase):
     locals().update((name, getattr(_testcapi, name))
@@ -1,6 +1,7 @@
 "Test the functionality of Python classes implementing operators."
 
 import unittest
+from test.support import cpython_only, import_helper
 
 
 testmeths = [
@@ -666,5 +667,104 @@ def __init__(self, *args, **kwargs):
         with self.assertRaisesRegex(TypeError, error_msg):
             object.__init__(E(), 42)
 
+    def testClassAttributeChangesAfterSpecialization(self):
+        class Meta(type):
+            pass
+        class A(metaclass=Meta):
+            x = 1
+        class B(A):
+            pass
+        def get(cls):
+            return cls.x
+        for i in range(100):
+            self.assertEqual(get(B), 1)
+        A.x = 2
+        self.assertEqual(get(B), 2)
+        Meta.x = property(lambda cls: 3)
+        self.assertEqual(get(B), 3)
+
+    def testNonDescriptorShadowedAfterSpecialization(self):
+        class A:
+            x = 1
+            def __init__(self):
+                self.y = 0
+        class S:
+            __slots__ = ()
+            x = 1
+        def get(obj):
+            return obj.x
+        a, s = A(), S()
+        for i in range(100):
+            self.assertEqual(get(a), 1)
+            self.assertEqual(get(s), 1)
+        a.x = 2
+        self.assertEqual(get(a), 2)
+        self.assertEqual(get(A()), 1)
+        a.__dict__
+        self.assertEqual(get(a), 2)
+        S.x = 3
+        self.assertEqual(get(s), 3)
+
+
+@cpython_only
+class InlineValuesTests(unittest.TestCase):
+
+    def check_inline_values(self, cls, *args):
+        has_inline_values = import_helper.import_module(
+            '_testinternalcapi').has_inline_values
+        obj = cls(*args)
+        obj.a = 1
+        obj.b = 2
+        self.assertTrue(has_inline_values(obj))
+        self.assertEqual(obj.a, 1)
+        del obj.a
+        self.assertFalse(hasattr(obj, 'a'))
+        self.assertTrue(has_inline_values(obj))
+        self.assertEqual(vars(obj), {'b': 2})
+        self.assertFalse(has_inline_values(obj))
+        obj.c = 3
+        self.assertEqual(obj.__dict__, {'b': 2, 'c': 3})
+        return obj
+
+    def test_builtin_subclasses(self):
+        class L(list): pass
+        class D(dict): pass
+        class S(set): pass
+        class F(float): pass
+        class Str(str): pass
+        for cls, args in ((L, [[1, 2]]), (D, [{'x': 1}]), (S, [[1]]),
+                          (F, [1.5]), (Str, ['abc'])):
+            with self.subTest(cls=cls.__name__):
+                obj = self.check_inline_values(cls, *args)
+                self.assertEqual(obj, cls.__mro__[1](*args))
+
+    def test_exception_subclasses(self):
+        class E(Exception): pass
+        class O(OSError): pass
+        for cls in E, O:
+            with self.subTest(cls=cls.__name__):
+                self.check_inline_values(cls, 'msg')
+                exc = cls('msg')
+                exc.x = 1
+                self.assertEqual(exc.__reduce__(), (cls, ('msg',), {'x': 1}))
+
+    def test_exception_subclass_with_slots(self):
+        class E(Exception):
+            __slots__ = ()
+        self.assertEqual(E.__basicsize__, Exception.__basicsize__)
+        exc = E()
+        exc.x = 1
+        self.assertEqual(exc.__dict__, {'x': 1})
+
+    def test_class_assignment(self):
+        class E1(Exception): pass
+        class E2(Exception): pass
+        exc = E1()
+        exc.x = 1
+        exc.__class__ = E2
+        self.assertIs(type(exc), E2)
+        self.assertEqual(exc.x, 1)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -105,5 +105,45 @@ def __iter__(self):
         self.assertFalse(0 in list(bc))
         self.assertRaises(TypeError, lambda: 0 in bc)
 
+    def test_container_changes_after_specialization(self):
+        # Run each test site often enough for it to be specialized,
+        # then pass it a different kind of container.
+        def contains(x, container):
+            return x in container
+        def not_contains_branch(x, container):
+            if x not in container:
+                return 'no'
+            return 'yes'
+        containers = [{1: 2}, {1}, frozenset({1}), "1"]
+        for container in containers:
+            key = "1" if isinstance(container, str) else 1
+            for i in range(100):
+                self.assertIs(contains(key, container), True)
+                self.assertEqual(not_contains_branch(key, container), 'yes')
+                self.assertEqual(not_contains_branch(2, {}), 'no')
+            self.assertIs(contains(1, [1]), True)
+            self.assertEqual(not_contains_branch(1, (1,)), 'yes')
+            self.assertEqual(not_contains_branch(1, myset([])), 'no')
+        # Errors from the specialized forms
+        for i in range(100):
+            contains(1, {})
+            not_contains_branch(1, set())
+        self.assertRaises(TypeError, contains, [], {})
+        self.assertRaises(TypeError, not_contains_branch, [], set())
+        self.assertRaises(TypeError, contains, 1, "1")
+        # Sets are looked up as frozensets
+        self.assertIs(contains({1}, {frozenset({1})}), True)
+        self.assertEqual(not_contains_branch({1}, {frozenset({1})}), 'yes')
+
+    def test_is_jump(self):
+        def check(x):
+            if x is None:
+                return 1
+            if x is not None:
+                return 2
+        for i in range(100):
+            self.assertEqual(check(None), 1)
+            self.assertEqual(check(i), 2)
+
 if __name__ == '__main__':
     unittest.main()
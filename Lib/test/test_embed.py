@@ -391,6 +391,13 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
         'show_ref_count': 0,
         'dump_refs': 0,
         'malloc_stats': 0,
+        'float_freelist_size': -1,
+        'tuple_freelist_size': -1,
+        'list_freelist_size': -1,
+        'dict_freelist_size': -1,
+        'adaptive_freelists': 0,
+        'malloc_arenas_huge_pages': 0,
+        'malloc_arenas_retained': 0,
 
         'filesystem_encoding': GET_DEFAULT_CONFIG,
         'filesystem_errors': GET_DEFAULT_CONFIG,
@@ -775,6 +782,10 @@ def test_init_from_config(self):
             'code_debug_ranges': 0,
             'show_ref_count': 1,
             'malloc_stats': 1,
+            'float_freelist_size': 200,
+            'dict_freelist_size': 0,
+            'adaptive_freelists': 1,
+            'malloc_arenas_retained': 2,
 
             'stdio_encoding': 'iso8859-1',
             'stdio_errors': 'replace',
@@ -834,6 +845,9 @@ def test_init_compat_env(self):
             'import_time': 1,
             'code_debug_ranges': 0,
             'malloc_stats': 1,
+            'list_freelist_size': 50,
+            'adaptive_freelists': 1,
+            'malloc_arenas_retained': 3,
             'inspect': 1,
             'optimization_level': 2,
             'pythonpath_env': '/my/path',
@@ -864,6 +878,9 @@ def test_init_python_env(self):
             'import_time': 1,
             'code_debug_ranges': 0,
             'malloc_stats': 1,
+            'list_freelist_size': 50,
+            'adaptive_freelists': 1,
+            'malloc_arenas_retained': 3,
             'inspect': 1,
             'optimization_level': 2,
             'pythonpath_env': '/my/path',
@@ -1,13 +1,14 @@
 import unittest
 import unittest.mock
 from test.support import (verbose, refcount_test,
-                          cpython_only)
+                          cpython_only, run_in_subinterp)
 from test.support.import_helper import import_module
 from test.support.os_helper import temp_dir, TESTFN, unlink
 from test.support.script_helper import assert_python_ok, make_script
 from test.support import threading_helper
 
 import gc
+import os
 import sys
 import sysconfig
 import textwrap
@@ -787,6 +788,308 @@ def test_freeze(self):
         gc.unfreeze()
         self.assertEqual(gc.get_freeze_count(), 0)
 
+    def test_freeze_immortal(self):
+        # Immortal objects are never freed: use a separate process.
+        code = """if 1:
+            import gc
+            import sys
+
+            class A:
+                pass
+
+            frozen = [A(), (1.5, 'x' * 100), {'key': 'value'}]
+            gc.collect()
+            gc.freeze(immortal=True)
+            count = gc.get_freeze_count()
+            assert count > 0, count
+
+            # Tracked objects, the objects they reference and interned
+            # strings are immortal.
+            refcnt = sys.getrefcount(frozen)
+            for obj in [frozen, frozen[0], frozen[1], frozen[1][0],
+                        frozen[1][1], frozen[2], frozen[2]['key']]:
+                assert sys.getrefcount(obj) == refcnt, obj
+            copies = [frozen] * 10
+            assert sys.getrefcount(frozen) == refcnt
+            del copies, frozen
+            assert sys.getrefcount(A) == refcnt
+
+            # New objects are mortal, and collected as usual.
+            mortal = A()
+            assert sys.getrefcount(mortal) < refcnt
+            mortal.cycle = mortal
+            del mortal
+            assert gc.collect() > 0
+
+            # Immortal objects stay frozen.
+            gc.unfreeze()
+            assert gc.get_freeze_count() == count
+        """
+        assert_python_ok("-c", code)
+
+    def test_policy(self):
+        self.assertEqual(gc.get_policy(), "fixed")
+        self.addCleanup(gc.set_threshold, *gc.get_threshold())
+        self.addCleanup(gc.set_policy, "fixed")
+        gc.set_policy("adaptive")
+        self.assertEqual(gc.get_policy(), "adaptive")
+        self.assertRaises(ValueError, gc.set_policy, "unknown")
+        self.assertRaises(TypeError, gc.set_policy, 1)
+        self.assertEqual(gc.get_policy(), "adaptive")
+        stats = gc.get_policy_stats()
+        self.assertEqual(set(stats),
+                         {"policy", "thresholds", "base_thresholds",
+                          "survival", "full_ratio", "raised", "lowered",
+                          "long_lived_total", "long_lived_pending"})
+        self.assertEqual(stats["policy"], "adaptive")
+        self.assertEqual(stats["thresholds"], gc.get_threshold())
+        self.assertEqual(len(stats["survival"]), 3)
+        gc.set_threshold(500, 5, 5)
+        self.assertEqual(gc.get_policy_stats()["base_thresholds"], (500, 5, 5))
+
+    def test_adaptive_policy(self):
+        self.addCleanup(gc.set_threshold, *gc.get_threshold())
+        self.addCleanup(gc.set_policy, "fixed")
+        gc.set_policy("adaptive")
+        gc.set_threshold(100, 10, 10)
+        gc.collect()
+        # All the objects survive: the threshold of the young generation
+        # is raised up to 16 times its initial value.
+        keep = []
+        for i in range(10):
+            keep.extend([] for j in range(200))
+            gc.collect(0)
+        stats = gc.get_policy_stats()
+        self.assertGreater(stats["survival"][0], 0.8)
+        self.assertEqual(gc.get_threshold()[0], 1600)
+        self.assertGreaterEqual(stats["raised"], 4)
+        self.assertEqual(stats["base_thresholds"], (100, 10, 10))
+        # Collections find garbage: the threshold is lowered back.
+        for i in range(10):
+            for j in range(200):
+                cycle = []
+                cycle.append(cycle)
+            del cycle
+            gc.collect(0)
+        stats = gc.get_policy_stats()
+        self.assertLess(stats["survival"][0], 0.3)
+        self.assertEqual(gc.get_threshold()[0], 100)
+        self.assertGreaterEqual(stats["lowered"], 4)
+        # The fixed policy restores the thresholds set by set_threshold().
+        keep.extend([] for j in range(2000))
+        gc.collect(0)
+        gc.set_policy("fixed")
+        self.assertEqual(gc.get_threshold(), (100, 10, 10))
+
+    def test_pause_target(self):
+        self.addCleanup(gc.set_pause_target, gc.get_pause_target())
+        self.assertEqual(gc.get_pause_target(), 0.0)
+        gc.set_pause_target(0.005)
+        self.assertEqual(gc.get_pause_target(), 0.005)
+        gc.set_pause_target(0)
+        self.assertEqual(gc.get_pause_target(), 0.0)
+        self.assertRaises(ValueError, gc.set_pause_target, -1.0)
+        self.assertRaises(ValueError, gc.set_pause_target, float('nan'))
+        self.assertRaises(TypeError, gc.set_pause_target, "1")
+        self.assertEqual(gc.get_pause_target(), 0.0)
+
+    def test_parallel(self):
+        self.addCleanup(gc.set_parallel, gc.get_parallel())
+        self.assertEqual(gc.get_parallel(), 1)
+        gc.set_parallel(4)
+        self.assertEqual(gc.get_parallel(), 4)
+        self.assertRaises(ValueError, gc.set_parallel, 0)
+        self.assertRaises(ValueError, gc.set_parallel, 100000)
+        self.assertEqual(gc.get_parallel(), 4)
+        stats = gc.get_parallel_stats()
+        self.assertEqual(set(stats),
+                         {"collections", "wall_time", "work_time",
+                          "time_saved"})
+        self.assertGreaterEqual(stats["time_saved"], 0.0)
+
+    def test_parallel_collection(self):
+        class A:
+            pass
+        class B:
+            def __del__(self):
+                finalized.append(1)
+
+        self.addCleanup(gc.set_parallel, gc.get_parallel())
+        gc.set_parallel(4)
+        finalized = []
+        callbacks = []
+        refs = []
+        for i in range(20000):
+            a = A()
+            b = B()
+            a.b = b
+            b.a = a
+            refs.append(weakref.ref(a, lambda r: callbacks.append(r)))
+        del a, b
+        # Reachable objects: a chain and more objects than a thread can
+        # keep on its stack, referenced by a single list.
+        chain = None
+        for i in range(20000):
+            node = A()
+            node.next = chain
+            chain = node
+        wide = [A() for i in range(20000)]
+        for obj in wide:
+            obj.obj = obj
+
+        old = gc.get_parallel_stats()
+        self.assertEqual(gc.collect(), 2 * 20000)
+        self.assertGreater(gc.get_parallel_stats()["collections"],
+                           old["collections"])
+        self.assertEqual(len(finalized), 20000)
+        self.assertEqual(len(callbacks), 20000)
+        self.assertEqual([ref() for ref in refs], [None] * len(refs))
+        length = 0
+        while chain is not None:
+            length += 1
+            chain = chain.next
+        self.assertEqual(length, 20000)
+        self.assertTrue(all(obj.obj is obj for obj in wide))
+
+    def test_parallel_resize(self):
+        self.addCleanup(gc.set_parallel, gc.get_parallel())
+        objs = [[i] for i in range(50000)]
+        for threads in (2, 8, 8, 3, 1, 4):
+            gc.set_parallel(threads)
+            self.assertEqual(gc.get_parallel(), threads)
+            gc.collect()
+        del objs
+
+    @unittest.skipUnless(hasattr(os, 'fork'), 'requires os.fork')
+    def test_parallel_fork(self):
+        # The child process starts the threads again
+        code = textwrap.dedent("""
+            import gc, os, sys
+            from test import support
+            gc.set_parallel(4)
+            objs = [[i] for i in range(50000)]
+            gc.collect()
+            pid = os.fork()
+            if pid == 0:
+                stats = gc.get_parallel_stats()
+                gc.collect()
+                os._exit(gc.get_parallel_stats()["collections"]
+                         - stats["collections"])
+            support.wait_process(pid, exitcode=1)
+        """)
+        assert_python_ok('-c', code)
+
+    def test_event_buffer(self):
+        self.addCleanup(gc.set_event_buffer, gc.get_event_buffer())
+        self.assertRaises(ValueError, gc.set_event_buffer, -1)
+        gc.set_event_buffer(0)
+        self.assertEqual(gc.get_event_buffer(), 0)
+        gc.collect()
+        self.assertEqual(gc.get_events(), [])
+
+        gc.set_event_buffer(3)
+        self.assertEqual(gc.get_event_buffer(), 3)
+        self.assertEqual(gc.get_events(), [])
+        for generation in range(5):
+            gc.collect(generation % 3)
+        events = gc.get_events()
+        self.assertEqual([event["id"] for event in events], [2, 3, 4])
+        self.assertEqual([event["generation"] for event in events], [2, 0, 1])
+        self.assertEqual([event["id"] for event in gc.get_events(4)], [4])
+        self.assertEqual(gc.get_events(5), [])
+        for event in events:
+            self.assertEqual(set(event),
+                             {"id", "generation", "incremental", "start",
+                              "duration", "examined", "collected",
+                              "uncollectable", "survivors", "phases",
+                              "survivor_types"})
+            self.assertIs(event["incremental"], False)
+            self.assertEqual(set(event["phases"]),
+                             {"update_refs", "subtract_refs",
+                              "move_unreachable", "weakrefs", "finalizers",
+                              "delete_garbage"})
+            self.assertLessEqual(sum(event["phases"].values()),
+                                 event["duration"])
+            self.assertGreaterEqual(event["examined"], event["survivors"])
+
+    def test_event_survivors(self):
+        class GCEventSurvivor:
+            pass
+        class GCEventGarbage:
+            pass
+
+        self.addCleanup(gc.set_event_buffer, gc.get_event_buffer())
+        gc.set_event_buffer(1)
+        gc.collect()
+        survivors = [GCEventSurvivor() for i in range(1000)]
+        for i in range(10):
+            garbage = GCEventGarbage()
+            garbage.cycle = garbage
+        del garbage
+        gc.collect(0)
+        event, = gc.get_events()
+        self.assertEqual(event["generation"], 0)
+        self.assertEqual(event["collected"], 10)
+        self.assertGreaterEqual(event["survivors"], 1000)
+        self.assertEqual(event["survivor_types"][0], ("GCEventSurvivor", 1000))
+        counts = [count for name, count in event["survivor_types"]]
+        self.assertEqual(counts, sorted(counts, reverse=True))
+        self.assertNotIn("GCEventGarbage",
+                         [name for name, count in event["survivor_types"]])
+
+    def test_incremental_collection(self):
+        # Cycles in the oldest generation are collected by the increments
+        # run by automatic collection, without a full collection.
+        class A:
+            pass
+        def make_cycle():
+            a = A()
+            a.a = a
+            return a
+
+        cycles = [make_cycle() for i in range(100)]
+        refs = [weakref.ref(a) for a in cycles]
+        gc.collect()
+        self.assertTrue(gc.is_tracked(cycles[0]))
+        self.assertTrue(any(a is cycles[0] for a in gc.get_objects(2)))
+        del cycles
+
+        self.addCleanup(gc.set_pause_target, gc.get_pause_target())
+        self.addCleanup(gc.set_threshold, *gc.get_threshold())
+        gc.set_pause_target(1.0)
+        gc.set_threshold(1, 1)
+        old = gc.get_stats()
+        gc.enable()
+        try:
+            for i in range(100000):
+                if not any(ref() is not None for ref in refs):
+                    break
+                junk = [[] for j in range(5)]
+        finally:
+            gc.disable()
+        new = gc.get_stats()
+        self.assertEqual([ref() for ref in refs], [None] * len(refs))
+        self.assertEqual(new[1]["collections"], old[1]["collections"])
+        self.assertGreater(new[2]["collections"], old[2]["collections"])
+
+    @cpython_only
+    def test_incremental_collection_subinterpreter(self):
+        # The increments of a subinterpreter only take objects of its own
+        # oldest generation, not the objects of the main interpreter which
+        # it references, such as the dicts of static types.
+        code = """if 1:
+            import gc
+            gc.set_pause_target(0.01)
+            gc.set_threshold(100, 1)
+            proxy = str.__dict__
+            keep = [[] for i in range(300000)]
+            """
+        str_dict = gc.get_referents(str.__dict__)[0]
+        if not gc.is_tracked(str_dict):
+            self.skipTest("the dicts of static types are shared")
+        self.assertEqual(run_in_subinterp(code), 0)
+        self.assertTrue(any(o is str_dict for o in gc.get_objects()))
+
     def test_get_objects(self):
         gc.collect()
         l = []
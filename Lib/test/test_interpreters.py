@@ -743,3 +743,30 @@ def test_recv_nowait_default(self):
         self.assertEqual(obj4, b'spam')
         self.assertEqual(obj5, b'eggs')
         self.assertIs(obj6, default)
+
+    def test_recv_timeout(self):
+        rch, _ = interpreters.create_channel()
+        with self.assertRaises(interpreters.ChannelEmptyError):
+            rch.recv(timeout=0.01)
+
+    def test_send_many_recv_many(self):
+        rch, sch = interpreters.create_channel()
+        sch.send_many([b'spam', b'eggs', b'ham'])
+        objs1 = rch.recv_many(2)
+        objs2 = rch.recv_many(2)
+
+        self.assertEqual(objs1, [b'spam', b'eggs'])
+        self.assertEqual(objs2, [b'ham'])
+
+    def test_bounded_channel_full(self):
+        rch, sch = interpreters.create_channel(maxsize=2)
+        sch.send_many([1, 2])
+        with self.assertRaises(interpreters.ChannelFullError):
+            sch.send_nowait(3)
+        with self.assertRaises(interpreters.ChannelFullError):
+            sch.send_many([3], timeout=0.01)
+        obj = rch.recv()
+        sch.send_nowait(3)
+
+        self.assertEqual(obj, 1)
+        self.assertEqual(rch.recv_many(5), [2, 3])
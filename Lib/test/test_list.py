@@ -7,6 +7,20 @@
 class ListTest(list_tests.CommonTest):
     type2test = list
 
+    def test_slice_after_specialization(self):
+        def get_slice(a, start, stop):
+            return a[start:stop]
+        a = [0, 1, 2, 3]
+        for _ in range(100):
+            self.assertEqual(get_slice(a, 1, 3), [1, 2])
+        self.assertEqual(get_slice(a, -3, None), [1, 2, 3])
+        self.assertEqual(get_slice(a, None, -10), [])
+        self.assertEqual(get_slice(a, 3, 1), [])
+        self.assertEqual(get_slice(a, -100, 100), a)
+        self.assertIsNot(get_slice(a, None, None), a)
+        self.assertEqual(get_slice(a, 0, 2**40), a)
+        self.assertEqual(get_slice((0, 1, 2), 1, 3), (1, 2))
+
     def test_basic(self):
         self.assertEqual(list([]), [])
         l0_3 = [0, 1, 2, 3]
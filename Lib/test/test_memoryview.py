@@ -53,6 +53,18 @@ def test_getitem(self):
         for tp in self._types:
             self.check_getitem_with_type(tp)
 
+    def test_getitem_after_specialization(self):
+        def get(m, index):
+            return m[index]
+        for tp in self._types:
+            m = self._view(tp(self._source))
+            for _ in range(100):
+                self.assertEqual(get(m, 1), ord(b"b"))
+            self.assertEqual(get(m, -1), ord(b"f"))
+            self.assertRaises(IndexError, get, m, 6)
+            m.release()
+            self.assertRaises(ValueError, get, m, 1)
+
     def test_iter(self):
         for tp in self._types:
             b = tp(self._source)
@@ -214,6 +214,43 @@ def test_property_set_name_incorrect_args(self):
             ):
                 p.__set_name__(*([0] * i))
 
+    def test_getter_changes_after_specialization(self):
+        class A:
+            def __init__(self):
+                self._x = 1
+            @property
+            def x(self):
+                return self._x
+        def get(a):
+            return a.x
+        a = A()
+        for i in range(100):
+            self.assertEqual(get(a), 1)
+        A.__dict__['x'].__init__(lambda self: 2)
+        self.assertEqual(get(a), 2)
+        A.x = property(lambda self: 3)
+        self.assertEqual(get(a), 3)
+        A.__dict__['x'].__init__(None)
+        with self.assertRaises(AttributeError):
+            get(a)
+
+    def test_getter_raises_after_specialization(self):
+        class A:
+            @property
+            def x(self):
+                if self.fail:
+                    raise KeyError
+                return 1
+        def get(a):
+            return a.x
+        a = A()
+        a.fail = False
+        for i in range(100):
+            self.assertEqual(get(a), 1)
+        a.fail = True
+        with self.assertRaises(KeyError):
+            get(a)
+
 
 # Issue 5890: subclasses of property do not preserve method __doc__ strings
 class PropertySub(property):
@@ -1,11 +1,14 @@
 # Some simple queue module tests, plus some failure conditions
 # to ensure the Queue locks remain stable.
 import itertools
+import os
 import random
+import sys
 import threading
 import time
 import unittest
 import weakref
+from test import support
 from test.support import gc_collect
 from test.support import import_helper
 from test.support import threading_helper
@@ -464,6 +467,30 @@ def consume_timeout(self, q, results, sentinel):
                 return
             results.append(val)
 
+    def feed_many(self, q, seq, rnd, sentinel):
+        while True:
+            batch = []
+            while len(batch) < 10:
+                try:
+                    batch.append(seq.pop())
+                except IndexError:
+                    q.put_many(batch)
+                    q.put(sentinel)
+                    return
+            q.put_many(batch)
+            if rnd.random() > 0.5:
+                time.sleep(rnd.random() * 1e-3)
+
+    def consume_many(self, q, results, sentinel):
+        while True:
+            batch = q.get_many(10)
+            for i, val in enumerate(batch):
+                if val == sentinel:
+                    # Leave the other items to the other consumers
+                    q.put_many(batch[i+1:])
+                    return
+                results.append(val)
+
     def run_threads(self, n_threads, q, inputs, feed_func, consume_func):
         results = []
         sentinel = None
@@ -579,6 +606,109 @@ def test_many_threads_timeout(self):
 
         self.assertEqual(sorted(results), inputs)
 
+    def test_many_threads_batch(self):
+        # Test multiple concurrent put_many() and get_many()
+        N = 50
+        q = self.q
+        inputs = list(range(10000))
+        results = self.run_threads(N, q, inputs,
+                                   self.feed_many, self.consume_many)
+        self.assertEqual(sorted(results), inputs)
+
+    def test_put_many_get_many(self):
+        q = self.q
+        q.put_many([1, 2, 3])
+        q.put_many(iter([4, 5]))
+        q.put_many(())
+        self.assertEqual(q.qsize(), 5)
+        self.assertEqual(q.get_many(2), [1, 2])
+        self.assertEqual(q.get_many(1), [3])
+        self.assertEqual(q.get_many(10, timeout=0.1), [4, 5])
+        self.assertTrue(q.empty())
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(10, block=False)
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(10, timeout=1e-3)
+        with self.assertRaises(ValueError):
+            q.get_many(0)
+        with self.assertRaises(TypeError):
+            q.put_many(1)
+        self.assertTrue(q.empty())
+
+        # The buffer wraps around, grows and shrinks
+        for i in range(1, 100):
+            q.put_many(range(i))
+            q.put(i)
+            self.assertEqual(q.get_many(i), list(range(i)))
+            self.assertEqual(q.get(), i)
+        self.assertTrue(q.empty())
+
+    def test_get_many_wakeup(self):
+        # get_many() waits for the first item only
+        q = self.q
+        results = []
+        def consumer():
+            results.append(q.get_many(10))
+        with threading_helper.start_threads([threading.Thread(target=consumer)]):
+            time.sleep(0.01)
+            q.put(1)
+        self.assertEqual(results, [[1]])
+
+    def park_consumer(self, q, results):
+        # Start a thread blocked in get() on the empty queue q
+        started = threading.Event()
+        def consumer():
+            started.set()
+            results.append(q.get(timeout=support.SHORT_TIMEOUT))
+        thread = threading.Thread(target=consumer)
+        thread.start()
+        started.wait()
+        time.sleep(0.05)
+        return thread
+
+    def test_put_with_waiter(self):
+        # An item put while another thread waits in get() is in the queue
+        # until that thread runs.
+        q = self.q
+        results = []
+        thread = self.park_consumer(q, results)
+        try:
+            old_interval = sys.getswitchinterval()
+            support.setswitchinterval(support.SHORT_TIMEOUT)
+            try:
+                q.put(1)
+                self.assertEqual(q.qsize(), 1)
+                self.assertEqual(q.get_nowait(), 1)
+            finally:
+                sys.setswitchinterval(old_interval)
+            q.put(2)
+        finally:
+            thread.join()
+        self.assertEqual(results, [2])
+
+    @unittest.skipUnless(hasattr(os, 'fork'), 'needs os.fork()')
+    @threading_helper.reap_threads
+    def test_fork_with_waiter(self):
+        # The threads waiting in get() do not exist in a forked child
+        q = self.q
+        results = []
+        thread = self.park_consumer(q, results)
+        try:
+            pid = os.fork()
+            if pid == 0:
+                code = 1
+                try:
+                    q.put("x")
+                    if q.get(timeout=support.SHORT_TIMEOUT) == "x":
+                        code = 0
+                finally:
+                    os._exit(code)
+            support.wait_process(pid, exitcode=0)
+            q.put("y")
+        finally:
+            thread.join()
+        self.assertEqual(results, ["y"])
+
     def test_references(self):
         # The queue should lose references to each item as soon as
         # it leaves the queue.
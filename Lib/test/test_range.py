@@ -598,6 +598,27 @@ def test_reverse_iteration(self):
                   ]:
             self.assertEqual(list(reversed(r)), list(r)[::-1])
 
+    def test_iteration_reuses_loop_variable_safely(self):
+        # A specialized loop over a range may update the int object held
+        # by the loop variable in place; values stored elsewhere, or
+        # loop variables rebound in the body, must not be affected.
+        def collect(start, stop, step=1):
+            saved = []
+            for i in range(start, stop, step):
+                saved.append(i)
+            return saved
+        def rebind(n):
+            total = 0
+            for i in range(1000, 1000 + n):
+                total += i
+                i = -1
+            return total, i
+        for _ in range(20):
+            self.assertEqual(collect(1000, 1100), list(range(1000, 1100)))
+            self.assertEqual(collect(-5, 300, 7), list(range(-5, 300, 7)))
+            self.assertEqual(collect(300, -300, -9), list(range(300, -300, -9)))
+            self.assertEqual(rebind(10), (sum(range(1000, 1010)), -1))
+
     def test_issue11845(self):
         r = range(*slice(1, 18, 2).indices(20))
         values = {None, 0, 1, -1, 2, -2, 5, -5, 19, -19,
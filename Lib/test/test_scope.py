@@ -716,6 +716,39 @@ def h():
         self.assertEqual(2, global_ns["result2"])
         self.assertEqual(9, global_ns["result9"])
 
+    def testGlobalsChangedInLoop(self):
+        # Loads and stores of globals are specialized per key: adding or
+        # deleting other globals must not affect them, while deleting or
+        # rebinding the global itself must be seen.
+        global_ns = {}
+        exec("""if 1:
+            def f(n):
+                global x
+                for i in range(n):
+                    x = x + 1
+                    globals()[f"y{i}"] = i
+                    if i % 3 == 0:
+                        del globals()[f"y{i}"]
+                return x
+            def g():
+                return x
+            x = 0
+            """, global_ns)
+        f = global_ns["f"]
+        g = global_ns["g"]
+        self.assertEqual(f(100), 100)
+        self.assertEqual(g(), 100)
+        global_ns["x"] = -1
+        self.assertEqual(f(100), 99)
+        for _ in range(100):
+            self.assertEqual(g(), 99)
+        del global_ns["x"]
+        self.assertRaises(NameError, g)
+        self.assertRaises(NameError, f, 1)
+        global_ns["x"] = 5
+        self.assertEqual(g(), 5)
+        self.assertEqual(f(1), 6)
+
     def testNonLocalClass(self):
 
         def f(x):
@@ -4,6 +4,7 @@
 import locale
 import operator
 import os
+import re
 import struct
 import subprocess
 import sys
@@ -206,6 +207,136 @@ def test_switchinterval(self):
         finally:
             sys.setswitchinterval(orig)
 
+    def test_gilpolicy(self):
+        self.assertRaises(TypeError, sys._setgilpolicy)
+        self.assertRaises(TypeError, sys._setgilpolicy, 1)
+        self.assertRaises(ValueError, sys._setgilpolicy, "spam")
+        orig = sys._getgilpolicy()
+        self.assertIn(orig, ("default", "priority"))
+        try:
+            for policy in "priority", "default":
+                sys._setgilpolicy(policy)
+                self.assertEqual(sys._getgilpolicy(), policy)
+        finally:
+            sys._setgilpolicy(orig)
+
+    @threading_helper.reap_threads
+    def test_gilpriority(self):
+        import threading
+        self.assertRaises(TypeError, sys._setgilpriority)
+        self.assertRaises(TypeError, sys._setgilpriority, "a")
+        self.assertEqual(sys._getgilpriority(), 0)
+        priorities = []
+        def f():
+            priorities.append(sys._getgilpriority())
+        try:
+            sys._setgilpriority(5)
+            self.assertEqual(sys._getgilpriority(), 5)
+            sys._setgilpriority(-5)
+            self.assertEqual(sys._getgilpriority(), -5)
+            # The priority is per thread.
+            t = threading.Thread(target=f)
+            t.start()
+            t.join()
+            self.assertEqual(priorities, [0])
+        finally:
+            sys._setgilpriority(0)
+
+    @threading_helper.reap_threads
+    def test_gil_priority_policy(self):
+        import threading
+        import time
+        # Threads mixing CPU-bound work, blocking calls and priorities all
+        # get the GIL in turn.
+        results = []
+        def f(priority):
+            sys._setgilpriority(priority)
+            total = 0
+            for i in range(20):
+                total += sum(range(10000))
+                time.sleep(0.0001)
+            results.append(total)
+        orig = sys._getgilpolicy()
+        sys._setgilpolicy("priority")
+        try:
+            threads = [threading.Thread(target=f, args=(i % 3 - 1,))
+                       for i in range(6)]
+            with threading_helper.start_threads(threads):
+                pass
+        finally:
+            sys._setgilpolicy(orig)
+        self.assertEqual(results, [20 * sum(range(10000))] * 6)
+
+    @threading_helper.reap_threads
+    def test_getgilwaithistogram(self):
+        import threading
+        import time
+        before = sys._getgilwaithistogram()
+        self.assertIsInstance(before, tuple)
+        self.assertEqual(len(before), 24)
+        t = threading.Thread(target=time.sleep, args=(0.001,))
+        t.start()
+        t.join()
+        after = sys._getgilwaithistogram()
+        self.assertGreater(sum(after), sum(before))
+        for count_before, count_after in zip(before, after):
+            self.assertGreaterEqual(count_after, count_before)
+
+    @threading_helper.reap_threads
+    def test_getgilstats(self):
+        import threading
+        import time
+        main_id = threading.get_ident()
+        before = sys._getgilstats()[main_id]
+        self.assertEqual(set(before), {'acquisitions', 'wait_total',
+                                       'wait_max', 'forced_drops',
+                                       'hold_histogram'})
+        self.assertEqual(len(before['hold_histogram']), 24)
+        self.assertGreaterEqual(before['wait_total'], before['wait_max'])
+
+        # A CPU-bound thread is asked to release the GIL while the main
+        # thread sleeps in a loop.
+        stop = threading.Event()
+        thread_stats = []
+        def f():
+            while not stop.is_set():
+                pass
+            thread_stats.append(sys._getgilstats()[threading.get_ident()])
+        t = threading.Thread(target=f)
+        t.start()
+        for i in range(10):
+            time.sleep(0.001)
+        stop.set()
+        t.join()
+
+        after = sys._getgilstats()[main_id]
+        self.assertGreaterEqual(after['acquisitions'],
+                                before['acquisitions'] + 10)
+        self.assertGreater(after['wait_total'], before['wait_total'])
+        self.assertGreater(sum(after['hold_histogram']),
+                           sum(before['hold_histogram']))
+        self.assertGreater(thread_stats[0]['forced_drops'], 0)
+        self.assertNotIn(t.ident, sys._getgilstats())
+
+    @threading_helper.reap_threads
+    def test_getgilstats_subinterpreter(self):
+        import threading
+        # A subinterpreter only reports its own threads, not the threads of
+        # the main interpreter.
+        stop = threading.Event()
+        t = threading.Thread(target=stop.wait)
+        t.start()
+        try:
+            self.assertIn(t.ident, sys._getgilstats())
+            code = textwrap.dedent("""
+                import sys, threading
+                assert list(sys._getgilstats()) == [threading.get_ident()]
+                """)
+            self.assertEqual(support.run_in_subinterp(code), 0)
+        finally:
+            stop.set()
+            t.join()
+
     def test_recursionlimit(self):
         self.assertRaises(TypeError, sys.getrecursionlimit, 42)
         oldlimit = sys.getrecursionlimit()
@@ -841,6 +972,71 @@ def test_debugmallocstats(self):
         # The function has no parameter
         self.assertRaises(TypeError, sys._debugmallocstats, True)
 
+    @unittest.skipUnless(support.with_pymalloc(), 'need pymalloc')
+    def test_debugmallocstats_retained_arenas(self):
+        from test.support.script_helper import (assert_python_ok,
+                                                assert_python_failure)
+        code = textwrap.dedent("""
+            import sys
+            x = [[i] for i in range(200_000)]
+            del x
+            sys._debugmallocstats()
+        """)
+        for arenas in ('retain=4', 'hugepage,retain=4', 'hugetlb,retain=4'):
+            with self.subTest(arenas=arenas):
+                ret, out, err = assert_python_ok(
+                    '-X', f'malloc_arenas={arenas}', '-c', code,
+                    PYTHONMALLOC='')
+                self.assertRegex(err, br'# arenas retained current += +4\n')
+                self.assertRegex(err,
+                                 br'# arenas retained highwater mark += +4\n')
+
+        ret, out, err = assert_python_ok('-c', code,
+                                         PYTHONMALLOCARENAS='retain=4',
+                                         PYTHONMALLOC='')
+        self.assertRegex(err, br'# arenas retained current += +4\n')
+
+        # -E ignores PYTHONMALLOCARENAS
+        ret, out, err = assert_python_ok('-E', '-c', code,
+                                         PYTHONMALLOCARENAS='retain=4',
+                                         PYTHONMALLOC='')
+        self.assertRegex(err, br'# arenas retained current += +0\n')
+
+        ret, out, err = assert_python_failure('-X', 'malloc_arenas=retain',
+                                              '-c', 'pass')
+        self.assertIn(b'invalid arena option', err)
+
+    @unittest.skipIf(sys.platform == "win32"
+                     or not sysconfig.get_config_var("WITH_FREELISTS"),
+                     'need free lists')
+    def test_debugmallocstats_freelists(self):
+        from test.support.script_helper import (assert_python_ok,
+                                                assert_python_failure)
+        code = textwrap.dedent("""
+            import sys
+            for i in range(20):
+                x = [[] for j in range(100)]
+                del x
+            sys._debugmallocstats()
+        """)
+        ret, out, err = assert_python_ok(
+            '-X', 'freelists=float:500,list:0', '-c', code)
+        self.assertRegex(err, br'# float freelist capacity += +500\n')
+        self.assertRegex(err, br'# list freelist capacity += +0\n')
+        self.assertRegex(err, br'# list freelist hits += +0\n')
+        self.assertRegex(err, br'# tuple freelist capacity += +2,000\n')
+
+        # The list free list grows with bursts of 100 lists
+        ret, out, err = assert_python_ok('-c', code,
+                                         PYTHONFREELISTS='list:4,adaptive')
+        capacity = re.search(br'# list freelist capacity += +(\d+)\n', err)
+        self.assertGreater(int(capacity.group(1)), 4)
+        self.assertLessEqual(int(capacity.group(1)), 64)
+
+        ret, out, err = assert_python_failure('-X', 'freelists=list', '-c',
+                                              'pass')
+        self.assertIn(b'invalid free list specification', err)
+
     @unittest.skipUnless(hasattr(sys, "getallocatedblocks"),
                          "sys.getallocatedblocks unavailable on this build")
     def test_getallocatedblocks(self):
@@ -257,6 +257,41 @@ def test_get_traced_memory(self):
         tracemalloc.stop()
         self.assertEqual(tracemalloc.get_traced_memory(), (0, 0))
 
+    def test_sampling(self):
+        tracemalloc.stop()
+        self.assertRaises(ValueError, tracemalloc.start, 1,
+                          sampling_interval=-1)
+        interval = 4096
+        tracemalloc.start(1, sampling_interval=interval)
+        self.assertEqual(tracemalloc.get_sampling_interval(), interval)
+
+        # Small memory blocks: about one block of 200 is traced, and the
+        # statistics estimate the size and number of all of them.
+        nblock = 20000
+        data = [allocate_bytes(200)[0] for i in range(nblock)]
+        snapshot = tracemalloc.take_snapshot()
+        snapshot = snapshot.filter_traces(
+            (tracemalloc.Filter(True, allocate_bytes.__code__.co_filename),))
+        stats = snapshot.statistics('lineno')
+        self.assertLess(len(snapshot.traces), nblock / 20)
+        size = sum(stat.size for stat in stats)
+        count = sum(stat.count for stat in stats)
+        self.assertGreater(size, nblock * 200 * 0.7)
+        self.assertLess(size, nblock * 200 * 1.3)
+        self.assertGreater(count, nblock * 0.7)
+        self.assertLess(count, nblock * 1.3)
+        self.assertEqual(len(snapshot.traces[0]._trace), 5)
+
+        # Large memory blocks are always traced
+        obj_size = 1024 * 1024
+        obj, obj_traceback = allocate_bytes(obj_size)
+        self.assertEqual(tracemalloc.get_object_traceback(obj), obj_traceback)
+        del data
+
+        tracemalloc.stop()
+        tracemalloc.start(1)
+        self.assertEqual(tracemalloc.get_sampling_interval(), 0)
+
     def test_clear_traces(self):
         obj, obj_traceback = allocate_bytes(123)
         traceback = tracemalloc.get_object_traceback(obj)
@@ -385,6 +420,30 @@ def test_create_snapshot(self):
             self.assertEqual(trace.traceback[0].filename, 'a.py')
             self.assertEqual(trace.traceback[0].lineno, 2)
 
+    def test_sampled_traces(self):
+        # In sampling mode, traces have a fifth item: the estimated number
+        # of memory blocks they stand for.
+        raw_traces = [
+            (0, 4000, (('a.py', 2),), 1, 100),
+            (0, 2000, (('a.py', 2),), 1, 50),
+            (0, 10, (('b.py', 4),), 1),
+        ]
+        snapshot = tracemalloc.Snapshot(raw_traces, 1)
+        trace = snapshot.traces[0]
+        self.assertEqual(trace.size, 4000)
+        self.assertEqual(trace.traceback, traceback_lineno('a.py', 2))
+        self.assertEqual(snapshot.statistics('lineno'), [
+            tracemalloc.Statistic(traceback_lineno('a.py', 2), 6000, 150),
+            tracemalloc.Statistic(traceback_lineno('b.py', 4), 10, 1),
+        ])
+        self.assertEqual(snapshot.statistics('filename', cumulative=True), [
+            tracemalloc.Statistic(traceback_filename('a.py'), 6000, 150),
+            tracemalloc.Statistic(traceback_filename('b.py'), 10, 1),
+        ])
+        snapshot2 = snapshot.filter_traces(
+            (tracemalloc.Filter(False, 'b.py'),))
+        self.assertEqual(snapshot2.traces._traces, raw_traces[:2])
+
     def test_filter_traces(self):
         snapshot, snapshot2 = create_snapshots()
         filter1 = tracemalloc.Filter(False, "b.py")
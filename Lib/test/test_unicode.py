@@ -270,6 +270,28 @@ def test_rfind(self):
         self.checkequal(-1, 'a' * 100, 'rfind', '\U00100304a')
         self.checkequal(-1, '\u0102' * 100, 'rfind', '\U00100304\u0102')
 
+    def test_subscript_after_specialization(self):
+        # Repeated subscripts are specialized by the interpreter; the
+        # results must not change when the specialized forms miss.
+        def get(s, index):
+            return s[index]
+        def get_slice(s, start, stop):
+            return s[start:stop]
+        s = 'sp\xe4m'
+        for _ in range(100):
+            self.assertIs(get(s, 2), chr(0xe4))
+            self.assertEqual(get_slice(s, 1, 3), 'p\xe4')
+        self.assertEqual(get(s, -1), 'm')
+        self.assertEqual(get('\u20ac\U0001f40d', 1), '\U0001f40d')
+        self.assertEqual(get(StrSubclass('abc'), 1), 'b')
+        self.assertRaises(IndexError, get, s, 4)
+        self.assertRaises(TypeError, get, s, 1.0)
+        self.assertEqual(get_slice(s, -3, None), 'p\xe4m')
+        self.assertEqual(get_slice(s, 3, 1), '')
+        self.assertEqual(get_slice(s, -100, 100), s)
+        self.assertEqual(get_slice('\u20ac\U0001f40d!', 1, 2), '\U0001f40d')
+        self.assertEqual(get_slice(s, 0, 2**40), s)
+
     def test_index(self):
         string_tests.CommonTest.test_index(self)
         self.checkequalnofix(0, 'abcdefghiabc', 'index',  '')
@@ -146,6 +146,52 @@
 
 __test__ = {'doctests' : doctests}
 
+
+class TestSpecialization(unittest.TestCase):
+    # UNPACK_SEQUENCE is specialized for the type and the length of the
+    # sequences it unpacks while warming up: other sequences must still be
+    # unpacked in the right order, and the wrong lengths must still fail.
+
+    def check(self, unpack, seq, warmup):
+        for i in range(100):
+            self.assertEqual(unpack(warmup), tuple(warmup))
+        for other in (tuple(seq), list(seq), iter(seq), "".join(seq)):
+            self.assertEqual(unpack(other), tuple(seq))
+        class Seq(type(warmup)):
+            pass
+        self.assertEqual(unpack(Seq(seq)), tuple(seq))
+        n = len(seq)
+        msg = r"too many values to unpack \(expected %d\)" % n
+        for other in (tuple(warmup) + (0,), list(warmup) + [0]):
+            with self.assertRaisesRegex(ValueError, msg):
+                unpack(other)
+        msg = (r"not enough values to unpack \(expected %d, got %d\)"
+               % (n, n - 1))
+        for other in (tuple(warmup)[1:], list(warmup)[1:]):
+            with self.assertRaisesRegex(ValueError, msg):
+                unpack(other)
+        with self.assertRaises(TypeError):
+            unpack(None)
+
+    def test_two_tuple(self):
+        def unpack(seq):
+            a, b = seq
+            return a, b
+        self.check(unpack, "xy", (1, 2))
+
+    def test_tuple(self):
+        def unpack(seq):
+            a, b, c = seq
+            return a, b, c
+        self.check(unpack, "xyz", (1, 2, 3))
+
+    def test_list(self):
+        def unpack(seq):
+            a, b, c = seq
+            return a, b, c
+        self.check(unpack, "xyz", [1, 2, 3])
+
+
 def load_tests(loader, tests, pattern):
     tests.addTest(doctest.DocTestSuite())
     return tests
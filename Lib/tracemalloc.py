@@ -276,8 +276,10 @@ class Trace:
     __slots__ = ("_trace",)
 
     def __init__(self, trace):
-        # trace is a tuple: (domain: int, size: int, traceback: tuple).
-        # See Traceback constructor for the format of the traceback tuple.
+        # trace is a tuple: (domain: int, size: int, traceback: tuple,
+        # total_nframe: int), with a fifth item, count: int, if allocations
+        # are sampled.  See Traceback constructor for the format of the
+        # traceback tuple.
         self._trace = trace
 
     @property
@@ -290,7 +292,7 @@ def size(self):
 
     @property
     def traceback(self):
-        return Traceback(*self._trace[2:])
+        return Traceback(*self._trace[2:4])
 
     def __eq__(self, other):
         if not isinstance(other, Trace):
@@ -388,8 +390,8 @@ def _match_traceback(self, traceback):
             return self._match_frame(filename, lineno)
 
     def _match(self, trace):
-        domain, size, traceback, total_nframe = trace
-        res = self._match_traceback(traceback)
+        domain = trace[0]
+        res = self._match_traceback(trace[2])
         if self.domain is not None:
             if self.inclusive:
                 return res and (domain == self.domain)
@@ -408,8 +410,7 @@ def domain(self):
         return self._domain
 
     def _match(self, trace):
-        domain, size, traceback, total_nframe = trace
-        return (domain == self.domain) ^ (not self.inclusive)
+        return (trace[0] == self.domain) ^ (not self.inclusive)
 
 
 class Snapshot:
@@ -485,7 +486,10 @@ def _group_by(self, key_type, cumulative):
         tracebacks = {}
         if not cumulative:
             for trace in self.traces._traces:
-                domain, size, trace_traceback, total_nframe = trace
+                size = trace[1]
+                trace_traceback = trace[2]
+                # Estimated number of memory blocks in sampling mode
+                count = trace[4] if len(trace) > 4 else 1
                 try:
                     traceback = tracebacks[trace_traceback]
                 except KeyError:
@@ -500,13 +504,15 @@ def _group_by(self, key_type, cumulative):
                 try:
                     stat = stats[traceback]
                     stat.size += size
-                    stat.count += 1
+                    stat.count += count
                 except KeyError:
-                    stats[traceback] = Statistic(traceback, size, 1)
+                    stats[traceback] = Statistic(traceback, size, count)
         else:
             # cumulative statistics
             for trace in self.traces._traces:
-                domain, size, trace_traceback, total_nframe = trace
+                size = trace[1]
+                trace_traceback = trace[2]
+                count = trace[4] if len(trace) > 4 else 1
                 for frame in trace_traceback:
                     try:
                         traceback = tracebacks[frame]
@@ -520,9 +526,9 @@ def _group_by(self, key_type, cumulative):
                     try:
                         stat = stats[traceback]
                         stat.size += size
-                        stat.count += 1
+                        stat.count += count
                     except KeyError:
-                        stats[traceback] = Statistic(traceback, size, 1)
+                        stats[traceback] = Statistic(traceback, size, count)
         return stats
 
     def statistics(self, key_type, cumulative=False):
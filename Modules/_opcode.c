@@ -92,10 +92,100 @@ _opcode_get_specialization_stats_impl(PyObject *module)
 #endif
 }
 
+/*[clinic input]
+
+_opcode.enable_profile
+
+Enable the runtime opcode profile.
+
+While the profile is enabled, the interpreter samples the misses of the
+specialized instructions: it takes a sample each time a specialized
+instruction has missed often enough to be deoptimized, and records why
+the instruction could not be specialized again.
+[clinic start generated code]*/
+
+static PyObject *
+_opcode_enable_profile_impl(PyObject *module)
+/*[clinic end generated code: output=3b6811a2da1c640e input=508331492beb523b]*/
+{
+    _PyOpcodeProfile_SetEnabled(1);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+
+_opcode.disable_profile
+
+Disable the runtime opcode profile, keeping the recorded samples.
+[clinic start generated code]*/
+
+static PyObject *
+_opcode_disable_profile_impl(PyObject *module)
+/*[clinic end generated code: output=21f4e1c77b0d8ce4 input=e109806ce3bd6243]*/
+{
+    _PyOpcodeProfile_SetEnabled(0);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+
+_opcode.is_profile_enabled -> bool
+
+Return True if the runtime opcode profile is enabled.
+[clinic start generated code]*/
+
+static int
+_opcode_is_profile_enabled_impl(PyObject *module)
+/*[clinic end generated code: output=50eccb57ad01d7f5 input=b4a85a67e7a55dd1]*/
+{
+    return _PyOpcodeProfile_IsEnabled();
+}
+
+/*[clinic input]
+
+_opcode.get_profile
+
+Return the samples of the runtime opcode profile.
+
+The profile is a dict mapping (code, offset, opcode, reason) tuples to a
+number of samples.  offset is the offset of the instruction in bytes and
+opcode is the specialized opcode that missed; each sample stands for
+about 50 misses.  reason is the kind of the failure of the next attempt
+to specialize the instruction, as counted by the specialization stats,
+or None if the instruction has been specialized again or not tried yet.
+[clinic start generated code]*/
+
+static PyObject *
+_opcode_get_profile_impl(PyObject *module)
+/*[clinic end generated code: output=69cd9785978a553c input=3f1672af1d7fd354]*/
+{
+    return _PyOpcodeProfile_Get();
+}
+
+/*[clinic input]
+
+_opcode.reset_profile
+
+Discard the samples of the runtime opcode profile.
+[clinic start generated code]*/
+
+static PyObject *
+_opcode_reset_profile_impl(PyObject *module)
+/*[clinic end generated code: output=81a4c14ecd45bfca input=bf574ed80a8a65c2]*/
+{
+    _PyOpcodeProfile_Reset();
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef
 opcode_functions[] =  {
     _OPCODE_STACK_EFFECT_METHODDEF
     _OPCODE_GET_SPECIALIZATION_STATS_METHODDEF
+    _OPCODE_ENABLE_PROFILE_METHODDEF
+    _OPCODE_DISABLE_PROFILE_METHODDEF
+    _OPCODE_IS_PROFILE_ENABLED_METHODDEF
+    _OPCODE_GET_PROFILE_METHODDEF
+    _OPCODE_RESET_PROFILE_METHODDEF
     {NULL, NULL, 0, NULL}
 };
 
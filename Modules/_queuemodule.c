@@ -4,6 +4,7 @@
 
 #include "Python.h"
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
+#include "pycore_runtime.h"       // _PyRuntime.fork_generation
 #include "structmember.h"         // PyMemberDef
 #include <stddef.h>               // offsetof()
 
@@ -23,12 +24,38 @@ static struct PyModuleDef queuemodule;
 #define simplequeue_get_state_by_type(type) \
     (simplequeue_get_state(_PyType_GetModuleByDef(type, &queuemodule)))
 
+/* A get() call waiting for an item on an empty queue.  It sleeps on its
+   own lock, which is held while it is parked: put() adds the item to the
+   buffer, removes the first waiter from the queue and releases its lock,
+   so that only one thread wakes up for each item. */
+typedef struct simplequeue_waiter {
+    struct simplequeue_waiter *next;
+    PyThread_type_lock lock;
+    /* Set by put() when it wakes the waiter up */
+    int woken;
+} simplequeue_waiter;
+
+/* Number of parking locks kept by a queue for later get() calls. */
+#define SIMPLEQUEUE_SPARE_LOCKS 8
+
+/* Smallest capacity of the circular buffer of items. */
+#define SIMPLEQUEUE_MIN_CAPACITY 8
+
 typedef struct {
     PyObject_HEAD
-    PyThread_type_lock lock;
-    int locked;
-    PyObject *lst;
-    Py_ssize_t lst_pos;
+    /* Circular buffer of 'count' items starting at 'head'.  The capacity
+       is zero or a power of two. */
+    PyObject **items;
+    Py_ssize_t head;
+    Py_ssize_t count;
+    Py_ssize_t capacity;
+    /* Parked get() calls, oldest first.  They are lost in a forked child,
+       which is detected by comparing 'fork_generation' to the runtime's. */
+    simplequeue_waiter *waiters;
+    simplequeue_waiter *last_waiter;
+    unsigned long fork_generation;
+    PyThread_type_lock spare_locks[SIMPLEQUEUE_SPARE_LOCKS];
+    int nspare_locks;
     PyObject *weakreflist;
 } simplequeueobject;
 
@@ -38,10 +65,39 @@ class _queue.SimpleQueue "simplequeueobject *" "simplequeue_get_state_by_type(ty
 [clinic start generated code]*/
 /*[clinic end generated code: output=da39a3ee5e6b4b0d input=0a4023fe4d198c8d]*/
 
+#define SIMPLEQUEUE_ITEM(self, i) \
+    ((self)->items[((self)->head + (i)) & ((self)->capacity - 1)])
+
+/* Forget the get() calls parked by the threads of the parent process in a
+   forked child, where these threads don't exist. */
+static void
+simplequeue_check_fork(simplequeueobject *self)
+{
+    if (self->fork_generation != _PyRuntime.fork_generation) {
+        self->waiters = NULL;
+        self->last_waiter = NULL;
+        self->fork_generation = _PyRuntime.fork_generation;
+    }
+}
+
 static int
 simplequeue_clear(simplequeueobject *self)
 {
-    Py_CLEAR(self->lst);
+    PyObject **items = self->items;
+    Py_ssize_t head = self->head;
+    Py_ssize_t count = self->count;
+    Py_ssize_t mask = self->capacity - 1;
+
+    /* Empty the queue before releasing the items, whose finalizers
+       may put new items. */
+    self->items = NULL;
+    self->head = 0;
+    self->count = 0;
+    self->capacity = 0;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        Py_DECREF(items[(head + i) & mask]);
+    }
+    PyMem_Free(items);
     return 0;
 }
 
@@ -51,11 +107,13 @@ simplequeue_dealloc(simplequeueobject *self)
     PyTypeObject *tp = Py_TYPE(self);
 
     PyObject_GC_UnTrack(self);
-    if (self->lock != NULL) {
+    /* A parked get() call holds a reference to the queue */
+    simplequeue_check_fork(self);
+    assert(self->waiters == NULL);
+    for (int i = 0; i < self->nspare_locks; i++) {
         /* Unlock the lock so it's safe to free it */
-        if (self->locked > 0)
-            PyThread_release_lock(self->lock);
-        PyThread_free_lock(self->lock);
+        PyThread_release_lock(self->spare_locks[i]);
+        PyThread_free_lock(self->spare_locks[i]);
     }
     (void)simplequeue_clear(self);
     if (self->weakreflist != NULL)
@@ -67,7 +125,9 @@ simplequeue_dealloc(simplequeueobject *self)
 static int
 simplequeue_traverse(simplequeueobject *self, visitproc visit, void *arg)
 {
-    Py_VISIT(self->lst);
+    for (Py_ssize_t i = 0; i < self->count; i++) {
+        Py_VISIT(SIMPLEQUEUE_ITEM(self, i));
+    }
     Py_VISIT(Py_TYPE(self));
     return 0;
 }
@@ -88,23 +148,115 @@ simplequeue_new_impl(PyTypeObject *type)
     self = (simplequeueobject *) type->tp_alloc(type, 0);
     if (self != NULL) {
         self->weakreflist = NULL;
-        self->lst = PyList_New(0);
-        self->lock = PyThread_allocate_lock();
-        self->lst_pos = 0;
-        if (self->lock == NULL) {
-            Py_DECREF(self);
-            PyErr_SetString(PyExc_MemoryError, "can't allocate lock");
-            return NULL;
-        }
-        if (self->lst == NULL) {
-            Py_DECREF(self);
-            return NULL;
-        }
+        self->items = NULL;
+        self->head = 0;
+        self->count = 0;
+        self->capacity = 0;
+        self->waiters = NULL;
+        self->last_waiter = NULL;
+        self->fork_generation = _PyRuntime.fork_generation;
+        self->nspare_locks = 0;
     }
 
     return (PyObject *) self;
 }
 
+/* Move the items to a new buffer of 'capacity' items, which must be a
+   power of two large enough to hold them.  This never runs Python code,
+   so that put() stays reentrant. */
+static int
+simplequeue_resize(simplequeueobject *self, Py_ssize_t capacity)
+{
+    PyObject **items;
+
+    assert(capacity >= self->count);
+    assert((capacity & (capacity - 1)) == 0);
+    items = PyMem_New(PyObject *, capacity);
+    if (items == NULL) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < self->count; i++) {
+        items[i] = SIMPLEQUEUE_ITEM(self, i);
+    }
+    PyMem_Free(self->items);
+    self->items = items;
+    self->head = 0;
+    self->capacity = capacity;
+    return 0;
+}
+
+/* Make room for 'n' more items. */
+static int
+simplequeue_reserve(simplequeueobject *self, Py_ssize_t n)
+{
+    Py_ssize_t capacity = self->capacity;
+
+    if (n <= capacity - self->count) {
+        return 0;
+    }
+    if (n > PY_SSIZE_T_MAX / (Py_ssize_t)sizeof(PyObject *) / 2
+        - self->count) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (capacity == 0) {
+        capacity = SIMPLEQUEUE_MIN_CAPACITY;
+    }
+    while (capacity - self->count < n) {
+        capacity *= 2;
+    }
+    if (simplequeue_resize(self, capacity) < 0) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* Add an item to the buffer, which must have room for it. */
+static void
+simplequeue_push(simplequeueobject *self, PyObject *item)
+{
+    assert(self->count < self->capacity);
+    Py_INCREF(item);
+    SIMPLEQUEUE_ITEM(self, self->count) = item;
+    self->count++;
+}
+
+/* Wake up the oldest parked get() call, if any. */
+static void
+simplequeue_wake_waiter(simplequeueobject *self)
+{
+    simplequeue_waiter *waiter = self->waiters;
+
+    if (waiter != NULL) {
+        self->waiters = waiter->next;
+        if (self->waiters == NULL) {
+            self->last_waiter = NULL;
+        }
+        waiter->woken = 1;
+        PyThread_release_lock(waiter->lock);
+    }
+}
+
+/* Remove the first item of the buffer and return it. */
+static PyObject *
+simplequeue_pop(simplequeueobject *self)
+{
+    PyObject *item;
+
+    assert(self->count > 0);
+    item = self->items[self->head];
+    self->head = (self->head + 1) & (self->capacity - 1);
+    self->count--;
+    if (self->capacity > SIMPLEQUEUE_MIN_CAPACITY
+        && self->count < self->capacity / 8) {
+        /* Give back most of the space left by a burst of items.  The
+           buffer is only shrunk if the allocation succeeds. */
+        (void)simplequeue_resize(self, self->capacity / 2);
+    }
+    return item;
+}
+
 /*[clinic input]
 _queue.SimpleQueue.put
     item: object
@@ -124,13 +276,11 @@ _queue_SimpleQueue_put_impl(simplequeueobject *self, PyObject *item,
 /*[clinic end generated code: output=4333136e88f90d8b input=6e601fa707a782d5]*/
 {
     /* BEGIN GIL-protected critical section */
-    if (PyList_Append(self->lst, item) < 0)
+    if (simplequeue_reserve(self, 1) < 0)
         return NULL;
-    if (self->locked) {
-        /* A get() may be waiting, wake it up */
-        self->locked = 0;
-        PyThread_release_lock(self->lock);
-    }
+    simplequeue_push(self, item);
+    simplequeue_check_fork(self);
+    simplequeue_wake_waiter(self);
     /* END GIL-protected critical section */
     Py_RETURN_NONE;
 }
@@ -153,63 +303,133 @@ _queue_SimpleQueue_put_nowait_impl(simplequeueobject *self, PyObject *item)
     return _queue_SimpleQueue_put_impl(self, item, 0, Py_None);
 }
 
+/*[clinic input]
+_queue.SimpleQueue.put_many
+    items: object
+    /
+
+Put all the items of an iterable on the queue.
+
+The items are added together: another thread cannot put items between
+them.  This method never blocks.
+
+[clinic start generated code]*/
+
 static PyObject *
-simplequeue_pop_item(simplequeueobject *self)
+_queue_SimpleQueue_put_many(simplequeueobject *self, PyObject *items)
+/*[clinic end generated code: output=5f53df0b226d2025 input=948e4c686bfb3b17]*/
 {
-    Py_ssize_t count, n;
-    PyObject *item;
+    PyObject *seq;
+    Py_ssize_t n;
 
-    n = PyList_GET_SIZE(self->lst);
-    assert(self->lst_pos < n);
-
-    item = PyList_GET_ITEM(self->lst, self->lst_pos);
-    Py_INCREF(Py_None);
-    PyList_SET_ITEM(self->lst, self->lst_pos, Py_None);
-    self->lst_pos += 1;
-    count = n - self->lst_pos;
-    if (self->lst_pos > count) {
-        /* The list is more than 50% empty, reclaim space at the beginning */
-        if (PyList_SetSlice(self->lst, 0, self->lst_pos, NULL)) {
-            /* Undo pop */
-            self->lst_pos -= 1;
-            PyList_SET_ITEM(self->lst, self->lst_pos, item);
-            return NULL;
-        }
-        self->lst_pos = 0;
+    seq = PySequence_Fast(items, "put_many() argument must be iterable");
+    if (seq == NULL) {
+        return NULL;
     }
-    return item;
+    n = PySequence_Fast_GET_SIZE(seq);
+    /* BEGIN GIL-protected critical section */
+    if (simplequeue_reserve(self, n) < 0) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        simplequeue_push(self, PySequence_Fast_GET_ITEM(seq, i));
+    }
+    simplequeue_check_fork(self);
+    for (Py_ssize_t i = 0; i < n && self->waiters != NULL; i++) {
+        simplequeue_wake_waiter(self);
+    }
+    /* END GIL-protected critical section */
+    Py_DECREF(seq);
+    Py_RETURN_NONE;
 }
 
-/*[clinic input]
-_queue.SimpleQueue.get
+static PyThread_type_lock
+simplequeue_get_parking_lock(simplequeueobject *self)
+{
+    PyThread_type_lock lock;
 
-    cls: defining_class
-    /
-    block: bool = True
-    timeout as timeout_obj: object = None
+    if (self->nspare_locks > 0) {
+        return self->spare_locks[--self->nspare_locks];
+    }
+    lock = PyThread_allocate_lock();
+    if (lock == NULL) {
+        PyErr_SetString(PyExc_MemoryError, "can't allocate lock");
+        return NULL;
+    }
+    /* A parking lock is held until put() releases it */
+    PyThread_acquire_lock(lock, WAIT_LOCK);
+    return lock;
+}
 
-Remove and return an item from the queue.
+static void
+simplequeue_release_parking_lock(simplequeueobject *self,
+                                 PyThread_type_lock lock)
+{
+    if (self->nspare_locks < SIMPLEQUEUE_SPARE_LOCKS) {
+        self->spare_locks[self->nspare_locks++] = lock;
+    }
+    else {
+        PyThread_release_lock(lock);
+        PyThread_free_lock(lock);
+    }
+}
 
-If optional args 'block' is true and 'timeout' is None (the default),
-block if necessary until an item is available. If 'timeout' is
-a non-negative number, it blocks at most 'timeout' seconds and raises
-the Empty exception if no item was available within that time.
-Otherwise ('block' is false), return an item if one is immediately
-available, else raise the Empty exception ('timeout' is ignored
-in that case).
+/* Park a get() call, at the end of the waiters or, if it was woken up but
+   found that the item was taken by another call, at their front. */
+static void
+simplequeue_add_waiter(simplequeueobject *self, simplequeue_waiter *waiter,
+                       int first)
+{
+    assert(self->count == 0);
+    if (first || self->waiters == NULL) {
+        waiter->next = self->waiters;
+        self->waiters = waiter;
+        if (self->last_waiter == NULL) {
+            self->last_waiter = waiter;
+        }
+    }
+    else {
+        waiter->next = NULL;
+        self->last_waiter->next = waiter;
+        self->last_waiter = waiter;
+    }
+}
 
-[clinic start generated code]*/
+static void
+simplequeue_remove_waiter(simplequeueobject *self, simplequeue_waiter *waiter)
+{
+    simplequeue_waiter *prev = NULL;
+    simplequeue_waiter *w = self->waiters;
+
+    while (w != waiter) {
+        assert(w != NULL);
+        prev = w;
+        w = w->next;
+    }
+    if (prev == NULL) {
+        self->waiters = waiter->next;
+    }
+    else {
+        prev->next = waiter->next;
+    }
+    if (self->last_waiter == waiter) {
+        self->last_waiter = prev;
+    }
+}
 
+/* Remove the first item of the queue and return it, waiting for one as
+   get() does. */
 static PyObject *
-_queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
-                            int block, PyObject *timeout_obj)
-/*[clinic end generated code: output=5c2cca914cd1e55b input=5b4047bfbc645ec1]*/
+simplequeue_get_item(simplequeueobject *self, PyTypeObject *cls,
+                     int block, PyObject *timeout_obj)
 {
     _PyTime_t endtime = 0;
     _PyTime_t timeout;
-    PyObject *item;
+    PyObject *item = NULL;
     PyLockStatus r;
     PY_TIMEOUT_T microseconds;
+    simplequeue_waiter waiter;
 
     if (block == 0) {
         /* Non-blocking */
@@ -240,49 +460,119 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
         microseconds = -1;
     }
 
-    /* put() signals the queue to be non-empty by releasing the lock.
-     * So we simply try to acquire the lock in a loop, until the condition
-     * (queue non-empty) becomes true.
-     */
-    while (self->lst_pos == PyList_GET_SIZE(self->lst)) {
-        /* First a simple non-blocking try without releasing the GIL */
-        r = PyThread_acquire_lock_timed(self->lock, 0, 0);
-        if (r == PY_LOCK_FAILURE && microseconds != 0) {
-            Py_BEGIN_ALLOW_THREADS
-            r = PyThread_acquire_lock_timed(self->lock, microseconds, 1);
-            Py_END_ALLOW_THREADS
-        }
+    simplequeue_check_fork(self);
+    if (self->count > 0) {
+        return simplequeue_pop(self);
+    }
+    if (microseconds == 0) {
+        goto empty;
+    }
 
-        if (r == PY_LOCK_INTR && Py_MakePendingCalls() < 0) {
-            return NULL;
+    /* Park on a lock of our own until put() wakes us up. */
+    waiter.lock = simplequeue_get_parking_lock(self);
+    if (waiter.lock == NULL) {
+        return NULL;
+    }
+    waiter.woken = 0;
+    for (;;) {
+        /* BEGIN GIL-protected critical section */
+        simplequeue_add_waiter(self, &waiter, waiter.woken);
+        waiter.woken = 0;
+        /* END GIL-protected critical section */
+
+        Py_BEGIN_ALLOW_THREADS
+        r = PyThread_acquire_lock_timed(waiter.lock, microseconds, 1);
+        Py_END_ALLOW_THREADS
+
+        if (waiter.woken) {
+            /* put() removed us from the waiters and released the lock,
+               maybe after we timed out or were interrupted. */
+            if (r != PY_LOCK_ACQUIRED) {
+                PyThread_acquire_lock(waiter.lock, WAIT_LOCK);
+            }
         }
-        if (r == PY_LOCK_FAILURE) {
-            PyObject *module = PyType_GetModule(cls);
-            simplequeue_state *state = simplequeue_get_state(module);
-            /* Timed out */
-            PyErr_SetNone(state->EmptyError);
-            return NULL;
+        else {
+            assert(r != PY_LOCK_ACQUIRED);
+            simplequeue_remove_waiter(self, &waiter);
+        }
+        /* Another get() call may have taken the item first */
+        if (self->count > 0) {
+            item = simplequeue_pop(self);
+            break;
+        }
+        if (r == PY_LOCK_INTR) {
+            if (Py_MakePendingCalls() < 0) {
+                break;
+            }
+            /* A signal handler may put items */
+            if (self->count > 0) {
+                item = simplequeue_pop(self);
+                break;
+            }
+        }
+        else if (r == PY_LOCK_FAILURE) {
+            break;
         }
-        self->locked = 1;
 
         /* Adjust timeout for next iteration (if any) */
         if (microseconds > 0) {
             timeout = _PyDeadline_Get(endtime);
             microseconds = _PyTime_AsMicroseconds(timeout,
                                                   _PyTime_ROUND_CEILING);
+            if (microseconds <= 0) {
+                break;
+            }
         }
     }
+    simplequeue_release_parking_lock(self, waiter.lock);
+    if (item != NULL) {
+        return item;
+    }
+    if (PyErr_Occurred()) {
+        /* Let another get() call have the item we may have been woken up
+           for */
+        if (self->count > 0) {
+            simplequeue_wake_waiter(self);
+        }
+        return NULL;
+    }
 
-    /* BEGIN GIL-protected critical section */
-    assert(self->lst_pos < PyList_GET_SIZE(self->lst));
-    item = simplequeue_pop_item(self);
-    if (self->locked) {
-        PyThread_release_lock(self->lock);
-        self->locked = 0;
+empty:
+    {
+        PyObject *module = PyType_GetModule(cls);
+        simplequeue_state *state = simplequeue_get_state(module);
+        /* Timed out */
+        PyErr_SetNone(state->EmptyError);
+        return NULL;
     }
-    /* END GIL-protected critical section */
+}
 
-    return item;
+/*[clinic input]
+_queue.SimpleQueue.get
+
+    cls: defining_class
+    /
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return an item from the queue.
+
+If optional args 'block' is true and 'timeout' is None (the default),
+block if necessary until an item is available. If 'timeout' is
+a non-negative number, it blocks at most 'timeout' seconds and raises
+the Empty exception if no item was available within that time.
+Otherwise ('block' is false), return an item if one is immediately
+available, else raise the Empty exception ('timeout' is ignored
+in that case).
+
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
+                            int block, PyObject *timeout_obj)
+/*[clinic end generated code: output=5c2cca914cd1e55b input=5b4047bfbc645ec1]*/
+{
+    return simplequeue_get_item(self, cls, block, timeout_obj);
 }
 
 /*[clinic input]
@@ -302,7 +592,67 @@ _queue_SimpleQueue_get_nowait_impl(simplequeueobject *self,
                                    PyTypeObject *cls)
 /*[clinic end generated code: output=620c58e2750f8b8a input=842f732bf04216d3]*/
 {
-    return _queue_SimpleQueue_get_impl(self, cls, 0, Py_None);
+    return simplequeue_get_item(self, cls, 0, Py_None);
+}
+
+/*[clinic input]
+_queue.SimpleQueue.get_many
+
+    cls: defining_class
+    /
+    maxcount: Py_ssize_t
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return a list of at most 'maxcount' items from the queue.
+
+Wait for the first item as get() does, then also remove the items which
+are immediately available, up to 'maxcount' items in all.
+
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t maxcount, int block,
+                                 PyObject *timeout_obj)
+/*[clinic end generated code: output=61a61c5eea955c12 input=ba689f8df1dfe504]*/
+{
+    PyObject *first, *result;
+    Py_ssize_t n;
+
+    if (maxcount <= 0) {
+        PyErr_SetString(PyExc_ValueError, "'maxcount' must be positive");
+        return NULL;
+    }
+    first = simplequeue_get_item(self, cls, block, timeout_obj);
+    if (first == NULL) {
+        return NULL;
+    }
+    n = Py_MIN(maxcount - 1, self->count);
+    result = PyList_New(n + 1);
+    if (result == NULL) {
+        /* Put the item back at the front of the queue */
+        if (simplequeue_reserve(self, 1) == 0) {
+            self->head = (self->head - 1) & (self->capacity - 1);
+            self->items[self->head] = first;
+            self->count++;
+            simplequeue_wake_waiter(self);
+        }
+        else {
+            Py_DECREF(first);
+        }
+        return NULL;
+    }
+    /* Allocating the list may have run finalizers which got items */
+    if (n > self->count) {
+        n = self->count;
+        Py_SET_SIZE(result, n + 1);
+    }
+    PyList_SET_ITEM(result, 0, first);
+    for (Py_ssize_t i = 1; i <= n; i++) {
+        PyList_SET_ITEM(result, i, simplequeue_pop(self));
+    }
+    return result;
 }
 
 /*[clinic input]
@@ -315,7 +665,7 @@ static int
 _queue_SimpleQueue_empty_impl(simplequeueobject *self)
 /*[clinic end generated code: output=1a02a1b87c0ef838 input=1a98431c45fd66f9]*/
 {
-    return self->lst_pos == PyList_GET_SIZE(self->lst);
+    return self->count == 0;
 }
 
 /*[clinic input]
@@ -328,7 +678,7 @@ static Py_ssize_t
 _queue_SimpleQueue_qsize_impl(simplequeueobject *self)
 /*[clinic end generated code: output=f9dcd9d0a90e121e input=7a74852b407868a1]*/
 {
-    return PyList_GET_SIZE(self->lst) - self->lst_pos;
+    return self->count;
 }
 
 static int
@@ -361,8 +711,10 @@ queue_free(void *m)
 static PyMethodDef simplequeue_methods[] = {
     _QUEUE_SIMPLEQUEUE_EMPTY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_METHODDEF
+    _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_METHODDEF
+    _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_QSIZE_METHODDEF
     {"__class_getitem__",    Py_GenericAlias,
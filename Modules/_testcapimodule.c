@@ -3068,6 +3068,82 @@ test_thread_state(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* Create and delete thread states from a thread spawned by C code, the way
+ * embedders do: each thread state allocates and frees objects, which fills
+ * its pymalloc cache, then it is cleared with the GIL held and deleted with
+ * the GIL released, while other threads may be allocating. */
+struct thread_state_delete_data {
+    PyInterpreterState *interp;
+    int loops;
+    int success;
+    PyThread_type_lock done;
+};
+
+static void
+thread_state_delete_thread(void *arg)
+{
+    struct thread_state_delete_data *data = arg;
+    for (int i = 0; i < data->loops; i++) {
+        PyThreadState *tstate = PyThreadState_New(data->interp);
+        if (tstate == NULL) {
+            data->success = 0;
+            break;
+        }
+        PyEval_RestoreThread(tstate);
+        PyObject *list = PyList_New(0);
+        /* Objects of many size classes, to fill many caches */
+        for (int j = 0; list != NULL && j < 1000; j++) {
+            PyObject *item = PyBytes_FromStringAndSize(NULL, j % 480);
+            if (item == NULL || PyList_Append(list, item) < 0) {
+                Py_CLEAR(list);
+            }
+            Py_XDECREF(item);
+        }
+        if (list == NULL) {
+            PyErr_Clear();
+            data->success = 0;
+        }
+        Py_XDECREF(list);
+        PyThreadState_Clear(tstate);
+        PyEval_SaveThread();
+        PyThreadState_Delete(tstate);
+    }
+    PyThread_release_lock(data->done);
+}
+
+static PyObject *
+test_thread_state_delete(PyObject *self, PyObject *args)
+{
+    struct thread_state_delete_data data;
+    if (!PyArg_ParseTuple(args, "i:test_thread_state_delete", &data.loops)) {
+        return NULL;
+    }
+    data.interp = PyThreadState_Get()->interp;
+    data.success = 1;
+    data.done = PyThread_allocate_lock();
+    if (data.done == NULL) {
+        return PyErr_NoMemory();
+    }
+    PyThread_acquire_lock(data.done, 1);
+
+    if (PyThread_start_new_thread(thread_state_delete_thread,
+                                  &data) == PYTHREAD_INVALID_THREAD_ID) {
+        PyThread_free_lock(data.done);
+        PyErr_SetString(PyExc_RuntimeError, "can't start new thread");
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(data.done, 1);
+    Py_END_ALLOW_THREADS
+    PyThread_free_lock(data.done);
+
+    if (!data.success) {
+        PyErr_SetString(PyExc_RuntimeError, "thread state test failed");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
 /* test Py_AddPendingCalls using threads */
 static int _pending_callback(void *arg)
 {
@@ -6012,6 +6088,7 @@ static PyMethodDef TestMethods[] = {
     {"unicode_legacy_string",   unicode_legacy_string,           METH_VARARGS},
 #endif /* USE_UNICODE_WCHAR_CACHE */
     {"_test_thread_state",      test_thread_state,               METH_VARARGS},
+    {"_test_thread_state_delete", test_thread_state_delete,      METH_VARARGS},
     {"_pending_threadfunc",     pending_threadfunc,              METH_VARARGS},
 #ifdef HAVE_GETTIMEOFDAY
     {"profile_int",             profile_int,                     METH_NOARGS},
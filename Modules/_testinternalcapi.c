@@ -398,6 +398,17 @@ get_getpath_codeobject(PyObject *self, PyObject *Py_UNUSED(args)) {
     return _Py_Get_Getpath_CodeObject();
 }
 
+static PyObject *
+has_inline_values(PyObject *self, PyObject *obj)
+{
+    Py_ssize_t offset = Py_TYPE(obj)->tp_inline_values_offset;
+    if (offset == 0) {
+        Py_RETURN_FALSE;
+    }
+    PyDictValues *values = *(PyDictValues **)((char *)obj + offset);
+    return PyBool_FromLong(values != NULL);
+}
+
 
 static PyMethodDef TestMethods[] = {
     {"get_configs", get_configs, METH_NOARGS},
@@ -413,6 +424,7 @@ static PyMethodDef TestMethods[] = {
     {"test_edit_cost", test_edit_cost, METH_NOARGS},
     {"normalize_path", normalize_path, METH_O, NULL},
     {"get_getpath_codeobject", get_getpath_codeobject, METH_NOARGS, NULL},
+    {"has_inline_values", has_inline_values, METH_O, NULL},
     {NULL, NULL} /* sentinel */
 };
 
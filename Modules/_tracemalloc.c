@@ -133,6 +133,56 @@ static _Py_hashtable_t *tracemalloc_traces = NULL;
    Protected by TABLES_LOCK(). */
 static _Py_hashtable_t *tracemalloc_domains = NULL;
 
+/* Sampling mode: only trace some memory blocks, chosen by Poisson sampling
+   of the allocated bytes.  Each allocated byte is sampled with probability
+   1/sampling_interval, and a memory block is traced if one of its bytes is
+   sampled: a block of size bytes is traced with probability
+   p = 1 - exp(-size / sampling_interval).  Each trace stands for 1/p memory
+   blocks and size/p bytes: get_traced_memory() and the statistics of
+   snapshots report these estimates.
+
+   Mean number of bytes between two sampled bytes, or 0 if all memory blocks
+   are traced.  Only modified by tracemalloc_start(), while not tracing. */
+static size_t tracemalloc_sampling_interval = 0;
+
+typedef struct {
+    /* Number of bytes to allocate before the next sampled byte */
+    size_t countdown;
+    /* State of the pseudo-random number generator drawing the number of
+       bytes between two sampled bytes */
+    uint64_t random;
+} sampler_t;
+
+/* Sampler of the PYMEM_DOMAIN_MEM and PYMEM_DOMAIN_OBJ domains and of
+   PyTraceMalloc_Track().  Protected by the GIL. */
+static sampler_t tracemalloc_sampler;
+
+/* Sampler of the PYMEM_DOMAIN_RAW domain, which can be used without the GIL.
+   Protected by TABLES_LOCK(). */
+static sampler_t tracemalloc_raw_sampler;
+
+/* pymalloc serves requests of up to 512 bytes from its pools, even with the
+   debug hooks which add a few words to each memory block: the allocators of
+   the PYMEM_DOMAIN_MEM and PYMEM_DOMAIN_OBJ domains only make a nested
+   allocation for memory blocks of this size or smaller when they grow the
+   table of arenas.  The memory blocks which are not sampled skip the
+   reentrancy check. */
+#define UNNESTED_ALLOC_SIZE 256
+
+/* Counting filter of the addresses of the traced memory blocks.  In sampling
+   mode, most freed memory blocks are not traced: the filter avoids taking
+   TABLES_LOCK() and looking up the traces for them.  Each counter is the
+   number of traces whose address maps to it, and sticks at UINT8_MAX.
+
+   Modified with TABLES_LOCK() held.  tracemalloc_maybe_traced() reads it
+   without the lock: the counter of the address of a traced memory block
+   cannot drop to zero until the block itself is freed. */
+#define TRACE_FILTER_SIZE (1 << 16)
+static uint8_t tracemalloc_trace_filter[TRACE_FILTER_SIZE];
+
+#define TRACE_FILTER_INDEX(ptr) \
+        ((((ptr) >> 4) ^ ((ptr) >> 20)) & (TRACE_FILTER_SIZE - 1))
+
 
 #ifdef TRACE_DEBUG
 static void
@@ -301,6 +351,127 @@ hashtable_compare_traceback(const void *key1, const void *key2)
 }
 
 
+/* Draw the number of bytes until the next sampled byte from an exponential
+   distribution of mean tracemalloc_sampling_interval. */
+static size_t
+sampler_next_interval(sampler_t *sampler)
+{
+    /* xorshift64* generator */
+    uint64_t x = sampler->random;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    sampler->random = x;
+    x *= 0x2545F4914F6CDD1DULL;
+
+    /* uniform in (0; 1] */
+    double u = ((double)(x >> 11) + 1.0) / 9007199254740992.0;
+    double interval = -log(u) * (double)tracemalloc_sampling_interval;
+    if (interval >= (double)SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return (size_t)interval;
+}
+
+
+static void
+sampler_init(sampler_t *sampler, uint64_t seed)
+{
+    sampler->random = seed;
+    sampler->countdown = sampler_next_interval(sampler);
+}
+
+
+/* Return 1 if a new memory block of size bytes must be traced, 0 if it is
+   not sampled. */
+static inline int
+tracemalloc_sample(sampler_t *sampler, size_t size)
+{
+    if (tracemalloc_sampling_interval == 0) {
+        return 1;
+    }
+    if (size < sampler->countdown) {
+        sampler->countdown -= size;
+        return 0;
+    }
+    /* The interval is memoryless: the bytes of the block after the sampled
+       one don't need to be counted. */
+    sampler->countdown = sampler_next_interval(sampler);
+    return 1;
+}
+
+
+static void
+trace_filter_add(uintptr_t ptr)
+{
+    uint8_t *counter = &tracemalloc_trace_filter[TRACE_FILTER_INDEX(ptr)];
+    if (*counter < UINT8_MAX) {
+        (*counter)++;
+    }
+}
+
+
+static void
+trace_filter_remove(uintptr_t ptr)
+{
+    uint8_t *counter = &tracemalloc_trace_filter[TRACE_FILTER_INDEX(ptr)];
+    assert(*counter > 0);
+    if (*counter < UINT8_MAX) {
+        (*counter)--;
+    }
+}
+
+
+/* Return 0 if the memory block at ptr is not traced, 1 if it may be. */
+static inline int
+tracemalloc_maybe_traced(uintptr_t ptr)
+{
+    if (tracemalloc_sampling_interval == 0) {
+        return 1;
+    }
+    return tracemalloc_trace_filter[TRACE_FILTER_INDEX(ptr)] != 0;
+}
+
+
+/* Probability that a memory block of size bytes is traced */
+static double
+tracemalloc_sample_probability(size_t size)
+{
+    if (tracemalloc_sampling_interval == 0 || size == 0) {
+        return 1.0;
+    }
+    return -expm1(-(double)size / (double)tracemalloc_sampling_interval);
+}
+
+
+/* Estimated number of bytes allocated by the memory blocks of size bytes
+   that a trace stands for */
+static size_t
+tracemalloc_estimated_size(size_t size)
+{
+    if (tracemalloc_sampling_interval == 0) {
+        return size;
+    }
+    double estimate = (double)size / tracemalloc_sample_probability(size);
+    if (estimate >= (double)SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return (size_t)(estimate + 0.5);
+}
+
+
+/* Estimated number of memory blocks of size bytes that a trace stands for */
+static size_t
+tracemalloc_estimated_count(size_t size)
+{
+    double estimate = 1.0 / tracemalloc_sample_probability(size);
+    if (estimate >= (double)SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return (size_t)(estimate + 0.5);
+}
+
+
 static void
 tracemalloc_get_frame(InterpreterFrame *pyframe, frame_t *frame)
 {
@@ -508,8 +679,10 @@ tracemalloc_remove_trace(unsigned int domain, uintptr_t ptr)
     if (!trace) {
         return;
     }
-    assert(tracemalloc_traced_memory >= trace->size);
-    tracemalloc_traced_memory -= trace->size;
+    size_t size = tracemalloc_estimated_size(trace->size);
+    assert(tracemalloc_traced_memory >= size);
+    tracemalloc_traced_memory -= size;
+    trace_filter_remove(ptr);
     raw_free(trace);
 }
 
@@ -544,8 +717,9 @@ tracemalloc_add_trace(unsigned int domain, uintptr_t ptr,
     trace_t *trace = _Py_hashtable_get(traces, TO_PTR(ptr));
     if (trace != NULL) {
         /* the memory block is already tracked */
-        assert(tracemalloc_traced_memory >= trace->size);
-        tracemalloc_traced_memory -= trace->size;
+        size_t old_size = tracemalloc_estimated_size(trace->size);
+        assert(tracemalloc_traced_memory >= old_size);
+        tracemalloc_traced_memory -= old_size;
 
         trace->size = size;
         trace->traceback = traceback;
@@ -563,8 +737,10 @@ tracemalloc_add_trace(unsigned int domain, uintptr_t ptr,
             raw_free(trace);
             return res;
         }
+        trace_filter_add(ptr);
     }
 
+    size = tracemalloc_estimated_size(size);
     assert(tracemalloc_traced_memory <= SIZE_MAX - size);
     tracemalloc_traced_memory += size;
     if (tracemalloc_traced_memory > tracemalloc_peak_traced_memory) {
@@ -668,6 +844,9 @@ tracemalloc_free(void *ctx, void *ptr)
 
     alloc->free(alloc->ctx, ptr);
 
+    if (!tracemalloc_maybe_traced((uintptr_t)ptr)) {
+        return;
+    }
     TABLES_LOCK();
     REMOVE_TRACE(ptr);
     TABLES_UNLOCK();
@@ -677,10 +856,21 @@ tracemalloc_free(void *ctx, void *ptr)
 static void*
 tracemalloc_alloc_gil(int use_calloc, void *ctx, size_t nelem, size_t elsize)
 {
+    PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
     void *ptr;
 
+    /* Draw the sample before checking for a reentrant call, which reads a
+       thread-specific variable: in sampling mode, most memory blocks are
+       small and not sampled, and go straight to the allocator. */
+    int sampled = tracemalloc_sample(&tracemalloc_sampler, nelem * elsize);
+    if (!sampled && nelem * elsize <= UNNESTED_ALLOC_SIZE) {
+        if (use_calloc)
+            return alloc->calloc(alloc->ctx, nelem, elsize);
+        else
+            return alloc->malloc(alloc->ctx, nelem * elsize);
+    }
+
     if (get_reentrant()) {
-        PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
         if (use_calloc)
             return alloc->calloc(alloc->ctx, nelem, elsize);
         else
@@ -689,10 +879,18 @@ tracemalloc_alloc_gil(int use_calloc, void *ctx, size_t nelem, size_t elsize)
 
     /* Ignore reentrant call. PyObjet_Malloc() calls PyMem_Malloc() for
        allocations larger than 512 bytes, don't trace the same memory
-       allocation twice. */
+       allocation twice, even if it is not sampled. */
     set_reentrant(1);
 
-    ptr = tracemalloc_alloc(use_calloc, ctx, nelem, elsize);
+    if (sampled) {
+        ptr = tracemalloc_alloc(use_calloc, ctx, nelem, elsize);
+    }
+    else {
+        if (use_calloc)
+            ptr = alloc->calloc(alloc->ctx, nelem, elsize);
+        else
+            ptr = alloc->malloc(alloc->ctx, nelem * elsize);
+    }
 
     set_reentrant(0);
     return ptr;
@@ -716,17 +914,20 @@ tracemalloc_calloc_gil(void *ctx, size_t nelem, size_t elsize)
 static void*
 tracemalloc_realloc_gil(void *ctx, void *ptr, size_t new_size)
 {
+    PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
     void *ptr2;
 
-    if (get_reentrant()) {
-        /* Reentrant call to PyMem_Realloc() and PyMem_RawRealloc().
+    int sampled = tracemalloc_sample(&tracemalloc_sampler, new_size);
+    if ((!sampled && new_size <= UNNESTED_ALLOC_SIZE) || get_reentrant()) {
+        /* The resized memory block is not sampled, or reentrant call to
+           PyMem_Realloc() and PyMem_RawRealloc().
            Example: PyMem_RawRealloc() is called internally by pymalloc
            (_PyObject_Malloc() and  _PyObject_Realloc()) to allocate a new
            arena (new_arena()). */
-        PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
-
         ptr2 = alloc->realloc(alloc->ctx, ptr, new_size);
-        if (ptr2 != NULL && ptr != NULL) {
+        if (ptr2 != NULL && ptr != NULL
+            && tracemalloc_maybe_traced((uintptr_t)ptr))
+        {
             TABLES_LOCK();
             REMOVE_TRACE(ptr);
             TABLES_UNLOCK();
@@ -736,10 +937,23 @@ tracemalloc_realloc_gil(void *ctx, void *ptr, size_t new_size)
 
     /* Ignore reentrant call. PyObjet_Realloc() calls PyMem_Realloc() for
        allocations larger than 512 bytes. Don't trace the same memory
-       allocation twice. */
+       allocation twice, even if it is not sampled. */
     set_reentrant(1);
 
-    ptr2 = tracemalloc_realloc(ctx, ptr, new_size);
+    if (sampled) {
+        ptr2 = tracemalloc_realloc(ctx, ptr, new_size);
+    }
+    else {
+        /* The resized memory block is not sampled: forget its trace */
+        ptr2 = alloc->realloc(alloc->ctx, ptr, new_size);
+        if (ptr2 != NULL && ptr != NULL
+            && tracemalloc_maybe_traced((uintptr_t)ptr))
+        {
+            TABLES_LOCK();
+            REMOVE_TRACE(ptr);
+            TABLES_UNLOCK();
+        }
+    }
 
     set_reentrant(0);
     return ptr2;
@@ -747,13 +961,26 @@ tracemalloc_realloc_gil(void *ctx, void *ptr, size_t new_size)
 
 
 #ifdef TRACE_RAW_MALLOC
+static int
+tracemalloc_raw_sample(size_t size)
+{
+    if (tracemalloc_sampling_interval == 0) {
+        return 1;
+    }
+    TABLES_LOCK();
+    int sampled = tracemalloc_sample(&tracemalloc_raw_sampler, size);
+    TABLES_UNLOCK();
+    return sampled;
+}
+
+
 static void*
 tracemalloc_raw_alloc(int use_calloc, void *ctx, size_t nelem, size_t elsize)
 {
     PyGILState_STATE gil_state;
     void *ptr;
 
-    if (get_reentrant()) {
+    if (get_reentrant() || !tracemalloc_raw_sample(nelem * elsize)) {
         PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
         if (use_calloc)
             return alloc->calloc(alloc->ctx, nelem, elsize);
@@ -795,13 +1022,16 @@ tracemalloc_raw_realloc(void *ctx, void *ptr, size_t new_size)
     PyGILState_STATE gil_state;
     void *ptr2;
 
-    if (get_reentrant()) {
-        /* Reentrant call to PyMem_RawRealloc(). */
+    if (get_reentrant() || !tracemalloc_raw_sample(new_size)) {
+        /* Reentrant call to PyMem_RawRealloc(), or the new memory block is
+           not sampled. */
         PyMemAllocatorEx *alloc = (PyMemAllocatorEx *)ctx;
 
         ptr2 = alloc->realloc(alloc->ctx, ptr, new_size);
 
-        if (ptr2 != NULL && ptr != NULL) {
+        if (ptr2 != NULL && ptr != NULL
+            && tracemalloc_maybe_traced((uintptr_t)ptr))
+        {
             TABLES_LOCK();
             REMOVE_TRACE(ptr);
             TABLES_UNLOCK();
@@ -844,6 +1074,7 @@ tracemalloc_clear_traces(void)
     _Py_hashtable_clear(tracemalloc_domains);
     tracemalloc_traced_memory = 0;
     tracemalloc_peak_traced_memory = 0;
+    memset(tracemalloc_trace_filter, 0, sizeof(tracemalloc_trace_filter));
     TABLES_UNLOCK();
 
     _Py_hashtable_clear(tracemalloc_tracebacks);
@@ -952,7 +1183,7 @@ tracemalloc_deinit(void)
 
 
 static int
-tracemalloc_start(int max_nframe)
+tracemalloc_start(int max_nframe, Py_ssize_t sampling_interval)
 {
     PyMemAllocatorEx alloc;
     size_t size;
@@ -963,6 +1194,11 @@ tracemalloc_start(int max_nframe)
                      MAX_NFRAME);
         return -1;
     }
+    if (sampling_interval < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the sampling interval must be non-negative");
+        return -1;
+    }
 
     if (tracemalloc_init() < 0) {
         return -1;
@@ -974,6 +1210,9 @@ tracemalloc_start(int max_nframe)
     }
 
     _Py_tracemalloc_config.max_nframe = max_nframe;
+    tracemalloc_sampling_interval = (size_t)sampling_interval;
+    sampler_init(&tracemalloc_sampler, 0x9E3779B97F4A7C15ULL);
+    sampler_init(&tracemalloc_raw_sampler, 0xBF58476D1CE4E5B9ULL);
 
     /* allocate a buffer to store a new traceback */
     size = TRACEBACK_SIZE(max_nframe);
@@ -1144,7 +1383,10 @@ trace_to_pyobject(unsigned int domain, const trace_t *trace,
     PyObject *trace_obj = NULL;
     PyObject *obj;
 
-    trace_obj = PyTuple_New(4);
+    /* In sampling mode, the size of a trace is the estimated size of the
+       memory blocks it stands for, and a fifth item is their estimated
+       number. */
+    trace_obj = PyTuple_New(tracemalloc_sampling_interval ? 5 : 4);
     if (trace_obj == NULL)
         return NULL;
 
@@ -1155,7 +1397,7 @@ trace_to_pyobject(unsigned int domain, const trace_t *trace,
     }
     PyTuple_SET_ITEM(trace_obj, 0, obj);
 
-    obj = PyLong_FromSize_t(trace->size);
+    obj = PyLong_FromSize_t(tracemalloc_estimated_size(trace->size));
     if (obj == NULL) {
         Py_DECREF(trace_obj);
         return NULL;
@@ -1176,6 +1418,15 @@ trace_to_pyobject(unsigned int domain, const trace_t *trace,
     }
     PyTuple_SET_ITEM(trace_obj, 3, obj);
 
+    if (tracemalloc_sampling_interval) {
+        obj = PyLong_FromSize_t(tracemalloc_estimated_count(trace->size));
+        if (obj == NULL) {
+            Py_DECREF(trace_obj);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(trace_obj, 4, obj);
+    }
+
     return trace_obj;
 }
 
@@ -1522,18 +1773,26 @@ _tracemalloc.start
 
     nframe: int = 1
     /
+    *
+    sampling_interval: Py_ssize_t = 0
 
 Start tracing Python memory allocations.
 
 Also set the maximum number of frames stored in the traceback of a
 trace to nframe.
+
+If sampling_interval is greater than zero, only trace a sample of the
+memory blocks: on average, one memory block is traced each time
+sampling_interval bytes are allocated.  Sizes and counts of memory blocks
+are then estimated from the sampled memory blocks.
 [clinic start generated code]*/
 
 static PyObject *
-_tracemalloc_start_impl(PyObject *module, int nframe)
-/*[clinic end generated code: output=caae05c23c159d3c input=40d849b5b29d1933]*/
+_tracemalloc_start_impl(PyObject *module, int nframe,
+                        Py_ssize_t sampling_interval)
+/*[clinic end generated code: output=f521f11b9fa9943e input=9f62a75b9f1e48b8]*/
 {
-    if (tracemalloc_start(nframe) < 0) {
+    if (tracemalloc_start(nframe, sampling_interval) < 0) {
         return NULL;
     }
     Py_RETURN_NONE;
@@ -1586,6 +1845,22 @@ tracemalloc_get_tracemalloc_memory_cb(_Py_hashtable_t *domains,
 }
 
 
+/*[clinic input]
+_tracemalloc.get_sampling_interval -> Py_ssize_t
+
+Get the mean number of bytes allocated between two traced memory blocks.
+
+Return 0 if all the memory blocks are traced.
+[clinic start generated code]*/
+
+static Py_ssize_t
+_tracemalloc_get_sampling_interval_impl(PyObject *module)
+/*[clinic end generated code: output=839ba5ded3f178e1 input=9b19de1efa44c8fe]*/
+{
+    return (Py_ssize_t)tracemalloc_sampling_interval;
+}
+
+
 /*[clinic input]
 _tracemalloc.get_tracemalloc_memory
 
@@ -1672,6 +1947,7 @@ static PyMethodDef module_methods[] = {
     _TRACEMALLOC_START_METHODDEF
     _TRACEMALLOC_STOP_METHODDEF
     _TRACEMALLOC_GET_TRACEBACK_LIMIT_METHODDEF
+    _TRACEMALLOC_GET_SAMPLING_INTERVAL_METHODDEF
     _TRACEMALLOC_GET_TRACEMALLOC_MEMORY_METHODDEF
     _TRACEMALLOC_GET_TRACED_MEMORY_METHODDEF
     _TRACEMALLOC_RESET_PEAK_METHODDEF
@@ -1715,7 +1991,7 @@ _PyTraceMalloc_Init(int nframe)
     if (nframe == 0) {
         return 0;
     }
-    return tracemalloc_start(nframe);
+    return tracemalloc_start(nframe, 0);
 }
 
 
@@ -1741,7 +2017,15 @@ PyTraceMalloc_Track(unsigned int domain, uintptr_t ptr,
     gil_state = PyGILState_Ensure();
 
     TABLES_LOCK();
-    res = tracemalloc_add_trace(domain, ptr, size);
+    if (tracemalloc_sample(&tracemalloc_sampler, size)) {
+        res = tracemalloc_add_trace(domain, ptr, size);
+    }
+    else {
+        /* the memory block is not sampled: forget the previous memory
+           block at the same address */
+        tracemalloc_remove_trace(domain, ptr);
+        res = 0;
+    }
     TABLES_UNLOCK();
 
     PyGILState_Release(gil_state);
@@ -1789,6 +2073,11 @@ _PyTraceMalloc_NewReference(PyObject *op)
         ptr = (uintptr_t)op;
     }
 
+    if (!tracemalloc_maybe_traced(ptr)) {
+        /* the memory block is not sampled */
+        return -1;
+    }
+
     int res = -1;
 
     TABLES_LOCK();
@@ -281,6 +281,186 @@ _sharedexception_apply(_sharedexception *exc, PyObject *wrapperclass)
     }
 }
 
+/* zero-copy buffers */
+
+/* A buffer exported by an object of the interpreter which sent it.  The
+   receiving interpreter gets a memoryview of the same memory: the buffer,
+   and so the exporting object, is released in the sending interpreter once
+   that memoryview is released. */
+typedef struct _sharedbuffer {
+    Py_buffer view;
+    int64_t interp;
+} _sharedbuffer;
+
+static void
+_sharedbuffer_free(void *data)
+{
+    _sharedbuffer *shared = (_sharedbuffer *)data;
+    PyBuffer_Release(&shared->view);
+    PyMem_RawFree(shared);
+}
+
+static void
+_sharedbuffer_release(_sharedbuffer *shared)
+{
+    // Switch to the sending interpreter to release the buffer.  If it was
+    // already destroyed, the buffer is leaked rather than freed under the
+    // memoryviews which may still use it.
+    _PyCrossInterpreterData data = {
+        .data = shared,
+        .interp = shared->interp,
+        .free = _sharedbuffer_free,
+    };
+    _PyCrossInterpreterData_Release(&data);
+}
+
+static PyTypeObject SharedBuffertype;
+
+typedef struct sharedbufferobject {
+    PyObject_HEAD
+    _sharedbuffer *shared;
+} sharedbufferobject;
+
+static void
+sharedbuffer_dealloc(sharedbufferobject *self)
+{
+    if (self->shared != NULL) {
+        PyObject *exc, *value, *tb;
+        PyErr_Fetch(&exc, &value, &tb);
+        _sharedbuffer_release(self->shared);
+        PyErr_Restore(exc, value, tb);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+sharedbuffer_getbuffer(sharedbufferobject *self, Py_buffer *view, int flags)
+{
+    // Follow memory_getbuf(): the shared buffer has no suboffsets.
+    Py_buffer *base = &self->shared->view;
+    if ((flags & PyBUF_WRITABLE) && base->readonly) {
+        PyErr_SetString(PyExc_BufferError, "shared buffer is not writable");
+        return -1;
+    }
+    if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS
+        && !PyBuffer_IsContiguous(base, 'C'))
+    {
+        PyErr_SetString(PyExc_BufferError,
+                        "shared buffer is not C-contiguous");
+        return -1;
+    }
+    if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS
+        && !PyBuffer_IsContiguous(base, 'F'))
+    {
+        PyErr_SetString(PyExc_BufferError,
+                        "shared buffer is not Fortran contiguous");
+        return -1;
+    }
+    if ((flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS
+        && !PyBuffer_IsContiguous(base, 'A'))
+    {
+        PyErr_SetString(PyExc_BufferError,
+                        "shared buffer is not contiguous");
+        return -1;
+    }
+
+    *view = *base;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    if (!(flags & PyBUF_FORMAT)) {
+        view->format = NULL;
+    }
+    if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        if (!PyBuffer_IsContiguous(base, 'C')) {
+            PyErr_SetString(PyExc_BufferError,
+                            "shared buffer is not C-contiguous");
+            return -1;
+        }
+        view->strides = NULL;
+    }
+    if ((flags & PyBUF_ND) != PyBUF_ND) {
+        if (view->format != NULL) {
+            PyErr_SetString(PyExc_BufferError,
+                            "shared buffer: cannot cast to unsigned bytes if "
+                            "the format flag is present");
+            return -1;
+        }
+        view->ndim = 1;
+        view->shape = NULL;
+    }
+
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    return 0;
+}
+
+static PyBufferProcs sharedbuffer_as_buffer = {
+    (getbufferproc)sharedbuffer_getbuffer,  /* bf_getbuffer */
+    0,                                      /* bf_releasebuffer */
+};
+
+static PyTypeObject SharedBuffertype = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    "_xxsubinterpreters._SharedBuffer",     /* tp_name */
+    sizeof(sharedbufferobject),             /* tp_basicsize */
+    0,                                      /* tp_itemsize */
+    (destructor)sharedbuffer_dealloc,       /* tp_dealloc */
+    0,                                      /* tp_vectorcall_offset */
+    0,                                      /* tp_getattr */
+    0,                                      /* tp_setattr */
+    0,                                      /* tp_as_async */
+    0,                                      /* tp_repr */
+    0,                                      /* tp_as_number */
+    0,                                      /* tp_as_sequence */
+    0,                                      /* tp_as_mapping */
+    0,                                      /* tp_hash */
+    0,                                      /* tp_call */
+    0,                                      /* tp_str */
+    0,                                      /* tp_getattro */
+    0,                                      /* tp_setattro */
+    &sharedbuffer_as_buffer,                /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION, /* tp_flags */
+    0,                                      /* tp_doc */
+};
+
+static PyObject *
+_sharedbuffer_from_xid(_PyCrossInterpreterData *data)
+{
+    sharedbufferobject *exporter = PyObject_New(sharedbufferobject,
+                                                &SharedBuffertype);
+    if (exporter == NULL) {
+        return NULL;
+    }
+    // The new object takes over the buffer: releasing the data is a noop.
+    exporter->shared = (_sharedbuffer *)data->data;
+    data->data = NULL;
+
+    PyObject *view = PyMemoryView_FromObject((PyObject *)exporter);
+    Py_DECREF(exporter);
+    return view;
+}
+
+static int
+_buffer_shared(PyObject *obj, _PyCrossInterpreterData *data)
+{
+    _sharedbuffer *shared = PyMem_RawMalloc(sizeof(_sharedbuffer));
+    if (shared == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (PyObject_GetBuffer(obj, &shared->view, PyBUF_RECORDS_RO) < 0) {
+        PyMem_RawFree(shared);
+        return -1;
+    }
+    shared->interp = PyInterpreterState_GetID(_get_current());
+
+    data->data = shared;
+    // data->obj remains NULL: the buffer holds a reference to obj.
+    data->new_object = _sharedbuffer_from_xid;
+    data->free = _sharedbuffer_free;
+    return 0;
+}
+
 
 /* channel-specific code ****************************************************/
 
@@ -293,6 +473,7 @@ static PyObject *ChannelNotFoundError;
 static PyObject *ChannelClosedError;
 static PyObject *ChannelEmptyError;
 static PyObject *ChannelNotEmptyError;
+static PyObject *ChannelFullError;
 
 static int
 channel_exceptions_init(PyObject *ns)
@@ -349,6 +530,16 @@ channel_exceptions_init(PyObject *ns)
         return -1;
     }
 
+    // An operation tried to push to a full bounded channel.
+    ChannelFullError = PyErr_NewException(
+            "_xxsubinterpreters.ChannelFullError", ChannelError, NULL);
+    if (ChannelFullError == NULL) {
+        return -1;
+    }
+    if (PyDict_SetItemString(ns, "ChannelFullError", ChannelFullError) != 0) {
+        return -1;
+    }
+
     return 0;
 }
 
@@ -402,13 +593,13 @@ _channelitem_free_all(_channelitem *item)
     }
 }
 
-static _PyCrossInterpreterData *
+static PyObject *
 _channelitem_popped(_channelitem *item)
 {
-    _PyCrossInterpreterData *data = item->data;
-    item->data = NULL;
+    // Convert the data back to an object.
+    PyObject *obj = _PyCrossInterpreterData_NewObject(item->data);
     _channelitem_free(item);
-    return data;
+    return obj;
 }
 
 typedef struct _channelqueue {
@@ -448,39 +639,74 @@ _channelqueue_free(_channelqueue *queue)
 }
 
 static int
-_channelqueue_put(_channelqueue *queue, _PyCrossInterpreterData *data)
-{
-    _channelitem *item = _channelitem_new();
-    if (item == NULL) {
-        return -1;
+_channelqueue_put(_channelqueue *queue, _PyCrossInterpreterData **items,
+                  Py_ssize_t count)
+{
+    // Allocate all the items first, so that none is added on failure.
+    _channelitem *first = NULL;
+    _channelitem *last = NULL;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        _channelitem *item = _channelitem_new();
+        if (item == NULL) {
+            while (first != NULL) {
+                item = first;
+                first = first->next;
+                PyMem_Free(item);
+            }
+            return -1;
+        }
+        item->data = items[i];
+        if (first == NULL) {
+            first = item;
+        }
+        else {
+            last->next = item;
+        }
+        last = item;
+    }
+    if (first == NULL) {
+        return 0;
     }
-    item->data = data;
 
-    queue->count += 1;
+    queue->count += count;
     if (queue->first == NULL) {
-        queue->first = item;
+        queue->first = first;
     }
     else {
-        queue->last->next = item;
+        queue->last->next = first;
     }
-    queue->last = item;
+    queue->last = last;
     return 0;
 }
 
-static _PyCrossInterpreterData *
-_channelqueue_get(_channelqueue *queue)
+/* Unlink up to maxcount items from the front of the queue and return the
+   first one, or NULL if the queue is empty. */
+static _channelitem *
+_channelqueue_get(_channelqueue *queue, Py_ssize_t maxcount,
+                  Py_ssize_t *pcount)
 {
-    _channelitem *item = queue->first;
-    if (item == NULL) {
+    _channelitem *first = queue->first;
+    _channelitem *last = NULL;
+    Py_ssize_t count = 0;
+    for (_channelitem *item = first;
+         item != NULL && count < maxcount;
+         item = item->next)
+    {
+        last = item;
+        count++;
+    }
+    *pcount = count;
+    if (last == NULL) {
         return NULL;
     }
-    queue->first = item->next;
-    if (queue->last == item) {
+    queue->first = last->next;
+    if (queue->last == last) {
         queue->last = NULL;
     }
-    queue->count -= 1;
+    last->next = NULL;
+    queue->count -= count;
 
-    return _channelitem_popped(item);
+    return first;
 }
 
 /* channel-interpreter associations */
@@ -708,6 +934,56 @@ _channelends_close_all(_channelends *ends, int which, int force)
 
 /* channels */
 
+/* wakeups of the threads blocked on a channel */
+
+/* The lock is held while there is nothing new for the waiting threads.
+   A thread waits by acquiring it; the channel wakes one thread up by
+   releasing it, and that thread passes the wakeup on if there is still
+   something for the others.  "locked" is protected by the channel's mutex:
+   it is only set by a waiter once it holds the lock, so a thread which
+   acquired the lock but has not set it yet checks the channel again. */
+typedef struct _channelsignal {
+    PyThread_type_lock lock;
+    int locked;
+} _channelsignal;
+
+static int
+_channelsignal_init(_channelsignal *signal)
+{
+    signal->lock = PyThread_allocate_lock();
+    if (signal->lock == NULL) {
+        PyErr_SetString(ChannelError,
+                        "can't initialize lock for new channel");
+        return -1;
+    }
+    signal->locked = 0;
+    return 0;
+}
+
+static void
+_channelsignal_fini(_channelsignal *signal)
+{
+    if (signal->lock != NULL) {
+        // Unlock the lock so it's safe to free it.
+        if (signal->locked) {
+            PyThread_release_lock(signal->lock);
+        }
+        PyThread_free_lock(signal->lock);
+        signal->lock = NULL;
+    }
+}
+
+static void
+_channelsignal_notify(_channelsignal *signal)  // needs the channel's mutex
+{
+    if (signal->locked) {
+        signal->locked = 0;
+        PyThread_release_lock(signal->lock);
+    }
+}
+
+/* the channel */
+
 struct _channel;
 struct _channel_closing;
 static void _channel_clear_closing(struct _channel *);
@@ -719,10 +995,32 @@ typedef struct _channel {
     _channelends *ends;
     int open;
     struct _channel_closing *closing;
+    // The maximum number of queued items, or 0 if unbounded.
+    int64_t maxsize;
+    _channelsignal not_empty;
+    _channelsignal not_full;
+    // The number of threads blocked in _channel_wait(), which the last
+    // one frees the channel if it was freed meanwhile.
+    Py_ssize_t waiting;
+    int freed;
 } _PyChannelState;
 
+static void
+_channel_dealloc(_PyChannelState *chan)
+{
+    PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
+    _channelqueue_free(chan->queue);
+    _channelends_free(chan->ends);
+    PyThread_release_lock(chan->mutex);
+
+    _channelsignal_fini(&chan->not_empty);
+    _channelsignal_fini(&chan->not_full);
+    PyThread_free_lock(chan->mutex);
+    PyMem_Free(chan);
+}
+
 static _PyChannelState *
-_channel_new(void)
+_channel_new(int64_t maxsize)
 {
     _PyChannelState *chan = PyMem_NEW(_PyChannelState, 1);
     if (chan == NULL) {
@@ -737,17 +1035,30 @@ _channel_new(void)
     }
     chan->queue = _channelqueue_new();
     if (chan->queue == NULL) {
+        PyThread_free_lock(chan->mutex);
         PyMem_Free(chan);
         return NULL;
     }
     chan->ends = _channelends_new();
     if (chan->ends == NULL) {
         _channelqueue_free(chan->queue);
+        PyThread_free_lock(chan->mutex);
         PyMem_Free(chan);
         return NULL;
     }
     chan->open = 1;
     chan->closing = NULL;
+    chan->maxsize = maxsize;
+    chan->not_empty.lock = NULL;
+    chan->not_full.lock = NULL;
+    chan->waiting = 0;
+    chan->freed = 0;
+    if (_channelsignal_init(&chan->not_empty) != 0
+        || _channelsignal_init(&chan->not_full) != 0)
+    {
+        _channel_dealloc(chan);
+        return NULL;
+    }
     return chan;
 }
 
@@ -756,17 +1067,31 @@ _channel_free(_PyChannelState *chan)
 {
     _channel_clear_closing(chan);
     PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
-    _channelqueue_free(chan->queue);
-    _channelends_free(chan->ends);
+    if (chan->waiting > 0) {
+        // The blocked threads still use the channel: wake them up, the
+        // last one frees it.
+        chan->open = 0;
+        chan->freed = 1;
+        _channelsignal_notify(&chan->not_empty);
+        _channelsignal_notify(&chan->not_full);
+        PyThread_release_lock(chan->mutex);
+        return;
+    }
     PyThread_release_lock(chan->mutex);
+    _channel_dealloc(chan);
+}
 
-    PyThread_free_lock(chan->mutex);
-    PyMem_Free(chan);
+static int
+_channel_has_room(_PyChannelState *chan, Py_ssize_t count)  // needs mutex
+{
+    return chan->maxsize == 0 || chan->queue->count + count <= chan->maxsize;
 }
 
+/* Add the items to the channel, all or none of them.  Return 1 if there is
+   no room for them yet in a bounded channel. */
 static int
 _channel_add(_PyChannelState *chan, int64_t interp,
-             _PyCrossInterpreterData *data)
+             _PyCrossInterpreterData **items, Py_ssize_t count)
 {
     int res = -1;
     PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
@@ -775,13 +1100,28 @@ _channel_add(_PyChannelState *chan, int64_t interp,
         PyErr_SetString(ChannelClosedError, "channel closed");
         goto done;
     }
+    if (chan->maxsize != 0 && count > chan->maxsize) {
+        PyErr_Format(PyExc_ValueError,
+                     "can't send %zd objects to a channel of maxsize %" PRId64,
+                     count, chan->maxsize);
+        goto done;
+    }
     if (_channelends_associate(chan->ends, interp, 1) != 0) {
         goto done;
     }
 
-    if (_channelqueue_put(chan->queue, data) != 0) {
+    if (!_channel_has_room(chan, count)) {
+        res = 1;
+        goto done;
+    }
+    if (_channelqueue_put(chan->queue, items, count) != 0) {
         goto done;
     }
+    _channelsignal_notify(&chan->not_empty);
+    if (_channel_has_room(chan, 1)) {
+        // Pass the wakeup on to the other senders.
+        _channelsignal_notify(&chan->not_full);
+    }
 
     res = 0;
 done:
@@ -789,10 +1129,14 @@ _channel_add(_PyChannelState *chan, int64_t interp,
     return res;
 }
 
-static _PyCrossInterpreterData *
-_channel_next(_PyChannelState *chan, int64_t interp)
+/* Pop up to maxcount items off the channel into *pitems.  Return the number
+   of items, which is 0 if the channel is empty, or -1 on error.  The channel
+   is freed if it was closing and is now empty. */
+static Py_ssize_t
+_channel_next(_PyChannelState *chan, int64_t interp, Py_ssize_t maxcount,
+              _channelitem **pitems)
 {
-    _PyCrossInterpreterData *data = NULL;
+    Py_ssize_t count = -1;
     PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
 
     if (!chan->open) {
@@ -803,17 +1147,24 @@ _channel_next(_PyChannelState *chan, int64_t interp)
         goto done;
     }
 
-    data = _channelqueue_get(chan->queue);
-    if (data == NULL && !PyErr_Occurred() && chan->closing != NULL) {
+    *pitems = _channelqueue_get(chan->queue, maxcount, &count);
+    if (count == 0 && chan->closing != NULL) {
         chan->open = 0;
     }
+    if (count > 0) {
+        _channelsignal_notify(&chan->not_full);
+    }
+    if (chan->queue->count > 0) {
+        // Pass the wakeup on to the other receivers.
+        _channelsignal_notify(&chan->not_empty);
+    }
 
 done:
     PyThread_release_lock(chan->mutex);
     if (chan->queue->count == 0) {
         _channel_finish_closing(chan);
     }
-    return data;
+    return count;
 }
 
 static int
@@ -831,6 +1182,10 @@ _channel_close_interpreter(_PyChannelState *chan, int64_t interp, int end)
         goto done;
     }
     chan->open = _channelends_is_open(chan->ends);
+    if (!chan->open) {
+        _channelsignal_notify(&chan->not_empty);
+        _channelsignal_notify(&chan->not_full);
+    }
 
     res = 0;
 done:
@@ -856,6 +1211,8 @@ _channel_close_all(_PyChannelState *chan, int end, int force)
     }
 
     chan->open = 0;
+    _channelsignal_notify(&chan->not_empty);
+    _channelsignal_notify(&chan->not_full);
 
     // We *could* also just leave these in place, since we've marked
     // the channel as closed already.
@@ -1257,9 +1614,9 @@ _channel_finish_closing(struct _channel *chan) {
 /* "high"-level channel-related functions */
 
 static int64_t
-_channel_create(_channels *channels)
+_channel_create(_channels *channels, int64_t maxsize)
 {
-    _PyChannelState *chan = _channel_new();
+    _PyChannelState *chan = _channel_new(maxsize);
     if (chan == NULL) {
         return -1;
     }
@@ -1284,8 +1641,78 @@ _channel_destroy(_channels *channels, int64_t id)
     return 0;
 }
 
+/* Block until the signal is notified or the deadline passes (a negative
+   deadline means none).  The caller holds the channels mutex: it is
+   released while waiting and held again on return.  Return 1 if the caller
+   must check the channel again, 0 if it must not wait (block is false or
+   the deadline passed), or -1 on error, in which case the channel may have
+   been freed. */
 static int
-_channel_send(_channels *channels, int64_t id, PyObject *obj)
+_channel_wait(_PyChannelState *chan, _channelsignal *signal,
+              PyThread_type_lock mutex, int block, _PyTime_t deadline)
+{
+    if (!block) {
+        return 0;
+    }
+    PY_TIMEOUT_T microseconds = -1;
+    if (deadline >= 0) {
+        _PyTime_t timeout = _PyDeadline_Get(deadline);
+        if (timeout <= 0) {
+            return 0;
+        }
+        microseconds = _PyTime_AsMicroseconds(timeout, _PyTime_ROUND_CEILING);
+        if (microseconds > PY_TIMEOUT_MAX) {
+            PyErr_SetString(PyExc_OverflowError,
+                            "timeout value is too large");
+            return -1;
+        }
+    }
+
+    PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
+    chan->waiting += 1;
+    PyThread_release_lock(chan->mutex);
+    PyThread_release_lock(mutex);
+
+    PyLockStatus r;
+    Py_BEGIN_ALLOW_THREADS
+    r = PyThread_acquire_lock_timed(signal->lock, microseconds, 1);
+    Py_END_ALLOW_THREADS
+    int res = 1;
+    if (r == PY_LOCK_INTR && Py_MakePendingCalls() < 0) {
+        res = -1;
+    }
+
+    PyThread_acquire_lock(mutex, WAIT_LOCK);
+    PyThread_acquire_lock(chan->mutex, WAIT_LOCK);
+    if (r == PY_LOCK_ACQUIRED) {
+        signal->locked = 1;
+    }
+    chan->waiting -= 1;
+    if (chan->freed) {
+        int last = (chan->waiting == 0);
+        if (!last) {
+            // Pass the wakeup on to the other blocked threads.
+            _channelsignal_notify(&chan->not_empty);
+            _channelsignal_notify(&chan->not_full);
+        }
+        PyThread_release_lock(chan->mutex);
+        if (last) {
+            _channel_dealloc(chan);
+        }
+        if (res > 0) {
+            PyErr_SetString(ChannelClosedError, "channel closed");
+        }
+        return -1;
+    }
+    PyThread_release_lock(chan->mutex);
+    return res;
+}
+
+/* Send all the objects to the channel at once.  If the channel is bounded
+   and there is no room for them, wait for it if block is true. */
+static int
+_channel_send(_channels *channels, int64_t id, PyObject **objs,
+              Py_ssize_t count, int block, _PyTime_t deadline)
 {
     PyInterpreterState *interp = _get_current();
     if (interp == NULL) {
@@ -1306,62 +1733,97 @@ _channel_send(_channels *channels, int64_t id, PyObject *obj)
         return -1;
     }
 
-    // Convert the object to cross-interpreter data.
-    _PyCrossInterpreterData *data = PyMem_NEW(_PyCrossInterpreterData, 1);
-    if (data == NULL) {
+    // Convert the objects to cross-interpreter data.
+    _PyCrossInterpreterData **items = PyMem_NEW(_PyCrossInterpreterData *,
+                                                count);
+    if (items == NULL) {
         PyThread_release_lock(mutex);
+        PyErr_NoMemory();
         return -1;
     }
-    if (_PyObject_GetCrossInterpreterData(obj, data) != 0) {
-        PyThread_release_lock(mutex);
-        PyMem_Free(data);
-        return -1;
+    Py_ssize_t converted = 0;
+    int res = -1;
+    for (; converted < count; converted++) {
+        _PyCrossInterpreterData *data = PyMem_NEW(_PyCrossInterpreterData, 1);
+        if (data == NULL) {
+            PyErr_NoMemory();
+            goto done;
+        }
+        if (_PyObject_GetCrossInterpreterData(objs[converted], data) != 0) {
+            PyMem_Free(data);
+            goto done;
+        }
+        items[converted] = data;
+    }
+
+    // Add the data to the channel, waiting for room if it is full.
+    int64_t interpid = PyInterpreterState_GetID(interp);
+    while ((res = _channel_add(chan, interpid, items, count)) == 1) {
+        res = _channel_wait(chan, &chan->not_full, mutex, block, deadline);
+        if (res == 0) {
+            PyErr_Format(ChannelFullError, "channel %" PRId64 " is full", id);
+            res = -1;
+        }
+        if (res < 0) {
+            break;
+        }
+        if (chan->closing != NULL) {
+            PyErr_Format(ChannelClosedError, "channel %" PRId64 " closed", id);
+            res = -1;
+            break;
+        }
     }
 
-    // Add the data to the channel.
-    int res = _channel_add(chan, PyInterpreterState_GetID(interp), data);
+done:
     PyThread_release_lock(mutex);
     if (res != 0) {
-        _PyCrossInterpreterData_Release(data);
-        PyMem_Free(data);
-        return -1;
+        for (Py_ssize_t i = 0; i < converted; i++) {
+            _PyCrossInterpreterData_Release(items[i]);
+            PyMem_Free(items[i]);
+        }
     }
-
-    return 0;
+    PyMem_Free(items);
+    return res;
 }
 
-static PyObject *
-_channel_recv(_channels *channels, int64_t id)
+/* Pop up to maxcount items off the channel.  If it is empty, wait for an
+   item if block is true.  Return the number of items, or -1 on error. */
+static Py_ssize_t
+_channel_recv(_channels *channels, int64_t id, Py_ssize_t maxcount,
+              int block, _PyTime_t deadline, _channelitem **pitems)
 {
     PyInterpreterState *interp = _get_current();
     if (interp == NULL) {
-        return NULL;
+        return -1;
     }
 
     // Look up the channel.
     PyThread_type_lock mutex = NULL;
     _PyChannelState *chan = _channels_lookup(channels, id, &mutex);
     if (chan == NULL) {
-        return NULL;
+        return -1;
     }
     // Past this point we are responsible for releasing the mutex.
 
-    // Pop off the next item from the channel.
-    _PyCrossInterpreterData *data = _channel_next(chan, PyInterpreterState_GetID(interp));
-    PyThread_release_lock(mutex);
-    if (data == NULL) {
-        return NULL;
-    }
-
-    // Convert the data back to an object.
-    PyObject *obj = _PyCrossInterpreterData_NewObject(data);
-    _PyCrossInterpreterData_Release(data);
-    PyMem_Free(data);
-    if (obj == NULL) {
-        return NULL;
+    // Pop off the next items from the channel.
+    int64_t interpid = PyInterpreterState_GetID(interp);
+    Py_ssize_t count;
+    while (1) {
+        // An empty closing channel is freed by _channel_next().
+        int closing = (chan->closing != NULL);
+        count = _channel_next(chan, interpid, maxcount, pitems);
+        if (count != 0 || closing) {
+            break;
+        }
+        int res = _channel_wait(chan, &chan->not_empty, mutex, block,
+                                deadline);
+        if (res <= 0) {
+            count = res;
+            break;
+        }
     }
-
-    return obj;
+    PyThread_release_lock(mutex);
+    return count;
 }
 
 static int
@@ -1936,17 +2398,17 @@ _run_script_in_interpreter(PyInterpreterState *interp, const char *codestr,
     }
 
 #ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
-    // Switch to interpreter.
+    // Switch to interpreter: take its own GIL.
     PyThreadState *new_tstate = PyInterpreterState_ThreadHead(interp);
     PyThreadState *save1 = PyEval_SaveThread();
-
-    (void)PyThreadState_Swap(new_tstate);
+    PyEval_RestoreThread(new_tstate);
 
     // Run the script.
     _sharedexception *exc = NULL;
     int result = _run_script(interp, codestr, shared, &exc);
 
     // Switch back.
+    PyEval_SaveThread();
     PyEval_RestoreThread(save1);
 #else
     // Switch to interpreter.
@@ -2009,6 +2471,26 @@ _global_channels(void) {
     return &_globals.channels;
 }
 
+// Finalize an interpreter from a thread running another interpreter.
+static void
+_end_interpreter(PyThreadState *tstate)
+{
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    // Take the GIL of the interpreter.
+    PyThreadState *save_tstate = PyEval_SaveThread();
+    PyEval_RestoreThread(tstate);
+    Py_EndInterpreter(tstate);
+    // The thread state was deleted with the interpreter.
+    PyThreadState_Swap(NULL);
+    PyEval_RestoreThread(save_tstate);
+#else
+    // XXX Possible GILState issues?
+    PyThreadState *save_tstate = PyThreadState_Swap(tstate);
+    Py_EndInterpreter(tstate);
+    PyThreadState_Swap(save_tstate);
+#endif
+}
+
 static PyObject *
 interp_create(PyObject *self, PyObject *args, PyObject *kwds)
 {
@@ -2024,6 +2506,12 @@ interp_create(PyObject *self, PyObject *args, PyObject *kwds)
     PyThreadState *save_tstate = _PyThreadState_GET();
     // XXX Possible GILState issues?
     PyThreadState *tstate = _Py_NewInterpreter(isolated);
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (tstate != NULL) {
+        // Release the GIL of the new interpreter: run_string() takes it.
+        PyEval_SaveThread();
+    }
+#endif
     PyThreadState_Swap(save_tstate);
     if (tstate == NULL) {
         /* Since no new thread state was created, there is no exception to
@@ -2035,10 +2523,7 @@ interp_create(PyObject *self, PyObject *args, PyObject *kwds)
     PyInterpreterState *interp = PyThreadState_GetInterpreter(tstate);
     PyObject *idobj = _PyInterpreterState_GetIDObject(interp);
     if (idobj == NULL) {
-        // XXX Possible GILState issues?
-        save_tstate = PyThreadState_Swap(tstate);
-        Py_EndInterpreter(tstate);
-        PyThreadState_Swap(save_tstate);
+        _end_interpreter(tstate);
         return NULL;
     }
     _PyInterpreterState_RequireIDRef(interp, 1);
@@ -2087,11 +2572,7 @@ interp_destroy(PyObject *self, PyObject *args, PyObject *kwds)
     }
 
     // Destroy the interpreter.
-    PyThreadState *tstate = PyInterpreterState_ThreadHead(interp);
-    // XXX Possible GILState issues?
-    PyThreadState *save_tstate = PyThreadState_Swap(tstate);
-    Py_EndInterpreter(tstate);
-    PyThreadState_Swap(save_tstate);
+    _end_interpreter(PyInterpreterState_ThreadHead(interp));
 
     Py_RETURN_NONE;
 }
@@ -2271,10 +2752,44 @@ PyDoc_STRVAR(is_running_doc,
 \n\
 Return whether or not the identified interpreter is running.");
 
+/* Convert a timeout, None or a number of seconds, to a deadline for
+   _channel_wait(): -1 if there is none. */
+static int
+_get_deadline(PyObject *timeout_obj, _PyTime_t *pdeadline)
+{
+    if (timeout_obj == Py_None) {
+        *pdeadline = -1;
+        return 0;
+    }
+    _PyTime_t timeout;
+    if (_PyTime_FromSecondsObject(&timeout,
+                                  timeout_obj, _PyTime_ROUND_CEILING) < 0) {
+        return -1;
+    }
+    if (timeout < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "'timeout' must be a non-negative number");
+        return -1;
+    }
+    *pdeadline = _PyDeadline_Init(timeout);
+    return 0;
+}
+
 static PyObject *
-channel_create(PyObject *self, PyObject *Py_UNUSED(ignored))
+channel_create(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    int64_t cid = _channel_create(&_globals.channels);
+    static char *kwlist[] = {"maxsize", NULL};
+    int64_t maxsize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|L:channel_create", kwlist,
+                                     &maxsize)) {
+        return NULL;
+    }
+    if (maxsize < 0) {
+        PyErr_SetString(PyExc_ValueError, "maxsize must be >= 0");
+        return NULL;
+    }
+
+    int64_t cid = _channel_create(&_globals.channels, maxsize);
     if (cid < 0) {
         return NULL;
     }
@@ -2291,9 +2806,12 @@ channel_create(PyObject *self, PyObject *Py_UNUSED(ignored))
 }
 
 PyDoc_STRVAR(channel_create_doc,
-"channel_create() -> cid\n\
+"channel_create(maxsize=0) -> cid\n\
+\n\
+Create a new cross-interpreter channel and return a unique generated ID.\n\
 \n\
-Create a new cross-interpreter channel and return a unique generated ID.");
+If maxsize is greater than zero, the channel holds at most maxsize\n\
+objects: sending more blocks until they are received.");
 
 static PyObject *
 channel_destroy(PyObject *self, PyObject *args, PyObject *kwds)
@@ -2419,42 +2937,108 @@ receive end.");
 static PyObject *
 channel_send(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"cid", "obj", NULL};
+    static char *kwlist[] = {"cid", "obj", "block", "timeout", NULL};
     int64_t cid;
     PyObject *obj;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&O:channel_send", kwlist,
-                                     channel_id_converter, &cid, &obj)) {
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+    _PyTime_t deadline;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&O|$pO:channel_send",
+                                     kwlist, channel_id_converter, &cid, &obj,
+                                     &block, &timeout_obj)) {
+        return NULL;
+    }
+    if (_get_deadline(timeout_obj, &deadline) < 0) {
         return NULL;
     }
 
-    if (_channel_send(&_globals.channels, cid, obj) != 0) {
+    if (_channel_send(&_globals.channels, cid, &obj, 1, block, deadline) != 0) {
         return NULL;
     }
     Py_RETURN_NONE;
 }
 
 PyDoc_STRVAR(channel_send_doc,
-"channel_send(cid, obj)\n\
+"channel_send(cid, obj, *, block=True, timeout=None)\n\
+\n\
+Add the object's data to the channel's queue.\n\
+\n\
+If the channel is full, block until there is room for the object, or\n\
+for at most timeout seconds.  If block is False, or once the timeout\n\
+expires, raise ChannelFullError instead.\n\
+\n\
+bytes and str objects are copied.  The memory of a memoryview or a\n\
+PickleBuffer is shared instead: the receiving interpreter gets a\n\
+memoryview of it, and the object is released once that memoryview\n\
+is released.");
+
+static PyObject *
+channel_send_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"cid", "objs", "block", "timeout", NULL};
+    int64_t cid;
+    PyObject *objs;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+    _PyTime_t deadline;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&O|$pO:channel_send_many",
+                                     kwlist, channel_id_converter, &cid, &objs,
+                                     &block, &timeout_obj)) {
+        return NULL;
+    }
+    if (_get_deadline(timeout_obj, &deadline) < 0) {
+        return NULL;
+    }
+    PyObject *seq = PySequence_Fast(objs, "objs must be iterable");
+    if (seq == NULL) {
+        return NULL;
+    }
+
+    int res = _channel_send(&_globals.channels, cid,
+                            PySequence_Fast_ITEMS(seq),
+                            PySequence_Fast_GET_SIZE(seq), block, deadline);
+    Py_DECREF(seq);
+    if (res != 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(channel_send_many_doc,
+"channel_send_many(cid, objs, *, block=True, timeout=None)\n\
 \n\
-Add the object's data to the channel's queue.");
+Add the data of all the objects to the channel's queue at once.\n\
+\n\
+This is the same as calling channel_send() for each object, except\n\
+that either all of the objects or none of them are sent.  If the\n\
+channel is full, block until there is room for all of them.");
 
 static PyObject *
 channel_recv(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"cid", "default", NULL};
+    static char *kwlist[] = {"cid", "default", "block", "timeout", NULL};
     int64_t cid;
     PyObject *dflt = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|O:channel_recv", kwlist,
-                                     channel_id_converter, &cid, &dflt)) {
+    int block = 0;
+    PyObject *timeout_obj = Py_None;
+    _PyTime_t deadline;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|O$pO:channel_recv",
+                                     kwlist, channel_id_converter, &cid, &dflt,
+                                     &block, &timeout_obj)) {
+        return NULL;
+    }
+    if (_get_deadline(timeout_obj, &deadline) < 0) {
         return NULL;
     }
     Py_XINCREF(dflt);
 
-    PyObject *obj = _channel_recv(&_globals.channels, cid);
-    if (obj != NULL) {
+    _channelitem *item = NULL;
+    Py_ssize_t count = _channel_recv(&_globals.channels, cid, 1,
+                                     block, deadline, &item);
+    if (count > 0) {
         Py_XDECREF(dflt);
-        return obj;
-    } else if (PyErr_Occurred()) {
+        return _channelitem_popped(item);
+    } else if (count < 0) {
         Py_XDECREF(dflt);
         return NULL;
     } else if (dflt != NULL) {
@@ -2466,12 +3050,76 @@ channel_recv(PyObject *self, PyObject *args, PyObject *kwds)
 }
 
 PyDoc_STRVAR(channel_recv_doc,
-"channel_recv(cid, [default]) -> obj\n\
+"channel_recv(cid, [default], *, block=False, timeout=None) -> obj\n\
 \n\
 Return a new object from the data at the front of the channel's queue.\n\
 \n\
-If there is nothing to receive then raise ChannelEmptyError, unless\n\
-a default value is provided.  In that case return it.");
+If there is nothing to receive and block is True, wait until an object\n\
+is sent, or for at most timeout seconds.  If there is still nothing to\n\
+receive then raise ChannelEmptyError, unless a default value is\n\
+provided.  In that case return it.");
+
+static PyObject *
+channel_recv_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"cid", "maxcount", "block", "timeout", NULL};
+    int64_t cid;
+    Py_ssize_t maxcount;
+    int block = 0;
+    PyObject *timeout_obj = Py_None;
+    _PyTime_t deadline;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&n|$pO:channel_recv_many",
+                                     kwlist, channel_id_converter, &cid,
+                                     &maxcount, &block, &timeout_obj)) {
+        return NULL;
+    }
+    if (maxcount <= 0) {
+        PyErr_SetString(PyExc_ValueError, "maxcount must be > 0");
+        return NULL;
+    }
+    if (_get_deadline(timeout_obj, &deadline) < 0) {
+        return NULL;
+    }
+
+    _channelitem *items = NULL;
+    Py_ssize_t count = _channel_recv(&_globals.channels, cid, maxcount,
+                                     block, deadline, &items);
+    if (count < 0) {
+        return NULL;
+    }
+    if (count == 0) {
+        PyErr_Format(ChannelEmptyError, "channel %" PRId64 " is empty", cid);
+        return NULL;
+    }
+
+    PyObject *list = PyList_New(count);
+    if (list == NULL) {
+        _channelitem_free_all(items);
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < count; i++) {
+        _channelitem *item = items;
+        items = items->next;
+        PyObject *obj = _channelitem_popped(item);
+        if (obj == NULL) {
+            _channelitem_free_all(items);
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, obj);
+    }
+    return list;
+}
+
+PyDoc_STRVAR(channel_recv_many_doc,
+"channel_recv_many(cid, maxcount, *, block=False, timeout=None) -> list\n\
+\n\
+Return a list of new objects from the data at the front of the\n\
+channel's queue, at most maxcount of them.\n\
+\n\
+If there is nothing to receive and block is True, wait until an object\n\
+is sent, or for at most timeout seconds.  If there is still nothing to\n\
+receive then raise ChannelEmptyError.");
 
 static PyObject *
 channel_close(PyObject *self, PyObject *args, PyObject *kwds)
@@ -2580,8 +3228,8 @@ static PyMethodDef module_functions[] = {
     {"is_shareable",              (PyCFunction)(void(*)(void))object_is_shareable,
      METH_VARARGS | METH_KEYWORDS, is_shareable_doc},
 
-    {"channel_create",            channel_create,
-     METH_NOARGS, channel_create_doc},
+    {"channel_create",            (PyCFunction)(void(*)(void))channel_create,
+     METH_VARARGS | METH_KEYWORDS, channel_create_doc},
     {"channel_destroy",           (PyCFunction)(void(*)(void))channel_destroy,
      METH_VARARGS | METH_KEYWORDS, channel_destroy_doc},
     {"channel_list_all",          channel_list_all,
@@ -2590,8 +3238,12 @@ static PyMethodDef module_functions[] = {
      METH_VARARGS | METH_KEYWORDS, channel_list_interpreters_doc},
     {"channel_send",              (PyCFunction)(void(*)(void))channel_send,
      METH_VARARGS | METH_KEYWORDS, channel_send_doc},
+    {"channel_send_many",         (PyCFunction)(void(*)(void))channel_send_many,
+     METH_VARARGS | METH_KEYWORDS, channel_send_many_doc},
     {"channel_recv",              (PyCFunction)(void(*)(void))channel_recv,
      METH_VARARGS | METH_KEYWORDS, channel_recv_doc},
+    {"channel_recv_many",         (PyCFunction)(void(*)(void))channel_recv_many,
+     METH_VARARGS | METH_KEYWORDS, channel_recv_many_doc},
     {"channel_close",             (PyCFunction)(void(*)(void))channel_close,
      METH_VARARGS | METH_KEYWORDS, channel_close_doc},
     {"channel_release",           (PyCFunction)(void(*)(void))channel_release,
@@ -2633,6 +3285,9 @@ PyInit__xxsubinterpreters(void)
     if (PyType_Ready(&ChannelIDtype) != 0) {
         return NULL;
     }
+    if (PyType_Ready(&SharedBuffertype) != 0) {
+        return NULL;
+    }
 
     /* Create the module */
     PyObject *module = PyModule_Create(&interpretersmodule);
@@ -2662,6 +3317,12 @@ PyInit__xxsubinterpreters(void)
     if (_PyCrossInterpreterData_RegisterClass(&ChannelIDtype, _channelid_shared)) {
         return NULL;
     }
+    if (_PyCrossInterpreterData_RegisterClass(&PyMemoryView_Type, _buffer_shared)) {
+        return NULL;
+    }
+    if (_PyCrossInterpreterData_RegisterClass(&PyPickleBuffer_Type, _buffer_shared)) {
+        return NULL;
+    }
 
     return module;
 }
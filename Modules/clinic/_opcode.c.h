@@ -74,4 +74,116 @@ _opcode_get_specialization_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
 {
     return _opcode_get_specialization_stats_impl(module);
 }
-/*[clinic end generated code: output=1699b4b1488b49c1 input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(_opcode_enable_profile__doc__,
+"enable_profile($module, /)\n"
+"--\n"
+"\n"
+"Enable the runtime opcode profile.\n"
+"\n"
+"While the profile is enabled, the interpreter samples the misses of the\n"
+"specialized instructions: it takes a sample each time a specialized\n"
+"instruction has missed often enough to be deoptimized, and records why\n"
+"the instruction could not be specialized again.");
+
+#define _OPCODE_ENABLE_PROFILE_METHODDEF    \
+    {"enable_profile", (PyCFunction)_opcode_enable_profile, METH_NOARGS, _opcode_enable_profile__doc__},
+
+static PyObject *
+_opcode_enable_profile_impl(PyObject *module);
+
+static PyObject *
+_opcode_enable_profile(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _opcode_enable_profile_impl(module);
+}
+
+PyDoc_STRVAR(_opcode_disable_profile__doc__,
+"disable_profile($module, /)\n"
+"--\n"
+"\n"
+"Disable the runtime opcode profile, keeping the recorded samples.");
+
+#define _OPCODE_DISABLE_PROFILE_METHODDEF    \
+    {"disable_profile", (PyCFunction)_opcode_disable_profile, METH_NOARGS, _opcode_disable_profile__doc__},
+
+static PyObject *
+_opcode_disable_profile_impl(PyObject *module);
+
+static PyObject *
+_opcode_disable_profile(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _opcode_disable_profile_impl(module);
+}
+
+PyDoc_STRVAR(_opcode_is_profile_enabled__doc__,
+"is_profile_enabled($module, /)\n"
+"--\n"
+"\n"
+"Return True if the runtime opcode profile is enabled.");
+
+#define _OPCODE_IS_PROFILE_ENABLED_METHODDEF    \
+    {"is_profile_enabled", (PyCFunction)_opcode_is_profile_enabled, METH_NOARGS, _opcode_is_profile_enabled__doc__},
+
+static int
+_opcode_is_profile_enabled_impl(PyObject *module);
+
+static PyObject *
+_opcode_is_profile_enabled(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = _opcode_is_profile_enabled_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyBool_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_opcode_get_profile__doc__,
+"get_profile($module, /)\n"
+"--\n"
+"\n"
+"Return the samples of the runtime opcode profile.\n"
+"\n"
+"The profile is a dict mapping (code, offset, opcode, reason) tuples to a\n"
+"number of samples.  offset is the offset of the instruction in bytes and\n"
+"opcode is the specialized opcode that missed; each sample stands for\n"
+"about 50 misses.  reason is the kind of the failure of the next attempt\n"
+"to specialize the instruction, as counted by the specialization stats,\n"
+"or None if the instruction has been specialized again or not tried yet.");
+
+#define _OPCODE_GET_PROFILE_METHODDEF    \
+    {"get_profile", (PyCFunction)_opcode_get_profile, METH_NOARGS, _opcode_get_profile__doc__},
+
+static PyObject *
+_opcode_get_profile_impl(PyObject *module);
+
+static PyObject *
+_opcode_get_profile(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _opcode_get_profile_impl(module);
+}
+
+PyDoc_STRVAR(_opcode_reset_profile__doc__,
+"reset_profile($module, /)\n"
+"--\n"
+"\n"
+"Discard the samples of the runtime opcode profile.");
+
+#define _OPCODE_RESET_PROFILE_METHODDEF    \
+    {"reset_profile", (PyCFunction)_opcode_reset_profile, METH_NOARGS, _opcode_reset_profile__doc__},
+
+static PyObject *
+_opcode_reset_profile_impl(PyObject *module);
+
+static PyObject *
+_opcode_reset_profile(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _opcode_reset_profile_impl(module);
+}
+/*[clinic end generated code: output=956731044cad861a input=a9049054013a1b77]*/
@@ -120,6 +120,18 @@ _queue_SimpleQueue_put_nowait(simplequeueobject *self, PyObject *const *args, Py
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_put_many__doc__,
+"put_many($self, items, /)\n"
+"--\n"
+"\n"
+"Put all the items of an iterable on the queue.\n"
+"\n"
+"The items are added together: another thread cannot put items between\n"
+"them.  This method never blocks.");
+
+#define _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF    \
+    {"put_many", (PyCFunction)_queue_SimpleQueue_put_many, METH_O, _queue_SimpleQueue_put_many__doc__},
+
 PyDoc_STRVAR(_queue_SimpleQueue_get__doc__,
 "get($self, /, block=True, timeout=None)\n"
 "--\n"
@@ -193,6 +205,43 @@ _queue_SimpleQueue_get_nowait(simplequeueobject *self, PyTypeObject *cls, PyObje
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_get_many__doc__,
+"get_many($self, /, maxcount, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Remove and return a list of at most \'maxcount\' items from the queue.\n"
+"\n"
+"Wait for the first item as get() does, then also remove the items which\n"
+"are immediately available, up to \'maxcount\' items in all.");
+
+#define _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF    \
+    {"get_many", (PyCFunction)(void(*)(void))_queue_SimpleQueue_get_many, METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_SimpleQueue_get_many__doc__},
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t maxcount, int block,
+                                 PyObject *timeout_obj);
+
+static PyObject *
+_queue_SimpleQueue_get_many(simplequeueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"maxcount", "block", "timeout", NULL};
+    static _PyArg_Parser _parser = {"n|pO:get_many", _keywords, 0};
+    Py_ssize_t maxcount;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    if (!_PyArg_ParseStackAndKeywords(args, nargs, kwnames, &_parser,
+        &maxcount, &block, &timeout_obj)) {
+        goto exit;
+    }
+    return_value = _queue_SimpleQueue_get_many_impl(self, cls, maxcount, block, timeout_obj);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_queue_SimpleQueue_empty__doc__,
 "empty($self, /)\n"
 "--\n"
@@ -248,4 +297,4 @@ _queue_SimpleQueue_qsize(simplequeueobject *self, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=acfaf0191d8935db input=a9049054013a1b77]*/
+/*[clinic end generated code: output=ca3920e4ed0be90a input=a9049054013a1b77]*/
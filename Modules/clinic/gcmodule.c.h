@@ -202,6 +202,346 @@ gc_get_threshold(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_get_threshold_impl(module);
 }
 
+PyDoc_STRVAR(gc_set_policy__doc__,
+"set_policy($module, policy, /)\n"
+"--\n"
+"\n"
+"Select how the collection thresholds are chosen.\n"
+"\n"
+"With the \"fixed\" policy, the thresholds are those set by set_threshold().\n"
+"With the \"adaptive\" policy, the threshold of each generation is raised when\n"
+"most of the objects its collections examine survive them, and lowered back\n"
+"toward the value set by set_threshold() when they find garbage.");
+
+#define GC_SET_POLICY_METHODDEF    \
+    {"set_policy", (PyCFunction)gc_set_policy, METH_O, gc_set_policy__doc__},
+
+static PyObject *
+gc_set_policy_impl(PyObject *module, const char *policy);
+
+static PyObject *
+gc_set_policy(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    const char *policy;
+
+    if (!PyUnicode_Check(arg)) {
+        _PyArg_BadArgument("set_policy", "argument", "str", arg);
+        goto exit;
+    }
+    Py_ssize_t policy_length;
+    policy = PyUnicode_AsUTF8AndSize(arg, &policy_length);
+    if (policy == NULL) {
+        goto exit;
+    }
+    if (strlen(policy) != (size_t)policy_length) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        goto exit;
+    }
+    return_value = gc_set_policy_impl(module, policy);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_policy__doc__,
+"get_policy($module, /)\n"
+"--\n"
+"\n"
+"Return the name of the policy choosing the collection thresholds.");
+
+#define GC_GET_POLICY_METHODDEF    \
+    {"get_policy", (PyCFunction)gc_get_policy, METH_NOARGS, gc_get_policy__doc__},
+
+static PyObject *
+gc_get_policy_impl(PyObject *module);
+
+static PyObject *
+gc_get_policy(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_get_policy_impl(module);
+}
+
+PyDoc_STRVAR(gc_get_policy_stats__doc__,
+"get_policy_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dictionary of statistics about the collection thresholds.");
+
+#define GC_GET_POLICY_STATS_METHODDEF    \
+    {"get_policy_stats", (PyCFunction)gc_get_policy_stats, METH_NOARGS, gc_get_policy_stats__doc__},
+
+static PyObject *
+gc_get_policy_stats_impl(PyObject *module);
+
+static PyObject *
+gc_get_policy_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_get_policy_stats_impl(module);
+}
+
+PyDoc_STRVAR(gc_set_pause_target__doc__,
+"set_pause_target($module, seconds, /)\n"
+"--\n"
+"\n"
+"Set the target duration of the collections of the oldest generation.\n"
+"\n"
+"If seconds is greater than zero, the oldest generation is collected\n"
+"incrementally: each collection of the middle generation also collects a\n"
+"part of the oldest generation that takes about seconds to examine.  Only\n"
+"gc.collect() collects the oldest generation in one pass.  Zero disables\n"
+"incremental collection.");
+
+#define GC_SET_PAUSE_TARGET_METHODDEF    \
+    {"set_pause_target", (PyCFunction)gc_set_pause_target, METH_O, gc_set_pause_target__doc__},
+
+static PyObject *
+gc_set_pause_target_impl(PyObject *module, double seconds);
+
+static PyObject *
+gc_set_pause_target(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    double seconds;
+
+    if (PyFloat_CheckExact(arg)) {
+        seconds = PyFloat_AS_DOUBLE(arg);
+    }
+    else
+    {
+        seconds = PyFloat_AsDouble(arg);
+        if (seconds == -1.0 && PyErr_Occurred()) {
+            goto exit;
+        }
+    }
+    return_value = gc_set_pause_target_impl(module, seconds);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_pause_target__doc__,
+"get_pause_target($module, /)\n"
+"--\n"
+"\n"
+"Return the target duration of the collections of the oldest generation.\n"
+"\n"
+"Zero means that incremental collection is disabled.");
+
+#define GC_GET_PAUSE_TARGET_METHODDEF    \
+    {"get_pause_target", (PyCFunction)gc_get_pause_target, METH_NOARGS, gc_get_pause_target__doc__},
+
+static double
+gc_get_pause_target_impl(PyObject *module);
+
+static PyObject *
+gc_get_pause_target(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    double _return_value;
+
+    _return_value = gc_get_pause_target_impl(module);
+    if ((_return_value == -1.0) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyFloat_FromDouble(_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_set_parallel__doc__,
+"set_parallel($module, threads, /)\n"
+"--\n"
+"\n"
+"Set the number of threads examining the objects of large collections.\n"
+"\n"
+"1 makes collections serial.");
+
+#define GC_SET_PARALLEL_METHODDEF    \
+    {"set_parallel", (PyCFunction)gc_set_parallel, METH_O, gc_set_parallel__doc__},
+
+static PyObject *
+gc_set_parallel_impl(PyObject *module, int threads);
+
+static PyObject *
+gc_set_parallel(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int threads;
+
+    threads = _PyLong_AsInt(arg);
+    if (threads == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = gc_set_parallel_impl(module, threads);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_parallel__doc__,
+"get_parallel($module, /)\n"
+"--\n"
+"\n"
+"Return the number of threads examining the objects of large collections.");
+
+#define GC_GET_PARALLEL_METHODDEF    \
+    {"get_parallel", (PyCFunction)gc_get_parallel, METH_NOARGS, gc_get_parallel__doc__},
+
+static int
+gc_get_parallel_impl(PyObject *module);
+
+static PyObject *
+gc_get_parallel(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = gc_get_parallel_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_parallel_stats__doc__,
+"get_parallel_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dictionary of statistics about parallel collections.");
+
+#define GC_GET_PARALLEL_STATS_METHODDEF    \
+    {"get_parallel_stats", (PyCFunction)gc_get_parallel_stats, METH_NOARGS, gc_get_parallel_stats__doc__},
+
+static PyObject *
+gc_get_parallel_stats_impl(PyObject *module);
+
+static PyObject *
+gc_get_parallel_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_get_parallel_stats_impl(module);
+}
+
+PyDoc_STRVAR(gc_set_event_buffer__doc__,
+"set_event_buffer($module, size, /)\n"
+"--\n"
+"\n"
+"Record the last size collections in a ring buffer read by get_events().\n"
+"\n"
+"Zero disables recording.  Events already recorded are discarded.");
+
+#define GC_SET_EVENT_BUFFER_METHODDEF    \
+    {"set_event_buffer", (PyCFunction)gc_set_event_buffer, METH_O, gc_set_event_buffer__doc__},
+
+static PyObject *
+gc_set_event_buffer_impl(PyObject *module, Py_ssize_t size);
+
+static PyObject *
+gc_set_event_buffer(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t size;
+
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(arg);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        size = ival;
+    }
+    return_value = gc_set_event_buffer_impl(module, size);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_event_buffer__doc__,
+"get_event_buffer($module, /)\n"
+"--\n"
+"\n"
+"Return the size of the ring buffer of collection events.");
+
+#define GC_GET_EVENT_BUFFER_METHODDEF    \
+    {"get_event_buffer", (PyCFunction)gc_get_event_buffer, METH_NOARGS, gc_get_event_buffer__doc__},
+
+static Py_ssize_t
+gc_get_event_buffer_impl(PyObject *module);
+
+static PyObject *
+gc_get_event_buffer(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = gc_get_event_buffer_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_events__doc__,
+"get_events($module, /, start=0)\n"
+"--\n"
+"\n"
+"Return the events recorded in the ring buffer, as a list of dictionaries.\n"
+"\n"
+"Only return the events whose id is greater than or equal to start.");
+
+#define GC_GET_EVENTS_METHODDEF    \
+    {"get_events", (PyCFunction)(void(*)(void))gc_get_events, METH_FASTCALL|METH_KEYWORDS, gc_get_events__doc__},
+
+static PyObject *
+gc_get_events_impl(PyObject *module, Py_ssize_t start);
+
+static PyObject *
+gc_get_events(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"start", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "get_events", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    Py_ssize_t start = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[0]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        start = ival;
+    }
+skip_optional_pos:
+    return_value = gc_get_events_impl(module, start);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(gc_get_count__doc__,
 "get_count($module, /)\n"
 "--\n"
@@ -304,25 +644,52 @@ PyDoc_STRVAR(gc_is_finalized__doc__,
     {"is_finalized", (PyCFunction)gc_is_finalized, METH_O, gc_is_finalized__doc__},
 
 PyDoc_STRVAR(gc_freeze__doc__,
-"freeze($module, /)\n"
+"freeze($module, /, *, immortal=False)\n"
 "--\n"
 "\n"
 "Freeze all current tracked objects and ignore them for future collections.\n"
 "\n"
 "This can be used before a POSIX fork() call to make the gc copy-on-write friendly.\n"
 "Note: collection before a POSIX fork() call may free pages for future allocation\n"
-"which can cause copy-on-write.");
+"which can cause copy-on-write.\n"
+"\n"
+"If immortal is true, the frozen objects, the objects they reference and the\n"
+"interned strings also become immortal: their reference count is no longer\n"
+"updated and they are never deallocated, so that using them in a child\n"
+"process doesn\'t write to the pages they occupy.");
 
 #define GC_FREEZE_METHODDEF    \
-    {"freeze", (PyCFunction)gc_freeze, METH_NOARGS, gc_freeze__doc__},
+    {"freeze", (PyCFunction)(void(*)(void))gc_freeze, METH_FASTCALL|METH_KEYWORDS, gc_freeze__doc__},
 
 static PyObject *
-gc_freeze_impl(PyObject *module);
+gc_freeze_impl(PyObject *module, int immortal);
 
 static PyObject *
-gc_freeze(PyObject *module, PyObject *Py_UNUSED(ignored))
+gc_freeze(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    return gc_freeze_impl(module);
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"immortal", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "freeze", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int immortal = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    immortal = _PyLong_AsInt(args[0]);
+    if (immortal == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = gc_freeze_impl(module, immortal);
+
+exit:
+    return return_value;
 }
 
 PyDoc_STRVAR(gc_unfreeze__doc__,
@@ -331,7 +698,8 @@ PyDoc_STRVAR(gc_unfreeze__doc__,
 "\n"
 "Unfreeze all objects in the permanent generation.\n"
 "\n"
-"Put all objects in the permanent generation back into oldest generation.");
+"Put all objects in the permanent generation back into oldest generation.\n"
+"Immortal objects stay in the permanent generation.");
 
 #define GC_UNFREEZE_METHODDEF    \
     {"unfreeze", (PyCFunction)gc_unfreeze, METH_NOARGS, gc_unfreeze__doc__},
@@ -372,4 +740,4 @@ gc_get_freeze_count(PyObject *module, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=61e15f3a549f3ab5 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=113b88f81915dc3a input=a9049054013a1b77]*/
@@ -24,6 +24,7 @@
 */
 
 #include "Python.h"
+#include "pycore_atomic_funcs.h" // _Py_atomic_size_add()
 #include "pycore_context.h"
 #include "pycore_initconfig.h"
 #include "pycore_interp.h"      // PyInterpreterState.gc
@@ -31,6 +32,7 @@
 #include "pycore_pyerrors.h"
 #include "pycore_pystate.h"     // _PyThreadState_GET()
 #include "pydtrace.h"
+#include "../Python/condvar.h"  // PyCOND_WAIT()
 
 typedef struct _gc_runtime_state GCState;
 
@@ -107,6 +109,12 @@ gc_reset_refs(PyGC_Head *g, Py_ssize_t refs)
         | ((uintptr_t)(refs) << _PyGC_PREV_SHIFT);
 }
 
+static inline void
+gc_set_collecting(PyGC_Head *g)
+{
+    g->_gc_prev |= PREV_MASK_COLLECTING;
+}
+
 static inline void
 gc_decref(PyGC_Head *g)
 {
@@ -136,6 +144,12 @@ get_gc_state(void)
 }
 
 
+/* Fraction of long_lived_total which long_lived_pending must reach to
+ * trigger a full collection with the fixed policy, and largest fraction
+ * the adaptive policy requires (see gc_collect_generations()) */
+#define FULL_RATIO 0.25
+#define FULL_RATIO_MAX 4.0
+
 void
 _PyGC_InitState(GCState *gcstate)
 {
@@ -157,6 +171,35 @@ _PyGC_InitState(GCState *gcstate)
            (uintptr_t)&gcstate->permanent_generation.head}, 0, 0
     };
     gcstate->permanent_generation = permanent_generation;
+
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    inc->pause_target = 0.0;
+    inc->scan_rate = 0.0;
+    inc->pass_remaining = 0;
+    inc->pass_survivors = 0;
+    inc->increments = 0;
+    inc->passes = 0;
+
+    struct gc_parallel_state *par = &gcstate->parallel;
+    par->threads = 1;
+    par->collections = 0;
+    par->wall_time = 0;
+    par->work_time = 0;
+    par->pool = NULL;
+
+    gcstate->event_buffer.events = NULL;
+    gcstate->event_buffer.size = 0;
+    gcstate->event_buffer.count = 0;
+
+    struct gc_policy_state *policy = &gcstate->policy;
+    policy->policy = _PyGC_POLICY_FIXED;
+    for (int i = 0; i < NUM_GENERATIONS; i++) {
+        policy->base_threshold[i] = gcstate->generations[i].threshold;
+        policy->survival[i] = -1.0;
+    }
+    policy->full_ratio = FULL_RATIO;
+    policy->raised = 0;
+    policy->lowered = 0;
 }
 
 
@@ -418,12 +461,14 @@ validate_list(PyGC_Head *head, enum flagstates flags)
 
 /* Set all gc_refs = ob_refcnt.  After this, gc_refs is > 0 and
  * PREV_MASK_COLLECTING bit is set for all objects in containers.
+ * Return the number of objects in containers.
  */
-static void
+static Py_ssize_t
 update_refs(PyGC_Head *containers)
 {
+    Py_ssize_t n = 0;
     PyGC_Head *gc = GC_NEXT(containers);
-    for (; gc != containers; gc = GC_NEXT(gc)) {
+    for (; gc != containers; gc = GC_NEXT(gc), n++) {
         gc_reset_refs(gc, Py_REFCNT(FROM_GC(gc)));
         /* Python's cyclic gc should never see an incoming refcount
          * of 0:  if something decref'ed to 0, it should have been
@@ -445,6 +490,7 @@ update_refs(PyGC_Head *containers)
          */
         _PyObject_ASSERT(FROM_GC(gc), gc_get_refs(gc) != 0);
     }
+    return n;
 }
 
 /* A traversal callback for subtract_refs. */
@@ -1065,6 +1111,18 @@ show_stats_each_generations(GCState *gcstate)
         buf, gc_list_size(&gcstate->permanent_generation.head));
 }
 
+/* If event is not NULL, add the time elapsed since *t to its phase, and
+ * set *t to the current time. */
+static inline void
+event_phase_end(struct gc_event *event, enum _PyGC_Phase phase, _PyTime_t *t)
+{
+    if (event != NULL) {
+        _PyTime_t now = _PyTime_GetPerfCounter();
+        event->phases[phase] += now - *t;
+        *t = now;
+    }
+}
+
 /* Deduce which objects among "base" are unreachable from outside the list
    and move them to 'unreachable'. The process consist in the following steps:
 
@@ -1093,15 +1151,20 @@ flag is cleared (for example, by using 'clear_unreachable_mask' function or
 by a call to 'move_legacy_finalizers'), the 'unreachable' list is not a normal
 list and we can not use most gc_list_* functions for it. */
 static inline void
-deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
+deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable,
+                   struct gc_event *event)
+{
+    _PyTime_t t = event != NULL ? _PyTime_GetPerfCounter() : 0;
     validate_list(base, collecting_clear_unreachable_clear);
     /* Using ob_refcnt and gc_refs, calculate which objects in the
      * container set are reachable from outside the set (i.e., have a
      * refcount greater than 0 when all the references within the
      * set are taken into account).
      */
-    update_refs(base);  // gc_prev is used for gc_refs
+    Py_ssize_t n = update_refs(base);  // gc_prev is used for gc_refs
+    event_phase_end(event, _PyGC_PHASE_UPDATE_REFS, &t);
     subtract_refs(base);
+    event_phase_end(event, _PyGC_PHASE_SUBTRACT_REFS, &t);
 
     /* Leave everything reachable from outside base in base, and move
      * everything else (in base) to unreachable.
@@ -1140,8 +1203,496 @@ deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
      */
     gc_list_init(unreachable);
     move_unreachable(base, unreachable);  // gc_prev is pointer again
+    event_phase_end(event, _PyGC_PHASE_MOVE_UNREACHABLE, &t);
+    validate_list(base, collecting_clear_unreachable_clear);
+    validate_list(unreachable, collecting_set_unreachable_set);
+    if (event != NULL) {
+        event->examined += n;
+    }
+}
+
+/* Parallel examination of the collected objects.
+ *
+ * subtract_refs() and move_unreachable() call tp_traverse on every object
+ * of the collected generation, which makes most of the cost of a large
+ * collection.  When several threads are enabled (gc.set_parallel()), the
+ * generation is split into chunks of consecutive objects while update_refs()
+ * walks it, and native threads share the chunks to:
+ *
+ * 1. subtract the internal references, decrementing gc_refs atomically;
+ * 2. mark the reachable objects: the objects whose gc_refs is still positive
+ *    and, transitively, the objects of the generation they refer to.  An
+ *    object is marked by clearing its PREV_MASK_COLLECTING flag with a
+ *    compare-and-exchange, so that only the thread which marks it traverses
+ *    it.  Each thread keeps the marked objects it has yet to traverse on its
+ *    own stack.
+ *
+ * The objects are neither moved nor freed by the threads, and tp_traverse
+ * only reads them, so the threads run without the GIL while the collecting
+ * thread, which holds it, takes part in the work.  Then the collecting
+ * thread moves the objects which are not marked to the unreachable list, as
+ * move_unreachable() does.
+ *
+ * gc.set_parallel() starts the other threads once.  They wait on the start
+ * condition variable of the pool for the next phase, and are stopped and
+ * waited for by gc.set_parallel() and _PyGC_Fini().
+ *
+ * The stacks of the threads cannot grow, since memory cannot be allocated
+ * without the GIL when tracemalloc traces it.  An object which does not
+ * fit in a full stack is marked but left for the collecting thread, which
+ * traverses all of the marked objects again once the threads are done.
+ */
+
+/* Number of objects in a chunk */
+#define PARALLEL_CHUNK_SIZE 4096
+/* Smallest number of chunks to use threads */
+#define PARALLEL_MIN_CHUNKS 4
+/* Capacity of the stack of a thread */
+#define PARALLEL_STACK_SIZE 8192
+/* Largest number of threads */
+#define PARALLEL_MAX_THREADS 256
+
+enum parallel_phase {
+    PHASE_SUBTRACT_REFS,
+    PHASE_MARK_REACHABLE,
+};
+
+struct parallel_job {
+    enum parallel_phase phase;
+    /* The chunks: the i-th chunk starts at chunks[i] and ends before
+     * chunks[i+1]; the last entry is the list head */
+    PyGC_Head **chunks;
+    Py_ssize_t nchunks;
+    /* Index of the next chunk to process */
+    Py_ssize_t next_chunk;
+    /* Set if a marked object did not fit in a stack */
+    Py_ssize_t overflow;
+};
+
+struct parallel_worker {
+    struct gc_parallel_pool *pool;
+    struct parallel_job *job;
+    PyGC_Head **stack;
+    Py_ssize_t stack_len;
+    _PyTime_t work_time;
+};
+
+struct gc_parallel_pool {
+    PyMUTEX_T mutex;
+    /* Signaled when a phase starts or the threads must exit */
+    PyCOND_T start;
+    /* Signaled when a thread finishes a phase or exits */
+    PyCOND_T done;
+    /* Number of phases started, and set to make the threads exit */
+    size_t phases;
+    int stop;
+    /* Number of threads started, and of those which did not finish the
+     * current phase or did not exit once stopped */
+    int nthreads;
+    int running;
+    /* nthreads+1 workers: the first one is the collecting thread */
+    struct parallel_worker *workers;
+    PyGC_Head **stacks;
+};
+
+#ifdef _Py_HAVE_ATOMIC_RMW
+
+/* A traversal callback for the PHASE_SUBTRACT_REFS phase. */
+static int
+visit_decref_atomic(PyObject *op, void *parent)
+{
+    _PyObject_ASSERT(_PyObject_CAST(parent), !_PyObject_IsFreed(op));
+
+    if (_PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        uintptr_t prev = _Py_atomic_uintptr_get(&gc->_gc_prev);
+        if (prev & PREV_MASK_COLLECTING) {
+            prev = _Py_atomic_uintptr_add(&gc->_gc_prev,
+                                          -((uintptr_t)1 << _PyGC_PREV_SHIFT));
+            _PyObject_ASSERT_WITH_MSG(op, (prev >> _PyGC_PREV_SHIFT) > 0,
+                                      "refcount is too small");
+        }
+    }
+    return 0;
+}
+
+/* Mark gc as reachable.  Return 1 if the caller must traverse it, 0 if it
+ * is not in the generation or is already marked. */
+static inline int
+parallel_mark(PyGC_Head *gc)
+{
+    uintptr_t prev = _Py_atomic_uintptr_get(&gc->_gc_prev);
+    while (prev & PREV_MASK_COLLECTING) {
+        if (_Py_atomic_uintptr_compare_exchange(
+                &gc->_gc_prev, prev, prev & ~PREV_MASK_COLLECTING)) {
+            return 1;
+        }
+        prev = _Py_atomic_uintptr_get(&gc->_gc_prev);
+    }
+    return 0;
+}
+
+/* A traversal callback for the PHASE_MARK_REACHABLE phase. */
+static int
+visit_mark_atomic(PyObject *op, struct parallel_worker *worker)
+{
+    if (_PyObject_IS_GC(op) && parallel_mark(AS_GC(op))) {
+        if (worker->stack_len < PARALLEL_STACK_SIZE) {
+            worker->stack[worker->stack_len++] = AS_GC(op);
+        }
+        else {
+            _Py_atomic_size_set(&worker->job->overflow, 1);
+        }
+    }
+    return 0;
+}
+
+/* Return the CPU time of the current thread, or the performance counter if
+ * it is not available. */
+static _PyTime_t
+parallel_thread_time(void)
+{
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return _PyTime_FromNanoseconds((_PyTime_t)ts.tv_sec * 1000000000
+                                       + ts.tv_nsec);
+    }
+#endif
+    return _PyTime_GetPerfCounter();
+}
+
+static inline void
+parallel_traverse(PyGC_Head *gc, visitproc visit, void *arg)
+{
+    PyObject *op = FROM_GC(gc);
+    traverseproc traverse = Py_TYPE(op)->tp_traverse;
+    (void) traverse(op, visit, arg);
+}
+
+/* Process chunks until there is none left. */
+static void
+parallel_work(struct parallel_worker *worker)
+{
+    struct parallel_job *job = worker->job;
+    _PyTime_t t0 = parallel_thread_time();
+    for (;;) {
+        Py_ssize_t i = _Py_atomic_size_add(&job->next_chunk, 1);
+        if (i >= job->nchunks) {
+            break;
+        }
+        PyGC_Head *end = job->chunks[i + 1];
+        for (PyGC_Head *gc = job->chunks[i]; gc != end; gc = GC_NEXT(gc)) {
+            if (job->phase == PHASE_SUBTRACT_REFS) {
+                parallel_traverse(gc, visit_decref_atomic, FROM_GC(gc));
+                continue;
+            }
+            /* Objects directly reachable from outside the generation */
+            if ((_Py_atomic_uintptr_get(&gc->_gc_prev) >> _PyGC_PREV_SHIFT)
+                == 0 || !parallel_mark(gc))
+            {
+                continue;
+            }
+            parallel_traverse(gc, (visitproc)visit_mark_atomic, worker);
+            while (worker->stack_len > 0) {
+                PyGC_Head *reached = worker->stack[--worker->stack_len];
+                parallel_traverse(reached, (visitproc)visit_mark_atomic,
+                                  worker);
+            }
+        }
+    }
+    worker->work_time = parallel_thread_time() - t0;
+}
+
+static void
+parallel_thread(void *arg)
+{
+    struct parallel_worker *worker = (struct parallel_worker *)arg;
+    struct gc_parallel_pool *pool = worker->pool;
+    /* The pool starts no phase before all its threads are started, but a
+     * thread may only get here once the first phase has started. */
+    size_t phases = 0;
+    PyMUTEX_LOCK(&pool->mutex);
+    for (;;) {
+        while (pool->phases == phases && !pool->stop) {
+            PyCOND_WAIT(&pool->start, &pool->mutex);
+        }
+        if (pool->stop) {
+            break;
+        }
+        phases = pool->phases;
+        PyMUTEX_UNLOCK(&pool->mutex);
+        parallel_work(worker);
+        PyMUTEX_LOCK(&pool->mutex);
+        if (--pool->running == 0) {
+            PyCOND_SIGNAL(&pool->done);
+        }
+    }
+    if (--pool->running == 0) {
+        PyCOND_SIGNAL(&pool->done);
+    }
+    PyMUTEX_UNLOCK(&pool->mutex);
+}
+
+/* Run a phase on the threads of the pool and on the current one. */
+static void
+parallel_run(struct gc_parallel_pool *pool, struct parallel_job *job)
+{
+    job->next_chunk = 0;
+    for (int i = 0; i <= pool->nthreads; i++) {
+        pool->workers[i].job = job;
+        pool->workers[i].stack_len = 0;
+        pool->workers[i].work_time = 0;
+    }
+    PyMUTEX_LOCK(&pool->mutex);
+    pool->running = pool->nthreads;
+    pool->phases++;
+    PyCOND_BROADCAST(&pool->start);
+    PyMUTEX_UNLOCK(&pool->mutex);
+
+    parallel_work(&pool->workers[0]);
+
+    PyMUTEX_LOCK(&pool->mutex);
+    while (pool->running > 0) {
+        PyCOND_WAIT(&pool->done, &pool->mutex);
+    }
+    PyMUTEX_UNLOCK(&pool->mutex);
+}
+
+static void
+parallel_pool_free(struct gc_parallel_pool *pool)
+{
+    PyMem_RawFree(pool->workers);
+    PyMem_RawFree(pool->stacks);
+    PyMem_RawFree(pool);
+}
+
+/* Make the threads of the pool exit, wait for them and free the pool. */
+static void
+parallel_pool_stop(struct gc_parallel_pool *pool)
+{
+    PyMUTEX_LOCK(&pool->mutex);
+    pool->stop = 1;
+    pool->running = pool->nthreads;
+    PyCOND_BROADCAST(&pool->start);
+    while (pool->running > 0) {
+        PyCOND_WAIT(&pool->done, &pool->mutex);
+    }
+    PyMUTEX_UNLOCK(&pool->mutex);
+    PyCOND_FINI(&pool->done);
+    PyCOND_FINI(&pool->start);
+    PyMUTEX_FINI(&pool->mutex);
+    parallel_pool_free(pool);
+}
+
+/* Start a pool of nthreads threads.  Return NULL with an exception set on
+ * error. */
+static struct gc_parallel_pool *
+parallel_pool_start(int nthreads)
+{
+    struct gc_parallel_pool *pool = PyMem_RawCalloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    pool->workers = PyMem_RawCalloc(nthreads + 1, sizeof(*pool->workers));
+    pool->stacks = PyMem_RawMalloc((size_t)(nthreads + 1)
+                                   * PARALLEL_STACK_SIZE
+                                   * sizeof(PyGC_Head *));
+    if (pool->workers == NULL || pool->stacks == NULL) {
+        parallel_pool_free(pool);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (int i = 0; i <= nthreads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].stack = pool->stacks
+                                 + (size_t)i * PARALLEL_STACK_SIZE;
+    }
+    if (PyMUTEX_INIT(&pool->mutex)) {
+        parallel_pool_free(pool);
+        PyErr_SetString(PyExc_RuntimeError, "can't initialize mutex");
+        return NULL;
+    }
+    if (PyCOND_INIT(&pool->start)) {
+        PyMUTEX_FINI(&pool->mutex);
+        parallel_pool_free(pool);
+        PyErr_SetString(PyExc_RuntimeError, "can't initialize condition");
+        return NULL;
+    }
+    if (PyCOND_INIT(&pool->done)) {
+        PyCOND_FINI(&pool->start);
+        PyMUTEX_FINI(&pool->mutex);
+        parallel_pool_free(pool);
+        PyErr_SetString(PyExc_RuntimeError, "can't initialize condition");
+        return NULL;
+    }
+    for (; pool->nthreads < nthreads; pool->nthreads++) {
+        if (PyThread_start_new_thread(parallel_thread,
+                                      &pool->workers[pool->nthreads + 1])
+            == PYTHREAD_INVALID_THREAD_ID)
+        {
+            parallel_pool_stop(pool);
+            PyErr_SetString(PyExc_RuntimeError, "can't start new thread");
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+/* Traverse every marked object of base again, to mark the objects which
+ * did not fit in the stacks of the threads, and everything they refer to.
+ * Repeat while the stack of the current thread overflows. */
+static void
+parallel_mark_overflow(PyGC_Head *base, struct parallel_worker *worker)
+{
+    struct parallel_job *job = worker->job;
+    while (job->overflow) {
+        job->overflow = 0;
+        for (PyGC_Head *gc = GC_NEXT(base); gc != base; gc = GC_NEXT(gc)) {
+            if (gc_is_collecting(gc)) {
+                continue;
+            }
+            parallel_traverse(gc, (visitproc)visit_mark_atomic, worker);
+            while (worker->stack_len > 0) {
+                PyGC_Head *reached = worker->stack[--worker->stack_len];
+                parallel_traverse(reached, (visitproc)visit_mark_atomic,
+                                  worker);
+            }
+        }
+    }
+}
+
+/* Move the objects of young which are not marked to unreachable, and restore
+ * the _gc_prev pointers of the others.  This has the same result as
+ * move_unreachable(), except for the order of the objects. */
+static void
+move_unmarked(PyGC_Head *young, PyGC_Head *unreachable)
+{
+    PyGC_Head *prev = young;
+    PyGC_Head *gc = GC_NEXT(young);
+    while (gc != young) {
+        PyGC_Head *next = GC_NEXT(gc);
+        if (gc_is_collecting(gc)) {
+            // See move_unreachable() for the NEXT_MASK_UNREACHABLE flag.
+            PyGC_Head *last = GC_PREV(unreachable);
+            last->_gc_next = (NEXT_MASK_UNREACHABLE | (uintptr_t)gc);
+            _PyGCHead_SET_PREV(gc, last);
+            gc->_gc_next = (NEXT_MASK_UNREACHABLE | (uintptr_t)unreachable);
+            unreachable->_gc_prev = (uintptr_t)gc;
+        }
+        else {
+            prev->_gc_next = (uintptr_t)gc;
+            _PyGCHead_SET_PREV(gc, prev);
+            prev = gc;
+        }
+        gc = next;
+    }
+    prev->_gc_next = (uintptr_t)young;
+    young->_gc_prev = (uintptr_t)prev;
+    unreachable->_gc_next &= ~NEXT_MASK_UNREACHABLE;
+}
+
+#endif  /* _Py_HAVE_ATOMIC_RMW */
+
+/* Like update_refs(), but also split containers into chunks of
+ * PARALLEL_CHUNK_SIZE objects.  Return the number of chunks, or 0 if there
+ * are too few of them to use threads or if memory is exhausted.  Set *pn
+ * to the number of objects in containers. */
+static Py_ssize_t
+update_refs_chunked(PyGC_Head *containers, PyGC_Head ***pchunks,
+                    Py_ssize_t *pn)
+{
+    Py_ssize_t nchunks = 0, allocated = 0, n = 0;
+    PyGC_Head **chunks = NULL;
+    int failed = 0;
+    PyGC_Head *gc = GC_NEXT(containers);
+    for (; gc != containers; gc = GC_NEXT(gc)) {
+        if (n++ % PARALLEL_CHUNK_SIZE == 0 && !failed) {
+            if (nchunks + 1 >= allocated) {
+                allocated = allocated ? allocated * 2 : 64;
+                PyGC_Head **resized = PyMem_RawRealloc(
+                    chunks, allocated * sizeof(PyGC_Head *));
+                if (resized == NULL) {
+                    failed = 1;
+                    continue;
+                }
+                chunks = resized;
+            }
+            chunks[nchunks++] = gc;
+        }
+        gc_reset_refs(gc, Py_REFCNT(FROM_GC(gc)));
+        // See update_refs()
+        _PyObject_ASSERT(FROM_GC(gc), gc_get_refs(gc) != 0);
+    }
+    *pn = n;
+    if (failed || nchunks < PARALLEL_MIN_CHUNKS) {
+        PyMem_RawFree(chunks);
+        *pchunks = NULL;
+        return 0;
+    }
+    chunks[nchunks] = containers;
+    *pchunks = chunks;
+    return nchunks;
+}
+
+/* Same as deduce_unreachable(), using gcstate->parallel.threads threads for
+ * large generations. */
+static void
+deduce_unreachable_parallel(GCState *gcstate, PyGC_Head *base,
+                            PyGC_Head *unreachable, struct gc_event *event)
+{
+    struct gc_parallel_state *par = &gcstate->parallel;
+    _PyTime_t t = event != NULL ? _PyTime_GetPerfCounter() : 0;
+    validate_list(base, collecting_clear_unreachable_clear);
+
+    PyGC_Head **chunks;
+    Py_ssize_t n;
+    Py_ssize_t nchunks = update_refs_chunked(base, &chunks, &n);
+    if (event != NULL) {
+        event->examined += n;
+    }
+    event_phase_end(event, _PyGC_PHASE_UPDATE_REFS, &t);
+    struct gc_parallel_pool *pool = par->pool;
+    if (pool == NULL || nchunks == 0) {
+        PyMem_RawFree(chunks);
+        subtract_refs(base);
+        event_phase_end(event, _PyGC_PHASE_SUBTRACT_REFS, &t);
+        gc_list_init(unreachable);
+        move_unreachable(base, unreachable);
+        event_phase_end(event, _PyGC_PHASE_MOVE_UNREACHABLE, &t);
+        validate_list(base, collecting_clear_unreachable_clear);
+        validate_list(unreachable, collecting_set_unreachable_set);
+        return;
+    }
+
+#ifdef _Py_HAVE_ATOMIC_RMW
+    struct parallel_job job = {PHASE_SUBTRACT_REFS, chunks, nchunks, 0, 0};
+    _PyTime_t t0 = _PyTime_GetPerfCounter();
+    _PyTime_t work_time = 0;
+    parallel_run(pool, &job);
+    for (int i = 0; i <= pool->nthreads; i++) {
+        work_time += pool->workers[i].work_time;
+    }
+    event_phase_end(event, _PyGC_PHASE_SUBTRACT_REFS, &t);
+    job.phase = PHASE_MARK_REACHABLE;
+    parallel_run(pool, &job);
+    for (int i = 0; i <= pool->nthreads; i++) {
+        work_time += pool->workers[i].work_time;
+    }
+    par->wall_time += _PyTime_GetPerfCounter() - t0;
+    par->work_time += work_time;
+    par->collections++;
+
+    parallel_mark_overflow(base, &pool->workers[0]);
+    PyMem_RawFree(chunks);
+
+    gc_list_init(unreachable);
+    move_unmarked(base, unreachable);
+    event_phase_end(event, _PyGC_PHASE_MOVE_UNREACHABLE, &t);
     validate_list(base, collecting_clear_unreachable_clear);
     validate_list(unreachable, collecting_set_unreachable_set);
+#endif
 }
 
 /* Handle objects that may have resurrected after a call to 'finalize_garbage', moving
@@ -1169,79 +1720,460 @@ handle_resurrected_objects(PyGC_Head *unreachable, PyGC_Head* still_unreachable,
     // have the PREV_MARK_COLLECTING set, but the objects are going to be
     // removed so we can skip the expense of clearing the flag.
     PyGC_Head* resurrected = unreachable;
-    deduce_unreachable(resurrected, still_unreachable);
+    deduce_unreachable(resurrected, still_unreachable, NULL);
     clear_unreachable_mask(still_unreachable);
 
     // Move the resurrected objects to the old generation for future collection.
     gc_list_merge(resurrected, old_generation);
 }
 
-/* This is the main function.  Read this to understand how the
- * collection process works. */
+/* Incremental collection of the oldest generation.
+ *
+ * When a pause target is set (gc.set_pause_target()), the oldest generation
+ * is not collected in one pass: each time the middle generation's threshold
+ * is exceeded, an "increment" made of the young generations and of a bounded
+ * slice of the oldest generation is collected instead.  The slice is taken
+ * from the head of the oldest generation and its survivors are appended to
+ * its tail, so successive increments walk around the whole generation; a
+ * "pass" is complete when they have examined about as many objects as the
+ * generation held when the pass started.
+ *
+ * Collecting any subset of the tracked objects is safe: references from
+ * objects outside of the subset are counted as external references by
+ * deduce_unreachable(), so such objects are only ever kept alive, never
+ * freed.  Each increment runs with the GIL held like a normal collection,
+ * so no write barrier is needed: the mutator cannot change the object graph
+ * while an increment examines it.  The price is completeness: a cycle is
+ * only found if all of its members are in the same increment.  To keep the
+ * members of a cycle together, the objects referenced by the slice are
+ * added to the increment too, transitively, within the same budget, when
+ * they are among the objects which follow the slice in the oldest
+ * generation.
+ * Cycles larger than the budget are only collected by an explicit full
+ * collection (gc.collect()).
+ *
+ * The budget of an increment is the number of objects of the oldest
+ * generation that can be examined within the pause target, estimated from
+ * the measured duration of previous increments.
+ */
+
+/* Budget of the first increment, before the scan rate is known */
+#define INCREMENT_INITIAL_BUDGET 10000
+/* Smallest budget of an increment */
+#define INCREMENT_MIN_BUDGET 100
+/* Size of the window of the oldest generation from which referenced objects
+ * are added to an increment, as a multiple of the remaining budget */
+#define INCREMENT_WINDOW_FACTOR 4
+
+struct increment_state {
+    PyGC_Head *increment;
+    Py_ssize_t budget;
+};
+
+/* Add the objects of the window referenced by an object of the increment
+ * to the increment.  The objects of the window, and only them, have the
+ * PREV_MASK_COLLECTING flag set while the increment is gathered.  Any other
+ * object may not be in the oldest generation: it can be in the permanent
+ * generation or belong to another interpreter, as the dicts of static
+ * types do. */
+static int
+visit_increment(PyObject *op, struct increment_state *state)
+{
+    if (state->budget > 0 && _PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        if (_PyObject_GC_IS_TRACKED(op) && gc_is_collecting(gc)) {
+            gc_clear_collecting(gc);
+            gc_list_move(gc, state->increment);
+            state->budget--;
+        }
+    }
+    return 0;
+}
+
+/* Move the young generations and up to `budget` objects of the oldest
+ * generation to `increment`.  Return the number of objects taken from the
+ * oldest generation. */
 static Py_ssize_t
-gc_collect_main(PyThreadState *tstate, int generation,
-                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
-                int nofail)
+gather_increment(GCState *gcstate, PyGC_Head *increment, Py_ssize_t budget)
 {
-    int i;
-    Py_ssize_t m = 0; /* # objects collected */
-    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
-    PyGC_Head *young; /* the generation we are examining */
-    PyGC_Head *old; /* next older generation */
-    PyGC_Head unreachable; /* non-problematic unreachable trash */
-    PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
+    PyGC_Head *oldest = GEN_HEAD(gcstate, NUM_GENERATIONS - 1);
     PyGC_Head *gc;
-    _PyTime_t t1 = 0;   /* initialize to prevent a compiler warning */
-    GCState *gcstate = &tstate->interp->gc;
 
-    // gc_collect_main() must not be called before _PyGC_Init
-    // or after _PyGC_Fini()
-    assert(gcstate->garbage != NULL);
-    assert(!_PyErr_Occurred(tstate));
+    for (int i = 0; i < NUM_GENERATIONS - 1; i++) {
+        gc_list_merge(GEN_HEAD(gcstate, i), increment);
+    }
 
-#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
-    if (tstate->interp->config._isolated_interpreter) {
-        // bpo-40533: The garbage collector must not be run on parallel on
-        // Python objects shared by multiple interpreters.
-        return 0;
+    /* Take half of the budget from the head of the oldest generation, and
+     * keep the other half for the objects they reference. */
+    PyGC_Head *last_young = GC_PREV(increment);
+    Py_ssize_t slice = (budget + 1) / 2;
+    Py_ssize_t taken = 0;
+    while (taken < slice && !gc_list_is_empty(oldest)) {
+        gc = GC_NEXT(oldest);
+        gc_list_move(gc, increment);
+        taken++;
     }
-#endif
 
-    if (gcstate->debug & DEBUG_STATS) {
-        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
-        show_stats_each_generations(gcstate);
-        t1 = _PyTime_GetPerfCounter();
+    /* Referenced objects are only taken from a window of the objects which
+     * follow the slice, since telling whether any object is in the oldest
+     * generation would mean walking all of it. */
+    Py_ssize_t window = (budget - taken) * INCREMENT_WINDOW_FACTOR;
+    for (gc = GC_NEXT(oldest); gc != oldest && window > 0;
+         gc = GC_NEXT(gc), window--)
+    {
+        gc_set_collecting(gc);
     }
 
-    if (PyDTrace_GC_START_ENABLED())
-        PyDTrace_GC_START(generation);
+    struct increment_state state = {increment, budget - taken};
+    for (gc = GC_NEXT(last_young); gc != increment; gc = GC_NEXT(gc)) {
+        if (state.budget == 0) {
+            break;
+        }
+        traverseproc traverse = Py_TYPE(FROM_GC(gc))->tp_traverse;
+        (void) traverse(FROM_GC(gc),
+                        (visitproc)visit_increment,
+                        (void *)&state);
+    }
+    taken = budget - state.budget;
 
-    /* update collection and allocation counters */
-    if (generation+1 < NUM_GENERATIONS)
-        gcstate->generations[generation+1].count += 1;
-    for (i = 0; i <= generation; i++)
-        gcstate->generations[i].count = 0;
+    /* The objects left in the window are still at the head of the oldest
+     * generation */
+    for (gc = GC_NEXT(oldest); gc != oldest && gc_is_collecting(gc);
+         gc = GC_NEXT(gc))
+    {
+        gc_clear_collecting(gc);
+    }
+    return taken;
+}
 
-    /* merge younger generations with one we are currently collecting */
-    for (i = 0; i < generation; i++) {
-        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+/* Return the number of objects of the oldest generation that the next
+ * increment may examine. */
+static Py_ssize_t
+increment_budget(GCState *gcstate)
+{
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    double budget;
+    if (inc->scan_rate > 0.0) {
+        budget = inc->pause_target * inc->scan_rate;
+    }
+    else {
+        budget = INCREMENT_INITIAL_BUDGET;
+    }
+    if (budget < INCREMENT_MIN_BUDGET) {
+        return INCREMENT_MIN_BUDGET;
     }
+    if (budget > (double)(PY_SSIZE_T_MAX / 2)) {
+        return PY_SSIZE_T_MAX / 2;
+    }
+    return (Py_ssize_t)budget;
+}
 
-    /* handy references */
-    young = GEN_HEAD(gcstate, generation);
-    if (generation < NUM_GENERATIONS-1)
-        old = GEN_HEAD(gcstate, generation+1);
-    else
-        old = young;
-    validate_list(old, collecting_clear_unreachable_clear);
+/* Events: records of the last collections (gc.set_event_buffer()).
+ *
+ * The collector fills a struct gc_event on its stack, and copies it into the
+ * ring buffer when the collection is done, so that Python code run by the
+ * collection (finalizers, weakref callbacks) can read or replace the buffer.
+ * Recording an event does not allocate memory. */
 
-    deduce_unreachable(young, &unreachable);
+/* Number of entries of the table counting the survivors per type */
+#define SURVIVOR_TYPES_TABLE 128
 
-    untrack_tuples(young);
+/* Count the objects of young per type, and keep the types with the most
+ * objects in event.  Types are not counted anymore once the table is 3/4
+ * full: only event->survivors counts their objects. */
+static void
+count_survivor_types(PyGC_Head *young, struct gc_event *event)
+{
+    struct {
+        PyTypeObject *type;
+        Py_ssize_t count;
+    } table[SURVIVOR_TYPES_TABLE];
+    memset(table, 0, sizeof(table));
+
+    Py_ssize_t used = 0, survivors = 0;
+    for (PyGC_Head *gc = GC_NEXT(young); gc != young; gc = GC_NEXT(gc)) {
+        survivors++;
+        PyTypeObject *type = Py_TYPE(FROM_GC(gc));
+        size_t i = ((uintptr_t)type >> 4) % SURVIVOR_TYPES_TABLE;
+        while (table[i].type != NULL && table[i].type != type) {
+            i = (i + 1) % SURVIVOR_TYPES_TABLE;
+        }
+        if (table[i].type == NULL) {
+            if (used == SURVIVOR_TYPES_TABLE * 3 / 4) {
+                continue;
+            }
+            table[i].type = type;
+            used++;
+        }
+        table[i].count++;
+    }
+    event->survivors = survivors;
+
+    for (event->ntypes = 0; event->ntypes < _PyGC_EVENT_TYPES;
+         event->ntypes++)
+    {
+        Py_ssize_t best = -1;
+        for (Py_ssize_t i = 0; i < SURVIVOR_TYPES_TABLE; i++) {
+            if (table[i].count > 0
+                && (best < 0 || table[i].count > table[best].count)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        const char *name = table[best].type->tp_name;
+        size_t len = Py_MIN(strlen(name), _PyGC_EVENT_TYPE_NAME - 1);
+        memcpy(event->types[event->ntypes].name, name, len);
+        event->types[event->ntypes].name[len] = '\0';
+        event->types[event->ntypes].count = table[best].count;
+        table[best].count = 0;
+    }
+}
+
+/* Copy event into the ring buffer, if there is one. */
+static void
+record_event(GCState *gcstate, struct gc_event *event)
+{
+    struct gc_event_buffer *buffer = &gcstate->event_buffer;
+    if (buffer->events == NULL) {
+        return;
+    }
+    event->id = buffer->count;
+    buffer->events[buffer->count % buffer->size] = *event;
+    buffer->count++;
+}
+
+/* Adaptive thresholds.
+ *
+ * The fixed thresholds count allocations of containers, whatever becomes of
+ * them.  A program building a large long-lived structure makes the young
+ * generations collect again and again objects which all survive, and the
+ * oldest generation is examined each time a quarter of its size has been
+ * promoted.  The adaptive policy measures which fraction of the objects
+ * examined by the collections of each generation survive them:
+ *
+ * - when most of them survive, the threshold of the generation is doubled,
+ *   up to ADAPTIVE_MAX_FACTOR times the threshold set by gc.set_threshold(),
+ *   or for the oldest generation the fraction of long_lived_total which
+ *   long_lived_pending must reach is doubled, up to FULL_RATIO_MAX;
+ * - when few of them survive, collections find garbage and the threshold is
+ *   halved back toward its initial value.
+ */
+
+#define ADAPTIVE_MAX_FACTOR 16
+/* Decaying averages of the survival ratio above which thresholds are
+ * raised, and below which they are lowered */
+#define SURVIVAL_HIGH 0.8
+#define SURVIVAL_LOW 0.3
+
+/* Record that `survivors` of the `examined` objects of a collection of
+ * `generation` survived it, and adjust the threshold of the generation with
+ * the adaptive policy. */
+static void
+gc_adapt_thresholds(GCState *gcstate, int generation,
+                    Py_ssize_t survivors, Py_ssize_t examined)
+{
+    struct gc_policy_state *policy = &gcstate->policy;
+    if (examined <= 0) {
+        return;
+    }
+    double ratio = (double)survivors / examined;
+    double *survival = &policy->survival[generation];
+    if (*survival < 0.0) {
+        *survival = ratio;
+    }
+    else {
+        *survival = 0.75 * *survival + 0.25 * ratio;
+    }
+    if (policy->policy != _PyGC_POLICY_ADAPTIVE) {
+        return;
+    }
+
+    if (generation == NUM_GENERATIONS - 1) {
+        if (*survival > SURVIVAL_HIGH && policy->full_ratio < FULL_RATIO_MAX) {
+            policy->full_ratio = Py_MIN(policy->full_ratio * 2,
+                                        FULL_RATIO_MAX);
+            policy->raised++;
+        }
+        else if (*survival < SURVIVAL_LOW && policy->full_ratio > FULL_RATIO) {
+            policy->full_ratio = Py_MAX(policy->full_ratio / 2, FULL_RATIO);
+            policy->lowered++;
+        }
+        return;
+    }
+
+    int base = policy->base_threshold[generation];
+    int *threshold = &gcstate->generations[generation].threshold;
+    if (base <= 0) {
+        /* Collections of this generation are disabled */
+        return;
+    }
+    int max = (base <= INT_MAX / ADAPTIVE_MAX_FACTOR
+               ? base * ADAPTIVE_MAX_FACTOR : INT_MAX);
+    if (*survival > SURVIVAL_HIGH && *threshold < max) {
+        *threshold = (*threshold > max / 2 ? max : *threshold * 2);
+        policy->raised++;
+    }
+    else if (*survival < SURVIVAL_LOW && *threshold > base) {
+        *threshold = Py_MAX(*threshold / 2, base);
+        policy->lowered++;
+    }
+}
+
+/* Reset the thresholds to the values set by gc.set_threshold(). */
+static void
+gc_reset_thresholds(GCState *gcstate)
+{
+    struct gc_policy_state *policy = &gcstate->policy;
+    for (int i = 0; i < NUM_GENERATIONS; i++) {
+        gcstate->generations[i].threshold = policy->base_threshold[i];
+    }
+    policy->full_ratio = FULL_RATIO;
+}
+
+/* This is the main function.  Read this to understand how the
+ * collection process works.  If `incremental` is true, `generation` must be
+ * the oldest generation and only an increment of it is collected. */
+static Py_ssize_t
+gc_collect_main(PyThreadState *tstate, int generation,
+                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
+                int nofail, int incremental)
+{
+    int i;
+    Py_ssize_t m = 0; /* # objects collected */
+    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
+    PyGC_Head *young; /* the generation we are examining */
+    PyGC_Head *old; /* next older generation */
+    PyGC_Head unreachable; /* non-problematic unreachable trash */
+    PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
+    PyGC_Head increment;   /* objects of an incremental collection */
+    PyGC_Head *gc;
+    _PyTime_t t1 = 0;   /* initialize to prevent a compiler warning */
+    _PyTime_t t_increment = 0;
+    Py_ssize_t examined = 0; /* # objects of the oldest generation examined
+                                by an incremental collection */
+    Py_ssize_t survivors;
+    int end_of_pass = 0;
+    GCState *gcstate = &tstate->interp->gc;
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    struct gc_event event_data;
+    struct gc_event *event = NULL;  /* NULL if events are not recorded */
+    _PyTime_t t_phase = 0;
+
+    assert(!incremental || generation == NUM_GENERATIONS - 1);
+
+    // gc_collect_main() must not be called before _PyGC_Init
+    // or after _PyGC_Fini()
+    assert(gcstate->garbage != NULL);
+    assert(!_PyErr_Occurred(tstate));
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (tstate->interp->config._isolated_interpreter) {
+        // bpo-40533: The garbage collector must not be run on parallel on
+        // Python objects shared by multiple interpreters.
+        return 0;
+    }
+#endif
+
+    if (gcstate->debug & DEBUG_STATS) {
+        if (incremental) {
+            PySys_WriteStderr("gc: collecting increment of generation %d...\n",
+                              generation);
+        }
+        else {
+            PySys_WriteStderr("gc: collecting generation %d...\n", generation);
+        }
+        show_stats_each_generations(gcstate);
+        t1 = _PyTime_GetPerfCounter();
+    }
+
+    if (PyDTrace_GC_START_ENABLED())
+        PyDTrace_GC_START(generation);
+
+    if (gcstate->event_buffer.events != NULL) {
+        event = &event_data;
+        memset(event, 0, sizeof(*event));
+        event->generation = generation;
+        event->incremental = incremental;
+        event->start = _PyTime_GetPerfCounter();
+    }
+
+    if (incremental) {
+        t_increment = _PyTime_GetPerfCounter();
+        if (inc->pass_remaining <= 0) {
+            /* Start a new pass over the oldest generation */
+            inc->pass_remaining = (gcstate->long_lived_total
+                                   + gcstate->long_lived_pending);
+            inc->pass_survivors = 0;
+        }
+        for (i = 0; i < generation; i++)
+            gcstate->generations[i].count = 0;
+
+        gc_list_init(&increment);
+        examined = gather_increment(gcstate, &increment,
+                                    Py_MIN(increment_budget(gcstate),
+                                           Py_MAX(inc->pass_remaining,
+                                                  INCREMENT_MIN_BUDGET)));
+        young = &increment;
+        old = GEN_HEAD(gcstate, generation);
+        if (gcstate->debug & DEBUG_STATS) {
+            PySys_WriteStderr(
+                "gc: increment %zd of pass %zd examines %zd old objects, "
+                "%zd left in pass\n",
+                inc->increments + 1, inc->passes + 1, examined,
+                Py_MAX(inc->pass_remaining - examined, 0));
+        }
+    }
+    else {
+        /* update collection and allocation counters */
+        if (generation+1 < NUM_GENERATIONS)
+            gcstate->generations[generation+1].count += 1;
+        for (i = 0; i <= generation; i++)
+            gcstate->generations[i].count = 0;
+
+        /* merge younger generations with one we are currently collecting */
+        for (i = 0; i < generation; i++) {
+            gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+        }
+
+        /* handy references */
+        young = GEN_HEAD(gcstate, generation);
+        if (generation < NUM_GENERATIONS-1)
+            old = GEN_HEAD(gcstate, generation+1);
+        else
+            old = young;
+    }
+    validate_list(old, collecting_clear_unreachable_clear);
+
+    if (gcstate->parallel.threads > 1) {
+        deduce_unreachable_parallel(gcstate, young, &unreachable, event);
+    }
+    else {
+        deduce_unreachable(young, &unreachable, event);
+    }
+    if (event != NULL) {
+        count_survivor_types(young, event);
+    }
+
+    untrack_tuples(young);
+    survivors = gc_list_size(young);
     /* Move reachable objects to next generation. */
-    if (young != old) {
+    if (incremental) {
+        /* Survivors are appended to the tail of the oldest generation, after
+         * the objects which the current pass has not examined yet. */
+        inc->pass_survivors += survivors;
+        inc->pass_remaining -= examined;
+        if (inc->pass_remaining <= 0) {
+            end_of_pass = 1;
+            gcstate->long_lived_pending = 0;
+            gcstate->long_lived_total = inc->pass_survivors;
+        }
+        gc_list_merge(young, old);
+    }
+    else if (young != old) {
         if (generation == NUM_GENERATIONS - 2) {
-            gcstate->long_lived_pending += gc_list_size(young);
+            gcstate->long_lived_pending += survivors;
         }
         gc_list_merge(young, old);
     }
@@ -1250,7 +2182,9 @@ gc_collect_main(PyThreadState *tstate, int generation,
            dict build-up. See issue #14775. */
         untrack_dicts(young);
         gcstate->long_lived_pending = 0;
-        gcstate->long_lived_total = gc_list_size(young);
+        gcstate->long_lived_total = survivors;
+        /* A full collection restarts the pass of increments */
+        inc->pass_remaining = 0;
     }
 
     /* All objects in unreachable are trash, but objects reachable from
@@ -1277,7 +2211,11 @@ gc_collect_main(PyThreadState *tstate, int generation,
     }
 
     /* Clear weakrefs and invoke callbacks as necessary. */
+    if (event != NULL) {
+        t_phase = _PyTime_GetPerfCounter();
+    }
     m += handle_weakrefs(&unreachable, old);
+    event_phase_end(event, _PyGC_PHASE_WEAKREFS, &t_phase);
 
     validate_list(old, collecting_clear_unreachable_clear);
     validate_list(&unreachable, collecting_set_unreachable_clear);
@@ -1290,6 +2228,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
      * objects that are still unreachable */
     PyGC_Head final_unreachable;
     handle_resurrected_objects(&unreachable, &final_unreachable, old);
+    event_phase_end(event, _PyGC_PHASE_FINALIZERS, &t_phase);
 
     /* Call tp_clear on objects in the final_unreachable set.  This will cause
     * the reference cycles to be broken.  It may also cause some objects
@@ -1297,6 +2236,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
     */
     m += gc_list_size(&final_unreachable);
     delete_garbage(tstate, gcstate, &final_unreachable, old);
+    event_phase_end(event, _PyGC_PHASE_DELETE_GARBAGE, &t_phase);
 
     /* Collect statistics on uncollectable objects found and print
      * debugging information. */
@@ -1320,11 +2260,31 @@ gc_collect_main(PyThreadState *tstate, int generation,
     validate_list(old, collecting_clear_unreachable_clear);
 
     /* Clear free list only during the collection of the highest
-     * generation */
-    if (generation == NUM_GENERATIONS-1) {
+     * generation, or at the end of a pass of increments */
+    if (incremental ? end_of_pass : generation == NUM_GENERATIONS-1) {
         clear_freelists(tstate->interp);
     }
 
+    if (incremental) {
+        /* Update the estimated number of objects examined per second */
+        Py_ssize_t size = examined + (n + m);
+        double elapsed = _PyTime_AsSecondsDouble(
+            _PyTime_GetPerfCounter() - t_increment);
+        if (elapsed > 0.0 && size >= INCREMENT_MIN_BUDGET) {
+            double rate = size / elapsed;
+            if (inc->scan_rate > 0.0) {
+                inc->scan_rate = 0.75 * inc->scan_rate + 0.25 * rate;
+            }
+            else {
+                inc->scan_rate = rate;
+            }
+        }
+        inc->increments++;
+        if (end_of_pass) {
+            inc->passes++;
+        }
+    }
+
     if (_PyErr_Occurred(tstate)) {
         if (nofail) {
             _PyErr_Clear(tstate);
@@ -1346,6 +2306,16 @@ gc_collect_main(PyThreadState *tstate, int generation,
     stats->collections++;
     stats->collected += m;
     stats->uncollectable += n;
+    if (!incremental) {
+        gc_adapt_thresholds(gcstate, generation, survivors, survivors + m + n);
+    }
+
+    if (event != NULL) {
+        event->collected = m;
+        event->uncollectable = n;
+        event->duration = _PyTime_GetPerfCounter() - event->start;
+        record_event(gcstate, event);
+    }
 
     if (PyDTrace_GC_DONE_ENABLED()) {
         PyDTrace_GC_DONE(n + m);
@@ -1409,7 +2379,26 @@ gc_collect_with_callback(PyThreadState *tstate, int generation)
     assert(!_PyErr_Occurred(tstate));
     Py_ssize_t result, collected, uncollectable;
     invoke_gc_callback(tstate, "start", generation, 0, 0);
-    result = gc_collect_main(tstate, generation, &collected, &uncollectable, 0);
+    result = gc_collect_main(tstate, generation, &collected, &uncollectable,
+                             0, 0);
+    invoke_gc_callback(tstate, "stop", generation, collected, uncollectable);
+    assert(!_PyErr_Occurred(tstate));
+    return result;
+}
+
+/* Perform an incremental collection of the oldest generation and invoke
+ * progress callbacks.  Callbacks and statistics report it as a collection
+ * of the oldest generation.
+ */
+static Py_ssize_t
+gc_collect_increment(PyThreadState *tstate)
+{
+    assert(!_PyErr_Occurred(tstate));
+    int generation = NUM_GENERATIONS - 1;
+    Py_ssize_t result, collected, uncollectable;
+    invoke_gc_callback(tstate, "start", generation, 0, 0);
+    result = gc_collect_main(tstate, generation, &collected, &uncollectable,
+                             0, 1);
     invoke_gc_callback(tstate, "stop", generation, collected, uncollectable);
     assert(!_PyErr_Occurred(tstate));
     return result;
@@ -1460,10 +2449,24 @@ gc_collect_generations(PyThreadState *tstate)
                This heuristic was suggested by Martin von Löwis on python-dev in
                June 2008. His original analysis and proposal can be found at:
                http://mail.python.org/pipermail/python-dev/2008-June/080579.html
+
+               The adaptive policy raises the ratio when full collections
+               find little garbage (see gc_adapt_thresholds()).
             */
             if (i == NUM_GENERATIONS - 1
-                && gcstate->long_lived_pending < gcstate->long_lived_total / 4)
+                && gcstate->long_lived_pending
+                   < (Py_ssize_t)(gcstate->long_lived_total
+                                  * gcstate->policy.full_ratio))
                 continue;
+            if (gcstate->incremental.pause_target > 0.0
+                && i >= NUM_GENERATIONS - 2)
+            {
+                /* With a pause target, the oldest generation is collected
+                   by increments in place of the collections of the middle
+                   generation, and fully only by gc.collect(). */
+                n = gc_collect_increment(tstate);
+                break;
+            }
             n = gc_collect_with_callback(tstate, i);
             break;
         }
@@ -1604,15 +2607,16 @@ static PyObject *
 gc_set_threshold(PyObject *self, PyObject *args)
 {
     GCState *gcstate = get_gc_state();
+    int *base = gcstate->policy.base_threshold;
     if (!PyArg_ParseTuple(args, "i|ii:set_threshold",
-                          &gcstate->generations[0].threshold,
-                          &gcstate->generations[1].threshold,
-                          &gcstate->generations[2].threshold))
+                          &base[0], &base[1], &base[2]))
         return NULL;
     for (int i = 3; i < NUM_GENERATIONS; i++) {
         /* generations higher than 2 get the same threshold */
-        gcstate->generations[i].threshold = gcstate->generations[2].threshold;
+        base[i] = base[2];
     }
+    /* The adaptive policy starts again from the new thresholds */
+    gc_reset_thresholds(gcstate);
     Py_RETURN_NONE;
 }
 
@@ -1633,6 +2637,389 @@ gc_get_threshold_impl(PyObject *module)
                          gcstate->generations[2].threshold);
 }
 
+/* Names of the threshold policies, indexed by their value */
+static const char * const policy_names[] = {"fixed", "adaptive"};
+
+/*[clinic input]
+gc.set_policy
+
+    policy: str
+    /
+
+Select how the collection thresholds are chosen.
+
+With the "fixed" policy, the thresholds are those set by set_threshold().
+With the "adaptive" policy, the threshold of each generation is raised when
+most of the objects its collections examine survive them, and lowered back
+toward the value set by set_threshold() when they find garbage.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_policy_impl(PyObject *module, const char *policy)
+/*[clinic end generated code: output=d6b685ed44a37614 input=8b1bc12cc057dbba]*/
+{
+    GCState *gcstate = get_gc_state();
+    for (int i = 0; i < (int)Py_ARRAY_LENGTH(policy_names); i++) {
+        if (strcmp(policy, policy_names[i]) == 0) {
+            if (gcstate->policy.policy != i) {
+                gcstate->policy.policy = i;
+                gc_reset_thresholds(gcstate);
+            }
+            Py_RETURN_NONE;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "unknown gc policy: %s", policy);
+    return NULL;
+}
+
+/*[clinic input]
+gc.get_policy
+
+Return the name of the policy choosing the collection thresholds.
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_policy_impl(PyObject *module)
+/*[clinic end generated code: output=f948d0eb5d51b054 input=de05cd7e53a859bd]*/
+{
+    GCState *gcstate = get_gc_state();
+    return PyUnicode_FromString(policy_names[gcstate->policy.policy]);
+}
+
+/*[clinic input]
+gc.get_policy_stats
+
+Return a dictionary of statistics about the collection thresholds.
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_policy_stats_impl(PyObject *module)
+/*[clinic end generated code: output=593ef41e2ef52943 input=aeedfc61bcd8eb58]*/
+{
+    GCState *gcstate = get_gc_state();
+    struct gc_policy_state *policy = &gcstate->policy;
+    PyObject *survival = PyTuple_New(NUM_GENERATIONS);
+    if (survival == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < NUM_GENERATIONS; i++) {
+        PyObject *ratio;
+        if (policy->survival[i] < 0.0) {
+            ratio = Py_NewRef(Py_None);
+        }
+        else {
+            ratio = PyFloat_FromDouble(policy->survival[i]);
+            if (ratio == NULL) {
+                Py_DECREF(survival);
+                return NULL;
+            }
+        }
+        PyTuple_SET_ITEM(survival, i, ratio);
+    }
+    return Py_BuildValue("{sss(iii)s(iii)sNsdsnsnsnsn}",
+                         "policy", policy_names[policy->policy],
+                         "thresholds",
+                         gcstate->generations[0].threshold,
+                         gcstate->generations[1].threshold,
+                         gcstate->generations[2].threshold,
+                         "base_thresholds",
+                         policy->base_threshold[0],
+                         policy->base_threshold[1],
+                         policy->base_threshold[2],
+                         "survival", survival,
+                         "full_ratio", policy->full_ratio,
+                         "raised", policy->raised,
+                         "lowered", policy->lowered,
+                         "long_lived_total", gcstate->long_lived_total,
+                         "long_lived_pending", gcstate->long_lived_pending);
+}
+
+/*[clinic input]
+gc.set_pause_target
+
+    seconds: double
+    /
+
+Set the target duration of the collections of the oldest generation.
+
+If seconds is greater than zero, the oldest generation is collected
+incrementally: each collection of the middle generation also collects a
+part of the oldest generation that takes about seconds to examine.  Only
+gc.collect() collects the oldest generation in one pass.  Zero disables
+incremental collection.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_pause_target_impl(PyObject *module, double seconds)
+/*[clinic end generated code: output=6c64c6c408aaa6f1 input=c93e9d71790f1848]*/
+{
+    if (!(seconds >= 0.0)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "pause target must be a non-negative number");
+        return NULL;
+    }
+    GCState *gcstate = get_gc_state();
+    if (gcstate->incremental.pause_target == 0.0) {
+        gcstate->incremental.pass_remaining = 0;
+    }
+    gcstate->incremental.pause_target = seconds;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_pause_target -> double
+
+Return the target duration of the collections of the oldest generation.
+
+Zero means that incremental collection is disabled.
+[clinic start generated code]*/
+
+static double
+gc_get_pause_target_impl(PyObject *module)
+/*[clinic end generated code: output=f4f3c334d92a8021 input=0c5b44045d87e3d0]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->incremental.pause_target;
+}
+
+/*[clinic input]
+gc.set_parallel
+
+    threads: int
+    /
+
+Set the number of threads examining the objects of large collections.
+
+1 makes collections serial.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_parallel_impl(PyObject *module, int threads)
+/*[clinic end generated code: output=eb1b216ff80032f6 input=43cca7a96be120c7]*/
+{
+    if (threads < 1 || threads > PARALLEL_MAX_THREADS) {
+        PyErr_Format(PyExc_ValueError,
+                     "number of threads must be in range 1..%d",
+                     PARALLEL_MAX_THREADS);
+        return NULL;
+    }
+    GCState *gcstate = get_gc_state();
+    struct gc_parallel_state *par = &gcstate->parallel;
+    if (threads == par->threads) {
+        Py_RETURN_NONE;
+    }
+#ifdef _Py_HAVE_ATOMIC_RMW
+    struct gc_parallel_pool *pool = NULL;
+    if (threads > 1) {
+        pool = parallel_pool_start(threads - 1);
+        if (pool == NULL) {
+            return NULL;
+        }
+    }
+    if (par->pool != NULL) {
+        parallel_pool_stop(par->pool);
+    }
+    par->pool = pool;
+#endif
+    par->threads = threads;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_parallel -> int
+
+Return the number of threads examining the objects of large collections.
+[clinic start generated code]*/
+
+static int
+gc_get_parallel_impl(PyObject *module)
+/*[clinic end generated code: output=5b8b3265d5cdfb34 input=71772ac02fe8d6e8]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->parallel.threads;
+}
+
+/*[clinic input]
+gc.get_parallel_stats
+
+Return a dictionary of statistics about parallel collections.
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_parallel_stats_impl(PyObject *module)
+/*[clinic end generated code: output=bdc0714efc1df08c input=7104a1291341258c]*/
+{
+    GCState *gcstate = get_gc_state();
+    struct gc_parallel_state *par = &gcstate->parallel;
+    double wall_time = _PyTime_AsSecondsDouble(par->wall_time);
+    double work_time = _PyTime_AsSecondsDouble(par->work_time);
+    return Py_BuildValue("{snsdsdsd}",
+                         "collections", par->collections,
+                         "wall_time", wall_time,
+                         "work_time", work_time,
+                         "time_saved", Py_MAX(work_time - wall_time, 0.0));
+}
+
+/*[clinic input]
+gc.set_event_buffer
+
+    size: Py_ssize_t
+    /
+
+Record the last size collections in a ring buffer read by get_events().
+
+Zero disables recording.  Events already recorded are discarded.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_event_buffer_impl(PyObject *module, Py_ssize_t size)
+/*[clinic end generated code: output=447535aa020c2826 input=caffc065f4b98995]*/
+{
+    if (size < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "event buffer size must be non-negative");
+        return NULL;
+    }
+    struct gc_event *events = NULL;
+    if (size > 0) {
+        events = PyMem_Calloc(size, sizeof(struct gc_event));
+        if (events == NULL) {
+            return PyErr_NoMemory();
+        }
+    }
+    GCState *gcstate = get_gc_state();
+    struct gc_event_buffer *buffer = &gcstate->event_buffer;
+    PyMem_Free(buffer->events);
+    buffer->events = events;
+    buffer->size = size;
+    buffer->count = 0;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_event_buffer -> Py_ssize_t
+
+Return the size of the ring buffer of collection events.
+[clinic start generated code]*/
+
+static Py_ssize_t
+gc_get_event_buffer_impl(PyObject *module)
+/*[clinic end generated code: output=dce043ada0902692 input=30efcbdc50db290a]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->event_buffer.size;
+}
+
+static const char * const gc_phase_names[_PyGC_NPHASES] = {
+    [_PyGC_PHASE_UPDATE_REFS] = "update_refs",
+    [_PyGC_PHASE_SUBTRACT_REFS] = "subtract_refs",
+    [_PyGC_PHASE_MOVE_UNREACHABLE] = "move_unreachable",
+    [_PyGC_PHASE_WEAKREFS] = "weakrefs",
+    [_PyGC_PHASE_FINALIZERS] = "finalizers",
+    [_PyGC_PHASE_DELETE_GARBAGE] = "delete_garbage",
+};
+
+static PyObject *
+event_as_dict(struct gc_event *event)
+{
+    PyObject *phases = PyDict_New();
+    if (phases == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _PyGC_NPHASES; i++) {
+        PyObject *value = PyFloat_FromDouble(
+            _PyTime_AsSecondsDouble(event->phases[i]));
+        if (value == NULL
+            || PyDict_SetItemString(phases, gc_phase_names[i], value) < 0)
+        {
+            Py_XDECREF(value);
+            Py_DECREF(phases);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+
+    PyObject *types = PyList_New(event->ntypes);
+    if (types == NULL) {
+        Py_DECREF(phases);
+        return NULL;
+    }
+    for (int i = 0; i < event->ntypes; i++) {
+        PyObject *item = Py_BuildValue("(sn)", event->types[i].name,
+                                       event->types[i].count);
+        if (item == NULL) {
+            Py_DECREF(phases);
+            Py_DECREF(types);
+            return NULL;
+        }
+        PyList_SET_ITEM(types, i, item);
+    }
+
+    return Py_BuildValue("{snsisOsdsdsnsnsnsnsNsN}",
+                         "id", event->id,
+                         "generation", event->generation,
+                         "incremental",
+                         event->incremental ? Py_True : Py_False,
+                         "start", _PyTime_AsSecondsDouble(event->start),
+                         "duration", _PyTime_AsSecondsDouble(event->duration),
+                         "examined", event->examined,
+                         "collected", event->collected,
+                         "uncollectable", event->uncollectable,
+                         "survivors", event->survivors,
+                         "phases", phases,
+                         "survivor_types", types);
+}
+
+/*[clinic input]
+gc.get_events
+
+    start: Py_ssize_t = 0
+
+Return the events recorded in the ring buffer, as a list of dictionaries.
+
+Only return the events whose id is greater than or equal to start.
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_events_impl(PyObject *module, Py_ssize_t start)
+/*[clinic end generated code: output=39ecf3984bd3b0c1 input=c6b1e5c38f62cb13]*/
+{
+    GCState *gcstate = get_gc_state();
+    struct gc_event_buffer *buffer = &gcstate->event_buffer;
+
+    /* Copy the events first: creating the dictionaries can trigger a
+     * collection, which overwrites the oldest event. */
+    Py_ssize_t first = Py_MAX(Py_MAX(buffer->count - buffer->size, start), 0);
+    Py_ssize_t n = Py_MAX(buffer->count - first, 0);
+    struct gc_event *events = NULL;
+    if (n > 0) {
+        events = PyMem_New(struct gc_event, n);
+        if (events == NULL) {
+            return PyErr_NoMemory();
+        }
+        for (Py_ssize_t i = 0; i < n; i++) {
+            events[i] = buffer->events[(first + i) % buffer->size];
+        }
+    }
+
+    PyObject *result = PyList_New(n);
+    if (result == NULL) {
+        goto done;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = event_as_dict(&events[i]);
+        if (item == NULL) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+done:
+    PyMem_Free(events);
+    return result;
+}
+
 /*[clinic input]
 gc.get_count
 
@@ -1902,25 +3289,192 @@ gc_is_finalized(PyObject *module, PyObject *obj)
     Py_RETURN_FALSE;
 }
 
+/* Stack of the untracked containers whose referents must be made immortal
+ * by gc.freeze(immortal=True). */
+struct immortal_stack {
+    PyObject **items;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+};
+
+static int
+immortal_stack_push(struct immortal_stack *stack, PyObject *op)
+{
+    if (stack->size == stack->allocated) {
+        Py_ssize_t allocated = Py_MAX(64, stack->allocated * 2);
+        PyObject **items = PyMem_Realloc(stack->items,
+                                         allocated * sizeof(PyObject *));
+        if (items == NULL) {
+            return -1;
+        }
+        stack->items = items;
+        stack->allocated = allocated;
+    }
+    stack->items[stack->size++] = op;
+    return 0;
+}
+
+/* Make an object referenced by an immortal object immortal.  Tracked objects
+ * are left to the caller, which walks all the generations; the referents of
+ * an untracked container are handled when it is popped from the stack. */
+static int
+visit_immortalize(PyObject *op, struct immortal_stack *stack)
+{
+    if (_Py_IsImmortal(op)) {
+        return 0;
+    }
+    if (PyType_Check(op)
+        && !_PyType_HasFeature((PyTypeObject *)op, Py_TPFLAGS_HEAPTYPE))
+    {
+        /* Static types are never deallocated, but some code relies on
+           their reference count when they are initialized. */
+        return 0;
+    }
+    if (_PyObject_IS_GC(op)) {
+        if (_PyObject_GC_IS_TRACKED(op)) {
+            return 0;
+        }
+        if (immortal_stack_push(stack, op) < 0) {
+            return -1;
+        }
+    }
+    _Py_SetImmortal(op);
+    return 0;
+}
+
+/* Make the objects of a generation immortal, with the objects they reference
+ * through tp_traverse.  Return -1 on memory error. */
+static int
+immortalize_generation(PyGC_Head *head, struct immortal_stack *stack)
+{
+    for (PyGC_Head *gc = GC_NEXT(head); gc != head; gc = GC_NEXT(gc)) {
+        PyObject *op = FROM_GC(gc);
+        if (!_Py_IsImmortal(op)) {
+            _Py_SetImmortal(op);
+        }
+        traverseproc traverse = Py_TYPE(op)->tp_traverse;
+        if (traverse(op, (visitproc)visit_immortalize, stack) < 0) {
+            return -1;
+        }
+        while (stack->size > 0) {
+            op = stack->items[--stack->size];
+            traverse = Py_TYPE(op)->tp_traverse;
+            if (traverse(op, (visitproc)visit_immortalize, stack) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+/* Make an object reachable from a shared object immortal, and push it on the
+ * stack so that its own referents are visited. */
+static int
+visit_share(PyObject *op, struct immortal_stack *stack)
+{
+    if (op == NULL || _Py_IsImmortal(op)) {
+        return 0;
+    }
+    if (immortal_stack_push(stack, op) < 0) {
+        return -1;
+    }
+    _Py_SetImmortal(op);
+    /* The collectors of the interpreters run in parallel: none of them
+       may write to the GC header of a shared object. */
+    if (_PyObject_IS_GC(op) && _PyObject_GC_IS_TRACKED(op)) {
+        _PyObject_GC_UNTRACK(op);
+    }
+    return 0;
+}
+
+/* Make op, its type and all the objects reachable from them immortal and
+ * untracked, so that interpreters running in parallel can share them.  The
+ * caller must hold the GIL of the interpreter which created op.  Return -1
+ * on memory error, without setting an exception. */
+int
+_PyGC_ShareObject(PyObject *op)
+{
+    struct immortal_stack stack = {NULL, 0, 0};
+    int err = visit_share(op, &stack);
+    while (err == 0 && stack.size > 0) {
+        op = stack.items[--stack.size];
+        err = visit_share((PyObject *)Py_TYPE(op), &stack);
+        if (err < 0) {
+            break;
+        }
+        if (PyType_Check(op)
+            && !_PyType_HasFeature((PyTypeObject *)op, Py_TPFLAGS_HEAPTYPE))
+        {
+            /* type_traverse() only supports heap types.  tp_subclasses is
+               left out: only the main interpreter registers subclasses of
+               static types. */
+            PyTypeObject *type = (PyTypeObject *)op;
+            err = visit_share(type->tp_dict, &stack);
+            if (err == 0) {
+                err = visit_share(type->tp_mro, &stack);
+            }
+            if (err == 0) {
+                err = visit_share(type->tp_bases, &stack);
+            }
+        }
+        else if (_PyObject_IS_GC(op)) {
+            traverseproc traverse = Py_TYPE(op)->tp_traverse;
+            err = traverse(op, (visitproc)visit_share, &stack);
+        }
+    }
+    PyMem_Free(stack.items);
+    return err;
+}
+#endif
+
 /*[clinic input]
 gc.freeze
 
+    *
+    immortal: bool(accept={int}) = False
+
 Freeze all current tracked objects and ignore them for future collections.
 
 This can be used before a POSIX fork() call to make the gc copy-on-write friendly.
 Note: collection before a POSIX fork() call may free pages for future allocation
 which can cause copy-on-write.
+
+If immortal is true, the frozen objects, the objects they reference and the
+interned strings also become immortal: their reference count is no longer
+updated and they are never deallocated, so that using them in a child
+process doesn't write to the pages they occupy.
 [clinic start generated code]*/
 
 static PyObject *
-gc_freeze_impl(PyObject *module)
-/*[clinic end generated code: output=502159d9cdc4c139 input=b602b16ac5febbe5]*/
+gc_freeze_impl(PyObject *module, int immortal)
+/*[clinic end generated code: output=42dc7e62f9e59ad3 input=f7d6bf7809e10d82]*/
 {
     GCState *gcstate = get_gc_state();
+    int err = 0;
+    if (immortal) {
+        struct immortal_stack stack = {NULL, 0, 0};
+        for (int i = 0; i < NUM_GENERATIONS && err == 0; ++i) {
+            err = immortalize_generation(GEN_HEAD(gcstate, i), &stack);
+        }
+        if (err == 0) {
+            err = immortalize_generation(
+                &gcstate->permanent_generation.head, &stack);
+        }
+        PyMem_Free(stack.items);
+        if (err == 0) {
+            _PyUnicode_ImmortalizeInterned(_PyInterpreterState_GET());
+        }
+    }
+    /* Objects which are already immortal must leave the generations even
+       on error: collecting them would write to their header. */
     for (int i = 0; i < NUM_GENERATIONS; ++i) {
         gc_list_merge(GEN_HEAD(gcstate, i), &gcstate->permanent_generation.head);
         gcstate->generations[i].count = 0;
     }
+    if (err < 0) {
+        return PyErr_NoMemory();
+    }
     Py_RETURN_NONE;
 }
 
@@ -1930,15 +3484,24 @@ gc.unfreeze
 Unfreeze all objects in the permanent generation.
 
 Put all objects in the permanent generation back into oldest generation.
+Immortal objects stay in the permanent generation.
 [clinic start generated code]*/
 
 static PyObject *
 gc_unfreeze_impl(PyObject *module)
-/*[clinic end generated code: output=1c15f2043b25e169 input=2dd52b170f4cef6c]*/
+/*[clinic end generated code: output=1c15f2043b25e169 input=86475259914c549b]*/
 {
     GCState *gcstate = get_gc_state();
-    gc_list_merge(&gcstate->permanent_generation.head,
-                  GEN_HEAD(gcstate, NUM_GENERATIONS-1));
+    PyGC_Head *permanent = &gcstate->permanent_generation.head;
+    PyGC_Head *oldest = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    PyGC_Head *gc = GC_NEXT(permanent);
+    while (gc != permanent) {
+        PyGC_Head *next = GC_NEXT(gc);
+        if (!_Py_IsImmortal(FROM_GC(gc))) {
+            gc_list_move(gc, oldest);
+        }
+        gc = next;
+    }
     Py_RETURN_NONE;
 }
 
@@ -1970,6 +3533,17 @@ PyDoc_STRVAR(gc__doc__,
 "get_debug() -- Get debugging flags.\n"
 "set_threshold() -- Set the collection thresholds.\n"
 "get_threshold() -- Return the current the collection thresholds.\n"
+"set_policy() -- Select how the collection thresholds are chosen.\n"
+"get_policy() -- Return the policy choosing the collection thresholds.\n"
+"get_policy_stats() -- Return statistics about the collection thresholds.\n"
+"set_pause_target() -- Set the pause target of incremental collection.\n"
+"get_pause_target() -- Return the pause target of incremental collection.\n"
+"set_parallel() -- Set the number of threads of large collections.\n"
+"get_parallel() -- Return the number of threads of large collections.\n"
+"get_parallel_stats() -- Return statistics about parallel collections.\n"
+"set_event_buffer() -- Set the size of the ring buffer of collection events.\n"
+"get_event_buffer() -- Return the size of the ring buffer of events.\n"
+"get_events() -- Return the events recorded in the ring buffer.\n"
 "get_objects() -- Return a list of all objects tracked by the collector.\n"
 "is_tracked() -- Returns true if a given object is tracked.\n"
 "is_finalized() -- Returns true if a given object has been already finalized.\n"
@@ -1988,6 +3562,17 @@ static PyMethodDef GcMethods[] = {
     GC_GET_COUNT_METHODDEF
     {"set_threshold",  gc_set_threshold, METH_VARARGS, gc_set_thresh__doc__},
     GC_GET_THRESHOLD_METHODDEF
+    GC_SET_POLICY_METHODDEF
+    GC_GET_POLICY_METHODDEF
+    GC_GET_POLICY_STATS_METHODDEF
+    GC_SET_PAUSE_TARGET_METHODDEF
+    GC_GET_PAUSE_TARGET_METHODDEF
+    GC_SET_PARALLEL_METHODDEF
+    GC_GET_PARALLEL_METHODDEF
+    GC_GET_PARALLEL_STATS_METHODDEF
+    GC_SET_EVENT_BUFFER_METHODDEF
+    GC_GET_EVENT_BUFFER_METHODDEF
+    GC_GET_EVENTS_METHODDEF
     GC_COLLECT_METHODDEF
     GC_GET_OBJECTS_METHODDEF
     GC_GET_STATS_METHODDEF
@@ -2119,7 +3704,7 @@ _PyGC_CollectNoFail(PyThreadState *tstate)
 
     Py_ssize_t n;
     gcstate->collecting = 1;
-    n = gc_collect_main(tstate, NUM_GENERATIONS - 1, NULL, NULL, 1);
+    n = gc_collect_main(tstate, NUM_GENERATIONS - 1, NULL, NULL, 1, 0);
     gcstate->collecting = 0;
     return n;
 }
@@ -2167,6 +3752,35 @@ _PyGC_Fini(PyInterpreterState *interp)
     GCState *gcstate = &interp->gc;
     Py_CLEAR(gcstate->garbage);
     Py_CLEAR(gcstate->callbacks);
+#ifdef _Py_HAVE_ATOMIC_RMW
+    if (gcstate->parallel.pool != NULL) {
+        parallel_pool_stop(gcstate->parallel.pool);
+        gcstate->parallel.pool = NULL;
+    }
+#endif
+    PyMem_Free(gcstate->event_buffer.events);
+    gcstate->event_buffer.events = NULL;
+    gcstate->event_buffer.size = 0;
+}
+
+/* Called in the child process after fork(): the threads of the pool only
+ * exist in the parent, so start them again. */
+void
+_PyGC_AfterFork(PyInterpreterState *interp)
+{
+#ifdef _Py_HAVE_ATOMIC_RMW
+    struct gc_parallel_state *par = &interp->gc.parallel;
+    if (par->pool == NULL) {
+        return;
+    }
+    /* The mutex and condition variables may be in any state */
+    parallel_pool_free(par->pool);
+    par->pool = parallel_pool_start(par->threads - 1);
+    if (par->pool == NULL) {
+        PyErr_Clear();
+        par->threads = 1;
+    }
+#endif
 }
 
 /* for debugging */
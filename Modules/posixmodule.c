@@ -23,6 +23,7 @@
 #endif
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
 #include "pycore_fileutils.h"     // _Py_closerange()
+#include "pycore_gc.h"            // _PyGC_AfterFork()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_ceval.h"         // _PyEval_ReInitThreads()
 #include "pycore_import.h"        // _PyImport_ReInitLock()
@@ -575,6 +576,8 @@ PyOS_AfterFork_Child(void)
     PyStatus status;
     _PyRuntimeState *runtime = &_PyRuntime;
 
+    runtime->fork_generation++;
+
     status = _PyGILState_Reinit(runtime);
     if (_PyStatus_EXCEPTION(status)) {
         goto fatal_error;
@@ -606,6 +609,8 @@ PyOS_AfterFork_Child(void)
     }
     assert(_PyThreadState_GET() == tstate);
 
+    _PyGC_AfterFork(tstate->interp);
+
     run_at_forkers(tstate->interp->after_forkers_child, 0);
     return;
 
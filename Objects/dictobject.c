@@ -263,19 +263,110 @@ _PyDict_ClearFreeList(PyInterpreterState *interp)
     while (state->keys_numfree) {
         PyObject_Free(state->keys_free_list[--state->keys_numfree]);
     }
+    _PyFreeList_Decay(&state->freelist);
+    _PyFreeList_Decay(&state->keys_freelist);
 #endif
 }
 
 
+#if PyDict_MAXFREELIST > 0
+/* Make room for the current capacity of the free lists.  On memory
+   allocation failure, lower the capacity to the allocated size and
+   return -1. */
+static int
+dict_freelist_resize(struct _Py_dict_state *state)
+{
+    int capacity = state->freelist.capacity;
+    if (capacity > state->allocated_free_list) {
+        PyDictObject **items = PyMem_Realloc(state->free_list,
+                                             capacity * sizeof(PyDictObject *));
+        if (items == NULL) {
+            state->freelist.capacity = state->allocated_free_list;
+            return -1;
+        }
+        state->free_list = items;
+        state->allocated_free_list = capacity;
+    }
+    return 0;
+}
+
+static int
+keys_freelist_resize(struct _Py_dict_state *state)
+{
+    int capacity = state->keys_freelist.capacity;
+    if (capacity > state->allocated_keys_free_list) {
+        PyDictKeysObject **items;
+        items = PyMem_Realloc(state->keys_free_list,
+                              capacity * sizeof(PyDictKeysObject *));
+        if (items == NULL) {
+            state->keys_freelist.capacity = state->allocated_keys_free_list;
+            return -1;
+        }
+        state->keys_free_list = items;
+        state->allocated_keys_free_list = capacity;
+    }
+    return 0;
+}
+
+/* Called when a free list is full.  Return 1 if the adaptive free list
+   grew, 0 otherwise. */
+static int
+dict_freelist_overflow(struct _Py_dict_state *state)
+{
+    if (!_PyFreeList_Overflow(&state->freelist)) {
+        return 0;
+    }
+    return dict_freelist_resize(state) == 0;
+}
+
+static int
+keys_freelist_overflow(struct _Py_dict_state *state)
+{
+    if (!_PyFreeList_Overflow(&state->keys_freelist)) {
+        return 0;
+    }
+    return keys_freelist_resize(state) == 0;
+}
+#endif
+
+
+int
+_PyDict_InitFreeList(PyInterpreterState *interp, int capacity, int adaptive)
+{
+#if PyDict_MAXFREELIST > 0
+    struct _Py_dict_state *state = &interp->dict_state;
+    if (capacity < 0) {
+        capacity = PyDict_MAXFREELIST;
+    }
+    _PyFreeList_Init(&state->freelist, capacity, adaptive);
+    _PyFreeList_Init(&state->keys_freelist, capacity, adaptive);
+    if (dict_freelist_resize(state) < 0 || keys_freelist_resize(state) < 0) {
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+
 void
 _PyDict_Fini(PyInterpreterState *interp)
 {
     _PyDict_ClearFreeList(interp);
-#if defined(Py_DEBUG) && PyDict_MAXFREELIST > 0
+#if PyDict_MAXFREELIST > 0
     struct _Py_dict_state *state = &interp->dict_state;
+    PyMem_Free(state->free_list);
+    state->free_list = NULL;
+    state->allocated_free_list = 0;
+    state->freelist.capacity = 0;
+    PyMem_Free(state->keys_free_list);
+    state->keys_free_list = NULL;
+    state->allocated_keys_free_list = 0;
+    state->keys_freelist.capacity = 0;
+#ifdef Py_DEBUG
     state->numfree = -1;
     state->keys_numfree = -1;
 #endif
+#endif
 }
 
 
@@ -287,6 +378,8 @@ _PyDict_DebugMallocStats(FILE *out)
     struct _Py_dict_state *state = get_dict_state();
     _PyDebugAllocatorStats(out, "free PyDictObject",
                            state->numfree, sizeof(PyDictObject));
+    _PyFreeList_DebugStats(out, "dict", &state->freelist);
+    _PyFreeList_DebugStats(out, "dict keys", &state->keys_freelist);
 #endif
 }
 
@@ -584,10 +677,16 @@ new_keys_object(uint8_t log2_size)
 #endif
     if (log2_size == PyDict_LOG_MINSIZE && state->keys_numfree > 0) {
         dk = state->keys_free_list[--state->keys_numfree];
+        _PyFreeList_Hit(&state->keys_freelist);
     }
     else
 #endif
     {
+#if PyDict_MAXFREELIST > 0
+        if (log2_size == PyDict_LOG_MINSIZE) {
+            _PyFreeList_Miss(&state->keys_freelist);
+        }
+#endif
         dk = PyObject_Malloc(sizeof(PyDictKeysObject)
                              + (es<<log2_size)
                              + sizeof(PyDictKeyEntry) * usable);
@@ -625,7 +724,10 @@ free_keys_object(PyDictKeysObject *keys)
     // free_keys_object() must not be called after _PyDict_Fini()
     assert(state->keys_numfree != -1);
 #endif
-    if (DK_SIZE(keys) == PyDict_MINSIZE && state->keys_numfree < PyDict_MAXFREELIST) {
+    if (DK_SIZE(keys) == PyDict_MINSIZE
+        && (state->keys_numfree < state->keys_freelist.capacity
+            || keys_freelist_overflow(state)))
+    {
         state->keys_free_list[state->keys_numfree++] = keys;
         return;
     }
@@ -659,10 +761,14 @@ new_dict(PyDictKeysObject *keys, PyDictValues *values, Py_ssize_t used, int free
         assert (mp != NULL);
         assert (Py_IS_TYPE(mp, &PyDict_Type));
         _Py_NewReference((PyObject *)mp);
+        _PyFreeList_Hit(&state->freelist);
     }
     else
 #endif
     {
+#if PyDict_MAXFREELIST > 0
+        _PyFreeList_Miss(&state->freelist);
+#endif
         mp = PyObject_GC_New(PyDictObject, &PyDict_Type);
         if (mp == NULL) {
             dictkeys_decref(keys);
@@ -1278,8 +1384,9 @@ dictresize(PyDictObject *mp, uint8_t log2_newsize)
         // dictresize() must not be called after _PyDict_Fini()
         assert(state->keys_numfree != -1);
 #endif
-        if (DK_SIZE(oldkeys) == PyDict_MINSIZE &&
-            state->keys_numfree < PyDict_MAXFREELIST)
+        if (DK_SIZE(oldkeys) == PyDict_MINSIZE
+            && (state->keys_numfree < state->keys_freelist.capacity
+                || keys_freelist_overflow(state)))
         {
             state->keys_free_list[state->keys_numfree++] = oldkeys;
         }
@@ -2027,7 +2134,10 @@ dict_dealloc(PyDictObject *mp)
     // new_dict() must not be called after _PyDict_Fini()
     assert(state->numfree != -1);
 #endif
-    if (state->numfree < PyDict_MAXFREELIST && Py_IS_TYPE(mp, &PyDict_Type)) {
+    if (Py_IS_TYPE(mp, &PyDict_Type)
+        && (state->numfree < state->freelist.capacity
+            || dict_freelist_overflow(state)))
+    {
         state->free_list[state->numfree++] = mp;
     }
     else
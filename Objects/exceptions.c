@@ -28,6 +28,19 @@ get_exc_state(void)
     return &interp->exc_state;
 }
 
+/* Return a borrowed reference to the __dict__ of an exception, or NULL if
+ * it has none.  Instances of subclasses keep their attributes in inline
+ * values until the dict is needed: create it from them.  Return NULL with
+ * an exception set on memory error. */
+static PyObject *
+get_exc_dict(PyBaseExceptionObject *self)
+{
+    if (self->dict == NULL && _PyObject_GetDictPtr((PyObject *)self) == NULL) {
+        PyErr_NoMemory();
+    }
+    return self->dict;
+}
+
 
 /* NOTE: If the exception class hierarchy changes, don't forget to update
  * Lib/test/exception_hierarchy.txt
@@ -142,8 +155,11 @@ BaseException_repr(PyBaseExceptionObject *self)
 static PyObject *
 BaseException_reduce(PyBaseExceptionObject *self, PyObject *Py_UNUSED(ignored))
 {
-    if (self->args && self->dict)
-        return PyTuple_Pack(3, Py_TYPE(self), self->args, self->dict);
+    PyObject *dict = get_exc_dict(self);
+    if (dict == NULL && PyErr_Occurred())
+        return NULL;
+    if (self->args && dict)
+        return PyTuple_Pack(3, Py_TYPE(self), self->args, dict);
     else
         return PyTuple_Pack(2, Py_TYPE(self), self->args);
 }
@@ -1260,7 +1276,10 @@ ImportError_str(PyImportErrorObject *self)
 static PyObject *
 ImportError_getstate(PyImportErrorObject *self)
 {
-    PyObject *dict = ((PyBaseExceptionObject *)self)->dict;
+    PyObject *dict = get_exc_dict((PyBaseExceptionObject *)self);
+    if (dict == NULL && PyErr_Occurred()) {
+        return NULL;
+    }
     if (self->name || self->path) {
         _Py_IDENTIFIER(name);
         _Py_IDENTIFIER(path);
@@ -1703,6 +1722,9 @@ OSError_reduce(PyOSErrorObject *self, PyObject *Py_UNUSED(ignored))
 {
     PyObject *args = self->args;
     PyObject *res = NULL, *tmp;
+    PyObject *dict = get_exc_dict((PyBaseExceptionObject *)self);
+    if (dict == NULL && PyErr_Occurred())
+        return NULL;
 
     /* self->args is only the first two real arguments if there was a
      * file name given to OSError. */
@@ -1739,8 +1761,8 @@ OSError_reduce(PyOSErrorObject *self, PyObject *Py_UNUSED(ignored))
     } else
         Py_INCREF(args);
 
-    if (self->dict)
-        res = PyTuple_Pack(3, Py_TYPE(self), args, self->dict);
+    if (dict)
+        res = PyTuple_Pack(3, Py_TYPE(self), args, dict);
     else
         res = PyTuple_Pack(2, Py_TYPE(self), args);
     Py_DECREF(args);
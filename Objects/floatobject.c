@@ -139,10 +139,14 @@ PyFloat_FromDouble(double fval)
 #endif
         state->free_list = (PyFloatObject *) Py_TYPE(op);
         state->numfree--;
+        _PyFreeList_Hit(&state->freelist);
     }
     else
 #endif
     {
+#if PyFloat_MAXFREELIST > 0
+        _PyFreeList_Miss(&state->freelist);
+#endif
         op = PyObject_Malloc(sizeof(PyFloatObject));
         if (!op) {
             return PyErr_NoMemory();
@@ -246,7 +250,9 @@ float_dealloc(PyFloatObject *op)
         // float_dealloc() must not be called after _PyFloat_Fini()
         assert(state->numfree != -1);
 #endif
-        if (state->numfree >= PyFloat_MAXFREELIST)  {
+        if (state->numfree >= state->freelist.capacity
+            && !_PyFreeList_Overflow(&state->freelist))
+        {
             PyObject_Free(op);
             return;
         }
@@ -2042,6 +2048,17 @@ _PyFloat_InitTypes(void)
     return 0;
 }
 
+void
+_PyFloat_InitFreeList(PyInterpreterState *interp, int capacity, int adaptive)
+{
+#if PyFloat_MAXFREELIST > 0
+    if (capacity < 0) {
+        capacity = PyFloat_MAXFREELIST;
+    }
+    _PyFreeList_Init(&interp->float_state.freelist, capacity, adaptive);
+#endif
+}
+
 void
 _PyFloat_ClearFreeList(PyInterpreterState *interp)
 {
@@ -2055,6 +2072,7 @@ _PyFloat_ClearFreeList(PyInterpreterState *interp)
     }
     state->free_list = NULL;
     state->numfree = 0;
+    _PyFreeList_Decay(&state->freelist);
 #endif
 }
 
@@ -2077,6 +2095,7 @@ _PyFloat_DebugMallocStats(FILE *out)
     _PyDebugAllocatorStats(out,
                            "free PyFloatObject",
                            state->numfree, sizeof(PyFloatObject));
+    _PyFreeList_DebugStats(out, "float", &state->freelist);
 #endif
 }
 
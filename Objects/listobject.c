@@ -3,6 +3,7 @@
 #include "Python.h"
 #include "pycore_abstract.h"      // _PyIndex_Check()
 #include "pycore_interp.h"        // PyInterpreterState.list
+#include "pycore_list.h"          // _PyListIterObject
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_tuple.h"         // _PyTuple_FromArray()
 #include <stddef.h>
@@ -111,6 +112,55 @@ _PyList_ClearFreeList(PyInterpreterState *interp)
         assert(PyList_CheckExact(op));
         PyObject_GC_Del(op);
     }
+    _PyFreeList_Decay(&state->freelist);
+#endif
+}
+
+#if PyList_MAXFREELIST > 0
+/* Make room for the current capacity of the free list.  On memory
+   allocation failure, lower the capacity to the allocated size and
+   return -1. */
+static int
+list_freelist_resize(struct _Py_list_state *state)
+{
+    int capacity = state->freelist.capacity;
+    if (capacity > state->allocated_free_list) {
+        PyListObject **items = PyMem_Realloc(state->free_list,
+                                             capacity * sizeof(PyListObject *));
+        if (items == NULL) {
+            state->freelist.capacity = state->allocated_free_list;
+            return -1;
+        }
+        state->free_list = items;
+        state->allocated_free_list = capacity;
+    }
+    return 0;
+}
+
+/* Called by list_dealloc() when the free list is full.  Return 1 if the
+   adaptive free list grew, 0 otherwise. */
+static int
+list_freelist_overflow(struct _Py_list_state *state)
+{
+    if (!_PyFreeList_Overflow(&state->freelist)) {
+        return 0;
+    }
+    return list_freelist_resize(state) == 0;
+}
+#endif
+
+int
+_PyList_InitFreeList(PyInterpreterState *interp, int capacity, int adaptive)
+{
+#if PyList_MAXFREELIST > 0
+    struct _Py_list_state *state = &interp->list;
+    if (capacity < 0) {
+        capacity = PyList_MAXFREELIST;
+    }
+    _PyFreeList_Init(&state->freelist, capacity, adaptive);
+    return list_freelist_resize(state);
+#else
+    return 0;
 #endif
 }
 
@@ -118,10 +168,16 @@ void
 _PyList_Fini(PyInterpreterState *interp)
 {
     _PyList_ClearFreeList(interp);
-#if defined(Py_DEBUG) && PyList_MAXFREELIST > 0
+#if PyList_MAXFREELIST > 0
     struct _Py_list_state *state = &interp->list;
+    PyMem_Free(state->free_list);
+    state->free_list = NULL;
+    state->allocated_free_list = 0;
+    state->freelist.capacity = 0;
+#ifdef Py_DEBUG
     state->numfree = -1;
 #endif
+#endif
 }
 
 /* Print summary info about the state of the optimized allocator */
@@ -133,6 +189,7 @@ _PyList_DebugMallocStats(FILE *out)
     _PyDebugAllocatorStats(out,
                            "free PyListObject",
                            state->numfree, sizeof(PyListObject));
+    _PyFreeList_DebugStats(out, "list", &state->freelist);
 #endif
 }
 
@@ -156,10 +213,14 @@ PyList_New(Py_ssize_t size)
         state->numfree--;
         op = state->free_list[state->numfree];
         _Py_NewReference((PyObject *)op);
+        _PyFreeList_Hit(&state->freelist);
     }
     else
 #endif
     {
+#if PyList_MAXFREELIST > 0
+        _PyFreeList_Miss(&state->freelist);
+#endif
         op = PyObject_GC_New(PyListObject, &PyList_Type);
         if (op == NULL) {
             return NULL;
@@ -354,7 +415,10 @@ list_dealloc(PyListObject *op)
     // list_dealloc() must not be called after _PyList_Fini()
     assert(state->numfree != -1);
 #endif
-    if (state->numfree < PyList_MAXFREELIST && PyList_CheckExact(op)) {
+    if (PyList_CheckExact(op)
+        && (state->numfree < state->freelist.capacity
+            || list_freelist_overflow(state)))
+    {
         state->free_list[state->numfree++] = op;
     }
     else
@@ -3189,11 +3253,7 @@ PyTypeObject PyList_Type = {
 
 /*********************** List Iterator **************************/
 
-typedef struct {
-    PyObject_HEAD
-    Py_ssize_t it_index;
-    PyListObject *it_seq; /* Set to NULL when iterator is exhausted */
-} listiterobject;
+typedef _PyListIterObject listiterobject;
 
 static void listiter_dealloc(listiterobject *);
 static int listiter_traverse(listiterobject *, visitproc, void *);
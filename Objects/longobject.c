@@ -295,6 +295,38 @@ PyLong_FromLong(long ival)
     return (PyObject *)v;
 }
 
+/* Store a C long into *target, releasing the previous value.
+ * If *target is an exact int that nothing else references, and the new
+ * value fits in a single positive digit, the object is updated in place
+ * to avoid an allocation. This is used by the FOR_ITER_RANGE instruction.
+ * Returns 0 on success, -1 (with an exception set) on failure. */
+int
+_PyLong_AssignValue(PyObject **target, long value)
+{
+    PyObject *old = *target;
+    if (IS_SMALL_INT(value)) {
+        *target = get_small_int((sdigit)value);
+        Py_XDECREF(old);
+        return 0;
+    }
+    if (old != NULL && PyLong_CheckExact(old) &&
+        Py_REFCNT(old) == 1 && Py_SIZE(old) == 1 &&
+        (unsigned long)value <= PyLong_MASK)
+    {
+        /* Only positive values are handled here: iterating over ranges
+           with a positive step is by far the most common case. */
+        ((PyLongObject *)old)->ob_digit[0] =
+            Py_SAFE_DOWNCAST(value, long, digit);
+        return 0;
+    }
+    *target = PyLong_FromLong(value);
+    Py_XDECREF(old);
+    if (*target == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
 #define PYLONG_FROM_UINT(INT_TYPE, ival) \
     do { \
         if (IS_SMALL_UINT(ival)) { \
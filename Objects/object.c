@@ -1445,6 +1445,17 @@ _PyObject_GenericSetAttrWithDict(PyObject *obj, PyObject *name,
                 }
                 goto done;
             }
+            else if (values_ptr && *dictptr == NULL && value != NULL &&
+                     PyUnicode_CheckExact(name))
+            {
+                /* Instances created without object.__new__(), such as
+                   those of subclasses of builtin types, get their inline
+                   values when their first attribute is stored. */
+                if (_PyObject_InitializeDict(obj) < 0) {
+                    goto done;
+                }
+                res = _PyObject_StoreInstanceAttribute(obj, *values_ptr, name, value);
+            }
             else {
                 res = _PyObjectDict_SetItem(tp, dictptr, name, value);
             }
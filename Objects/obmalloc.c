@@ -1,5 +1,7 @@
 #include "Python.h"
+#include "pycore_freelist.h"      // _PyFreeList_DebugStats()
 #include "pycore_pymem.h"         // _PyTraceMalloc_Config
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 
 #include <stdbool.h>
 #include <stdlib.h>               // malloc()
@@ -79,6 +81,7 @@ static void* _PyObject_Malloc(void *ctx, size_t size);
 static void* _PyObject_Calloc(void *ctx, size_t nelem, size_t elsize);
 static void _PyObject_Free(void *ctx, void *p);
 static void* _PyObject_Realloc(void *ctx, void *ptr, size_t size);
+static void release_retained_arenas(void);
 #endif
 
 
@@ -568,6 +571,10 @@ _PyObject_VirtualFree(void *obj, size_t size)
 void
 PyObject_SetArenaAllocator(PyObjectArenaAllocator *allocator)
 {
+#ifdef WITH_PYMALLOC
+    /* Free the retained arenas with the allocator that allocated them. */
+    release_retained_arenas();
+#endif
     _PyObject_Arena = *allocator;
 }
 
@@ -1255,10 +1262,14 @@ static size_t narenas_highwater = 0;
 
 static Py_ssize_t raw_allocated_blocks;
 
+/* Number of blocks in the pymalloc caches of all the thread states. */
+static size_t nthread_cached_blocks = 0;
+
 Py_ssize_t
 _Py_GetAllocatedBlocks(void)
 {
-    Py_ssize_t n = raw_allocated_blocks;
+    /* blocks in the thread caches are counted by their pools */
+    Py_ssize_t n = raw_allocated_blocks - (Py_ssize_t)nthread_cached_blocks;
     /* add up allocated blocks for used pools */
     for (uint i = 0; i < maxarenas; ++i) {
         /* Skip arenas which are not allocated. */
@@ -1552,6 +1563,277 @@ arena_map_is_used(block *p)
 #endif /* WITH_PYMALLOC_RADIX_TREE */
 
 
+/*==========================================================================*/
+/* Arena backend.
+ *
+ * How the memory of the arenas is obtained and given back is configured by
+ * PyConfig.malloc_arenas_huge_pages and PyConfig.malloc_arenas_retained
+ * (-X malloc_arenas and PYTHONMALLOCARENAS), passed to
+ * _PyObject_SetArenaOptions() when the runtime is initialized:
+ *
+ * - ARENA_HUGE_MADVISE ("hugepage"): map the arenas from chunks aligned on
+ *   the size of a huge page (2 MiB), and advise the kernel to back them with
+ *   transparent huge pages (MADV_HUGEPAGE).  This reduces the TLB misses of
+ *   large heaps.
+ * - ARENA_HUGE_TLB ("hugetlb"): map the chunks with MAP_HUGETLB, falling back
+ *   to "hugepage" if no huge page is available.  Huge pages cannot be
+ *   partially unmapped, so the free arenas of such a chunk are retained
+ *   while the chunk has arenas in use.  Once all its arenas are free, the
+ *   chunk is unmapped as a whole, unless it fits in the max_retained bound.
+ * - max_retained ("retain=N"): keep up to N free arenas mapped rather than
+ *   giving them back to the system at once; new_arena() reuses them first.
+ *
+ * Huge pages are only used with the default arena allocator on systems with
+ * mmap().
+ */
+
+#define ARENA_HUGE_NONE     0
+#define ARENA_HUGE_MADVISE  1
+#define ARENA_HUGE_TLB      2
+
+#define HUGE_PAGE_SIZE      (1 << 21)                 /* 2 MiB */
+#if ARENA_SIZE < HUGE_PAGE_SIZE
+#define ARENA_CHUNK_SIZE    HUGE_PAGE_SIZE
+#else
+#define ARENA_CHUNK_SIZE    ARENA_SIZE
+#endif
+#define ARENAS_PER_CHUNK    (ARENA_CHUNK_SIZE / ARENA_SIZE)
+
+/* A chunk mapped with MAP_HUGETLB */
+struct hugetlb_chunk {
+    void *address;
+    /* Number of its arenas which are not used by new_arena() */
+    uint nfree;
+};
+
+static struct {
+    int huge_pages;
+    size_t max_retained;
+    /* Singly-linked list of the free arenas kept mapped, linked through
+     * their first word. */
+    void *retained;
+    /* Number of arenas in the list, and the highest value it reached. */
+    size_t nretained;
+    size_t nretained_highwater;
+    /* Number of arenas taken from the list by new_arena(). */
+    size_t nreused;
+    /* Number of huge page chunks mapped. */
+    size_t nchunks;
+    /* The chunks mapped with MAP_HUGETLB which are still mapped, in an
+     * array of maxhugetlb entries. */
+    struct hugetlb_chunk *hugetlb;
+    size_t nhugetlb;
+    size_t maxhugetlb;
+} arena_backend;
+
+void
+_PyObject_SetArenaOptions(int huge_pages, int max_retained)
+{
+    assert(ARENA_HUGE_NONE <= huge_pages && huge_pages <= ARENA_HUGE_TLB);
+    assert(max_retained >= 0);
+    arena_backend.huge_pages = huge_pages;
+    arena_backend.max_retained = (size_t)max_retained;
+}
+
+static void
+retain_arena(void *address)
+{
+    *(void **)address = arena_backend.retained;
+    arena_backend.retained = address;
+    arena_backend.nretained++;
+    if (arena_backend.nretained > arena_backend.nretained_highwater) {
+        arena_backend.nretained_highwater = arena_backend.nretained;
+    }
+}
+
+/* Return the MAP_HUGETLB chunk holding the arena at address, or NULL. */
+static struct hugetlb_chunk *
+find_hugetlb_chunk(void *address)
+{
+    for (size_t i = 0; i < arena_backend.nhugetlb; i++) {
+        struct hugetlb_chunk *chunk = &arena_backend.hugetlb[i];
+        if ((char *)chunk->address <= (char *)address
+            && (char *)address < (char *)chunk->address + ARENA_CHUNK_SIZE)
+        {
+            return chunk;
+        }
+    }
+    return NULL;
+}
+
+/* Unmap a MAP_HUGETLB chunk whose arenas are all free, removing those
+ * which are retained from the list. */
+static void
+unmap_hugetlb_chunk(struct hugetlb_chunk *chunk)
+{
+    assert(chunk->nfree == ARENAS_PER_CHUNK);
+    char *start = (char *)chunk->address;
+    void **link = &arena_backend.retained;
+    while (*link != NULL) {
+        char *arena = (char *)*link;
+        if (start <= arena && arena < start + ARENA_CHUNK_SIZE) {
+            *link = *(void **)arena;
+            arena_backend.nretained--;
+        }
+        else {
+            link = (void **)arena;
+        }
+    }
+#ifdef ARENAS_USE_MMAP
+    munmap(start, ARENA_CHUNK_SIZE);
+#endif
+    *chunk = arena_backend.hugetlb[--arena_backend.nhugetlb];
+}
+
+/* Free an arena of a MAP_HUGETLB chunk.  The arena is retained for reuse
+ * while the chunk has arenas in use, or while the retained arenas fit in
+ * max_retained.  After the arena allocator changed, the arena stays mapped
+ * but is not reused, until the chunk is unmapped. */
+static void
+free_hugetlb_arena(struct hugetlb_chunk *chunk, void *address)
+{
+    chunk->nfree++;
+    if (arena_backend.huge_pages == ARENA_HUGE_TLB) {
+        retain_arena(address);
+        if (chunk->nfree < ARENAS_PER_CHUNK
+            || arena_backend.nretained <= arena_backend.max_retained)
+        {
+            return;
+        }
+    }
+    else if (chunk->nfree < ARENAS_PER_CHUNK) {
+        return;
+    }
+    unmap_hugetlb_chunk(chunk);
+}
+
+static void
+release_retained_arenas(void)
+{
+    if (arena_backend.huge_pages == ARENA_HUGE_TLB) {
+        /* Map the next arenas with the new allocator.  The hugetlb arenas
+         * still in use are given back by free_hugetlb_arena() once freed. */
+        arena_backend.huge_pages = ARENA_HUGE_NONE;
+    }
+    void *address = arena_backend.retained;
+    arena_backend.retained = NULL;
+    arena_backend.nretained = 0;
+    while (address != NULL) {
+        void *next = *(void **)address;
+        if (find_hugetlb_chunk(address) == NULL) {
+            _PyObject_Arena.free(_PyObject_Arena.ctx, address, ARENA_SIZE);
+        }
+        address = next;
+    }
+    /* Backward, as unmap_hugetlb_chunk() moves the last chunk. */
+    for (size_t i = arena_backend.nhugetlb; i-- > 0;) {
+        if (arena_backend.hugetlb[i].nfree == ARENAS_PER_CHUNK) {
+            unmap_hugetlb_chunk(&arena_backend.hugetlb[i]);
+        }
+    }
+}
+
+#ifdef ARENAS_USE_MMAP
+/* Map a chunk of ARENA_CHUNK_SIZE bytes aligned on its size, return its
+ * first arena and retain the others. */
+static void *
+map_huge_page_chunk(void)
+{
+    void *chunk = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (arena_backend.huge_pages == ARENA_HUGE_TLB) {
+        if (arena_backend.nhugetlb == arena_backend.maxhugetlb) {
+            size_t maxhugetlb = arena_backend.maxhugetlb
+                                ? 2 * arena_backend.maxhugetlb : 16;
+            struct hugetlb_chunk *hugetlb = PyMem_RawRealloc(
+                arena_backend.hugetlb, maxhugetlb * sizeof(*hugetlb));
+            if (hugetlb == NULL) {
+                return NULL;
+            }
+            arena_backend.hugetlb = hugetlb;
+            arena_backend.maxhugetlb = maxhugetlb;
+        }
+        chunk = mmap(NULL, ARENA_CHUNK_SIZE, PROT_READ|PROT_WRITE,
+                     MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+        if (chunk != MAP_FAILED) {
+            struct hugetlb_chunk *entry =
+                &arena_backend.hugetlb[arena_backend.nhugetlb++];
+            entry->address = chunk;
+            /* All its arenas but the first one are retained below */
+            entry->nfree = ARENAS_PER_CHUNK - 1;
+        }
+    }
+#endif
+    if (chunk == MAP_FAILED) {
+        /* Map twice the size and unmap what lies outside the aligned chunk. */
+        size_t size = 2 * (size_t)ARENA_CHUNK_SIZE;
+        char *ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
+                         MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return NULL;
+        }
+        char *aligned = (char *)_Py_SIZE_ROUND_UP(ptr, ARENA_CHUNK_SIZE);
+        size_t head = aligned - ptr;
+        if (head != 0) {
+            munmap(ptr, head);
+        }
+        munmap(aligned + ARENA_CHUNK_SIZE, size - head - ARENA_CHUNK_SIZE);
+        chunk = aligned;
+#ifdef MADV_HUGEPAGE
+        (void)madvise(chunk, ARENA_CHUNK_SIZE, MADV_HUGEPAGE);
+#endif
+    }
+    arena_backend.nchunks++;
+    for (char *arena = (char *)chunk + ARENA_CHUNK_SIZE - ARENA_SIZE;
+         arena != (char *)chunk; arena -= ARENA_SIZE)
+    {
+        retain_arena(arena);
+    }
+    return chunk;
+}
+#endif
+
+/* Return the memory of a new arena, or NULL. */
+static void *
+map_arena(void)
+{
+    if (arena_backend.retained != NULL) {
+        void *address = arena_backend.retained;
+        arena_backend.retained = *(void **)address;
+        arena_backend.nretained--;
+        arena_backend.nreused++;
+        struct hugetlb_chunk *chunk = find_hugetlb_chunk(address);
+        if (chunk != NULL) {
+            chunk->nfree--;
+        }
+        return address;
+    }
+#ifdef ARENAS_USE_MMAP
+    if (arena_backend.huge_pages != ARENA_HUGE_NONE &&
+        _PyObject_Arena.alloc == _PyObject_ArenaMmap)
+    {
+        return map_huge_page_chunk();
+    }
+#endif
+    return _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+}
+
+/* Give back the memory of an arena returned by map_arena(). */
+static void
+unmap_arena(void *address)
+{
+    struct hugetlb_chunk *chunk = find_hugetlb_chunk(address);
+    if (chunk != NULL) {
+        free_hugetlb_arena(chunk, address);
+        return;
+    }
+    if (arena_backend.nretained < arena_backend.max_retained) {
+        retain_arena(address);
+        return;
+    }
+    _PyObject_Arena.free(_PyObject_Arena.ctx, address, ARENA_SIZE);
+}
+
 /* Allocate a new arena.  If we run out of memory, return NULL.  Else
  * allocate a new arena, and return the address of an arena_object
  * describing the new arena.  It's expected that the caller will set
@@ -1619,12 +1901,12 @@ new_arena(void)
     arenaobj = unused_arena_objects;
     unused_arena_objects = arenaobj->nextarena;
     assert(arenaobj->address == 0);
-    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+    address = map_arena();
 #if WITH_PYMALLOC_RADIX_TREE
     if (address != NULL) {
         if (!arena_map_mark_used((uintptr_t)address, 1)) {
             /* marking arena in radix tree failed, abort */
-            _PyObject_Arena.free(_PyObject_Arena.ctx, address, ARENA_SIZE);
+            unmap_arena(address);
             address = NULL;
         }
     }
@@ -1917,6 +2199,115 @@ allocate_from_new_pool(uint size)
     return bp;
 }
 
+/*==========================================================================*/
+/* Per-thread caches.
+ *
+ * Each thread state keeps a free list of small blocks per size class, so
+ * that the thread reuses the blocks it freed last, which are likely still
+ * in the cache of its CPU, without going through usedpools.  The cache of
+ * a size class is refilled from the pools, and flushed back to them, by
+ * batches of half its capacity.  The capacity is THREAD_CACHE_BYTES per
+ * size class, so a thread keeps at most 128 KiB of free blocks.
+ *
+ * The blocks in the caches are still counted as allocated by their pools;
+ * nthread_cached_blocks is subtracted where allocated blocks are reported.
+ * Like the pools, the caches are protected by the GIL.  PyThreadState_Clear()
+ * flushes the cache of the thread state and detaches it: the thread state
+ * then uses the pools directly, so that PyThreadState_Delete(), which may be
+ * called without the GIL, never has blocks to give back.
+ */
+#define THREAD_CACHE_BYTES  4096
+
+struct _obmalloc_thread_cache {
+    block *freeblock[NB_SMALL_SIZE_CLASSES];
+    uint nblocks[NB_SMALL_SIZE_CLASSES];
+    /* THREAD_CACHE_BYTES in blocks, computed once to spare a division. */
+    uint capacity[NB_SMALL_SIZE_CLASSES];
+};
+
+/* The cache of a detached thread state: always empty, with no capacity.
+ * It is never written to. */
+static struct _obmalloc_thread_cache detached_thread_cache;
+
+static void *allocate_from_pools(uint size);
+static void free_to_pool(poolp pool, block *p);
+
+static inline struct _obmalloc_thread_cache *
+get_thread_cache(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (tstate == NULL) {
+        return NULL;
+    }
+    return tstate->obmalloc_cache;
+}
+
+static struct _obmalloc_thread_cache *
+new_thread_cache(PyThreadState *tstate)
+{
+    struct _obmalloc_thread_cache *cache = PyMem_RawCalloc(1, sizeof(*cache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    for (uint size = 0; size < NB_SMALL_SIZE_CLASSES; size++) {
+        cache->capacity[size] = THREAD_CACHE_BYTES / INDEX2SIZE(size);
+    }
+    tstate->obmalloc_cache = cache;
+    return cache;
+}
+
+/* Allocate a block of the size class size, and fill the cache of this size
+ * class with more blocks allocated from the same pools. */
+static void *
+refill_thread_cache(struct _obmalloc_thread_cache *cache, uint size)
+{
+    block *bp = allocate_from_pools(size);
+    if (bp == NULL) {
+        return NULL;
+    }
+    uint batch = cache->capacity[size] / 2;
+    for (uint i = 1; i < batch; i++) {
+        block *extra = allocate_from_pools(size);
+        if (extra == NULL) {
+            break;
+        }
+        *(block **)extra = cache->freeblock[size];
+        cache->freeblock[size] = extra;
+        cache->nblocks[size]++;
+        nthread_cached_blocks++;
+    }
+    return bp;
+}
+
+/* Give the n first blocks of the cache of the size class size back to
+ * their pools. */
+static void
+flush_thread_cache(struct _obmalloc_thread_cache *cache, uint size, uint n)
+{
+    assert(n <= cache->nblocks[size]);
+    for (uint i = 0; i < n; i++) {
+        block *bp = cache->freeblock[size];
+        cache->freeblock[size] = *(block **)bp;
+        free_to_pool(POOL_ADDR(bp), bp);
+    }
+    cache->nblocks[size] -= n;
+    nthread_cached_blocks -= n;
+}
+
+void
+_PyObject_ClearThreadCache(PyThreadState *tstate)
+{
+    struct _obmalloc_thread_cache *cache = tstate->obmalloc_cache;
+    tstate->obmalloc_cache = &detached_thread_cache;
+    if (cache == NULL || cache == &detached_thread_cache) {
+        return;
+    }
+    for (uint size = 0; size < NB_SMALL_SIZE_CLASSES; size++) {
+        flush_thread_cache(cache, size, cache->nblocks[size]);
+    }
+    PyMem_RawFree(cache);
+}
+
 /* pymalloc allocator
 
    Return a pointer to newly allocated memory if pymalloc allocated memory.
@@ -1945,6 +2336,24 @@ pymalloc_alloc(void *ctx, size_t nbytes)
     }
 
     uint size = (uint)(nbytes - 1) >> ALIGNMENT_SHIFT;
+    struct _obmalloc_thread_cache *cache = get_thread_cache();
+    if (LIKELY(cache != NULL)) {
+        block *bp = cache->freeblock[size];
+        if (LIKELY(bp != NULL)) {
+            cache->freeblock[size] = *(block **)bp;
+            cache->nblocks[size]--;
+            nthread_cached_blocks--;
+            return (void *)bp;
+        }
+        return refill_thread_cache(cache, size);
+    }
+    return allocate_from_pools(size);
+}
+
+/* Allocate a block of the size class size from the shared pools. */
+static void *
+allocate_from_pools(uint size)
+{
     poolp pool = usedpools[size + size];
     block *bp;
 
@@ -2113,8 +2522,7 @@ insert_to_freepool(poolp pool)
 #endif
 
         /* Free the entire arena. */
-        _PyObject_Arena.free(_PyObject_Arena.ctx,
-                             (void *)ao->address, ARENA_SIZE);
+        unmap_arena((void *)ao->address);
         ao->address = 0;                        /* mark unassociated */
         --narenas_currently_allocated;
 
@@ -2212,6 +2620,31 @@ pymalloc_free(void *ctx, void *p)
     }
     /* We allocated this address. */
 
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (LIKELY(tstate != NULL)) {
+        struct _obmalloc_thread_cache *cache = tstate->obmalloc_cache;
+        if (UNLIKELY(cache == NULL)) {
+            cache = new_thread_cache(tstate);
+        }
+        if (LIKELY(cache != NULL && cache != &detached_thread_cache)) {
+            uint size = pool->szidx;
+            *(block **)p = cache->freeblock[size];
+            cache->freeblock[size] = (block *)p;
+            nthread_cached_blocks++;
+            if (UNLIKELY(++cache->nblocks[size] > cache->capacity[size])) {
+                flush_thread_cache(cache, size, cache->capacity[size] / 2);
+            }
+            return 1;
+        }
+    }
+    free_to_pool(pool, (block *)p);
+    return 1;
+}
+
+/* Give the block p back to its pool. */
+static void
+free_to_pool(poolp pool, block *p)
+{
     /* Link p to the start of the pool's freeblock list.  Since
      * the pool had at least the p block outstanding, the pool
      * wasn't empty (so it's already in a usedpools[] list, or
@@ -2232,7 +2665,7 @@ pymalloc_free(void *ctx, void *p)
          * blocks of the same size class.
          */
         insert_to_usedpool(pool);
-        return 1;
+        return;
     }
 
     /* freeblock wasn't NULL, so the pool wasn't full,
@@ -2240,7 +2673,7 @@ pymalloc_free(void *ctx, void *p)
      */
     if (LIKELY(pool->ref.count != 0)) {
         /* pool isn't empty:  leave it in usedpools */
-        return 1;
+        return;
     }
 
     /* Pool is now empty:  unlink from usedpools, and
@@ -2249,7 +2682,6 @@ pymalloc_free(void *ctx, void *p)
      * (being not referenced, they are perhaps paged out).
      */
     insert_to_freepool(pool);
-    return 1;
 }
 
 
@@ -2904,6 +3336,21 @@ _PyDebugAllocatorStats(FILE *out,
     (void)printone(out, buf2, num_blocks * sizeof_block);
 }
 
+void
+_PyFreeList_DebugStats(FILE *out, const char *name,
+                       const struct _Py_freelist_state *fl)
+{
+    char buf[128];
+    PyOS_snprintf(buf, sizeof(buf), "# %s freelist capacity", name);
+    (void)printone(out, buf, (size_t)fl->capacity);
+    PyOS_snprintf(buf, sizeof(buf), "# %s freelist hits", name);
+    (void)printone(out, buf, fl->hits);
+    PyOS_snprintf(buf, sizeof(buf), "# %s freelist misses", name);
+    (void)printone(out, buf, fl->misses);
+    PyOS_snprintf(buf, sizeof(buf), "# %s freelist overflows", name);
+    (void)printone(out, buf, fl->overflows);
+}
+
 
 #ifdef WITH_PYMALLOC
 
@@ -3055,6 +3502,17 @@ _PyObject_DebugMallocStats(FILE *out)
     (void)printone(out, "# arenas reclaimed", ntimes_arena_allocated - narenas);
     (void)printone(out, "# arenas highwater mark", narenas_highwater);
     (void)printone(out, "# arenas allocated current", narenas);
+    (void)printone(out, "# blocks in thread caches", nthread_cached_blocks);
+    (void)printone(out, "# arenas retained current", arena_backend.nretained);
+    (void)printone(out, "# arenas retained highwater mark",
+                   arena_backend.nretained_highwater);
+    (void)printone(out, "# arenas reused from retained", arena_backend.nreused);
+    if (arena_backend.huge_pages != ARENA_HUGE_NONE) {
+        PyOS_snprintf(buf, sizeof(buf), "# %s chunks mapped",
+                      arena_backend.huge_pages == ARENA_HUGE_TLB
+                      ? "hugetlb" : "hugepage");
+        (void)printone(out, buf, arena_backend.nchunks);
+    }
 
     PyOS_snprintf(buf, sizeof(buf),
                   "%zu arenas * %d bytes/arena",
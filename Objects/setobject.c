@@ -33,6 +33,7 @@
 
 #include "Python.h"
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
+#include "pycore_setobject.h"     // _PySet_Contains()
 #include <stddef.h>               // offsetof()
 
 /* Object used as dummy key to fill deleted entries */
@@ -1810,8 +1811,8 @@ PyDoc_STRVAR(add_doc,
 \n\
 This has no effect if the element is already present.");
 
-static int
-set_contains(PySetObject *so, PyObject *key)
+int
+_PySet_Contains(PySetObject *so, PyObject *key)
 {
     PyObject *tmpkey;
     int rv;
@@ -1835,7 +1836,7 @@ set_direct_contains(PySetObject *so, PyObject *key)
 {
     long result;
 
-    result = set_contains(so, key);
+    result = _PySet_Contains(so, key);
     if (result < 0)
         return NULL;
     return PyBool_FromLong(result);
@@ -1990,7 +1991,7 @@ static PySequenceMethods set_as_sequence = {
     0,                                  /* sq_slice */
     0,                                  /* sq_ass_item */
     0,                                  /* sq_ass_slice */
-    (objobjproc)set_contains,           /* sq_contains */
+    (objobjproc)_PySet_Contains,        /* sq_contains */
 };
 
 /* set object ********************************************************/
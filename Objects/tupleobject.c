@@ -7,6 +7,7 @@
 #include "pycore_initconfig.h"    // _PyStatus_OK()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_pyerrors.h"      // _Py_FatalRefcountError()
+#include "pycore_tuple.h"         // _PyTupleIterObject
 
 /*[clinic input]
 class tuple "PyTupleObject *" "&PyTuple_Type"
@@ -39,6 +40,7 @@ _PyTuple_DebugMallocStats(FILE *out)
         _PyDebugAllocatorStats(out, buf, state->numfree[i],
                                _PyObject_VAR_SIZE(&PyTuple_Type, i));
     }
+    _PyFreeList_DebugStats(out, "tuple", &state->freelist);
 #endif
 }
 
@@ -83,10 +85,16 @@ tuple_alloc(Py_ssize_t size)
         Py_SET_TYPE(op, &PyTuple_Type);
 #endif
         _Py_NewReference((PyObject *)op);
+        _PyFreeList_Hit(&state->freelist);
     }
     else
 #endif
     {
+#if PyTuple_MAXSAVESIZE > 1
+        if (size < PyTuple_MAXSAVESIZE) {
+            _PyFreeList_Miss(&state->freelist);
+        }
+#endif
         /* Check for overflow */
         if ((size_t)size > ((size_t)PY_SSIZE_T_MAX - (sizeof(PyTupleObject) -
                     sizeof(PyObject *))) / sizeof(PyObject *)) {
@@ -279,8 +287,9 @@ tupledealloc(PyTupleObject *op)
         assert(state->numfree[0] != -1);
 #endif
         if (len < PyTuple_MAXSAVESIZE
-            && state->numfree[len] < PyTuple_MAXFREELIST
-            && Py_IS_TYPE(op, &PyTuple_Type))
+            && Py_IS_TYPE(op, &PyTuple_Type)
+            && (state->numfree[len] < state->freelist.capacity
+                || _PyFreeList_Overflow(&state->freelist)))
         {
             op->ob_item[0] = (PyObject *) state->free_list[len];
             state->numfree[len]++;
@@ -1060,6 +1069,7 @@ _PyTuple_ClearFreeList(PyInterpreterState *interp)
             PyObject_GC_Del(q);
         }
     }
+    _PyFreeList_Decay(&state->freelist);
     // the empty tuple singleton is only cleared by _PyTuple_Fini()
 #endif
 }
@@ -1076,6 +1086,18 @@ _PyTuple_Init(PyInterpreterState *interp)
 }
 
 
+void
+_PyTuple_InitFreeList(PyInterpreterState *interp, int capacity, int adaptive)
+{
+#if PyTuple_MAXSAVESIZE > 0
+    if (capacity < 0) {
+        capacity = PyTuple_MAXFREELIST;
+    }
+    _PyFreeList_Init(&interp->tuple.freelist, capacity, adaptive);
+#endif
+}
+
+
 void
 _PyTuple_Fini(PyInterpreterState *interp)
 {
@@ -1098,11 +1120,7 @@ _PyTuple_Fini(PyInterpreterState *interp)
 
 /*********************** Tuple Iterator **************************/
 
-typedef struct {
-    PyObject_HEAD
-    Py_ssize_t it_index;
-    PyTupleObject *it_seq; /* Set to NULL when iterator is exhausted */
-} tupleiterobject;
+typedef _PyTupleIterObject tupleiterobject;
 
 static void
 tupleiter_dealloc(tupleiterobject *it)
@@ -4,6 +4,7 @@
 #include "pycore_call.h"
 #include "pycore_code.h"          // CO_FAST_FREE
 #include "pycore_compile.h"       // _Py_Mangle()
+#include "pycore_gc.h"            // _PyGC_ShareObject()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
 #include "pycore_moduleobject.h"  // _PyModule_GetDef()
 #include "pycore_object.h"        // _PyType_HasFeature()
@@ -47,6 +48,13 @@ class object "PyObject *" "&PyBaseObject_Type"
 // Used to set PyTypeObject.tp_version_tag
 static unsigned int next_version_tag = 1;
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+// Set by _PyTypes_Share(): static types readied later are shared at once
+static int static_types_shared = 0;
+// Protects next_version_tag once isolated subinterpreters can run
+static PyThread_type_lock next_version_tag_lock = NULL;
+#endif
+
 typedef struct PySlot_Offset {
     short subslot_offset;
     short slot_offset;
@@ -414,12 +422,25 @@ assign_version_tag(struct type_cache *cache, PyTypeObject *type)
     if (!_PyType_HasFeature(type, Py_TPFLAGS_READY))
         return 0;
 
-    if (next_version_tag == 0) {
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (next_version_tag_lock != NULL) {
+        PyThread_acquire_lock(next_version_tag_lock, WAIT_LOCK);
+    }
+#endif
+    unsigned int version_tag = next_version_tag;
+    if (version_tag != 0) {
+        next_version_tag++;
+    }
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (next_version_tag_lock != NULL) {
+        PyThread_release_lock(next_version_tag_lock);
+    }
+#endif
+    if (version_tag == 0) {
         /* We have run out of version numbers */
         return 0;
     }
-    type->tp_version_tag = next_version_tag++;
-    assert (type->tp_version_tag != 0);
+    type->tp_version_tag = version_tag;
 
     bases = type->tp_bases;
     n = PyTuple_GET_SIZE(bases);
@@ -673,6 +694,9 @@ static int compatible_for_assignment(PyTypeObject *, PyTypeObject *, const char
 static int add_subclass(PyTypeObject*, PyTypeObject*);
 static int add_all_subclasses(PyTypeObject *type, PyObject *bases);
 static void remove_subclass(PyTypeObject *, PyTypeObject *);
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+static int share_static_type(PyTypeObject *);
+#endif
 static void remove_all_subclasses(PyTypeObject *type, PyObject *bases);
 static void update_all_slots(PyTypeObject *);
 
@@ -2956,6 +2980,21 @@ type_new_classmethod(PyTypeObject *type, _Py_Identifier *attr_id)
 }
 
 
+/* Return 1 if the instances of a subclass of base without __slots__ store
+   their __dict__ in the dict member of PyBaseExceptionObject.  Exceptions access their dict
+   only through the generic attribute functions (see get_exc_dict() in
+   Objects/exceptions.c), so the subclass can keep its attributes in inline
+   values, like a subclass which adds its own __dict__. */
+static int
+inherits_exception_dict(PyTypeObject *base)
+{
+    return (PyType_FastSubclass(base, Py_TPFLAGS_BASE_EXC_SUBCLASS) &&
+            base->tp_dictoffset > 0 &&
+            base->tp_inline_values_offset == 0 &&
+            base->tp_itemsize == 0);
+}
+
+
 /* Add descriptors for custom slots from __slots__, or for __dict__ */
 static int
 type_new_descriptors(const type_new_ctx *ctx, PyTypeObject *type)
@@ -2997,7 +3036,9 @@ type_new_descriptors(const type_new_ctx *ctx, PyTypeObject *type)
         type->tp_weaklistoffset = slotoffset;
         slotoffset += sizeof(PyObject *);
     }
-    if (type->tp_dictoffset > 0) {
+    if (type->tp_dictoffset > 0 ||
+        (et->ht_slots == NULL && inherits_exception_dict(ctx->base)))
+    {
         type->tp_inline_values_offset = slotoffset;
         slotoffset += sizeof(PyDictValues *);
     }
@@ -6456,9 +6497,88 @@ PyType_Ready(PyTypeObject *type)
     /* All done -- set the ready flag */
     type->tp_flags = (type->tp_flags & ~Py_TPFLAGS_READYING) | Py_TPFLAGS_READY;
     assert(_PyType_CheckConsistency(type));
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (static_types_shared && !(type->tp_flags & Py_TPFLAGS_HEAPTYPE)) {
+        if (share_static_type(type) < 0) {
+            return -1;
+        }
+    }
+#endif
+    return 0;
+}
+
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+/* Static types are shared by all interpreters, which may run in parallel.
+   Make a static type and the objects reachable from it, such as its dict,
+   immortal, and give it a version tag now, so that the interpreters never
+   write to it. */
+static int
+share_static_type(PyTypeObject *type)
+{
+    if (_PyGC_ShareObject((PyObject *)type) < 0) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    assign_version_tag(get_type_cache(), type);
+    return 0;
+}
+
+static int
+share_static_subclasses(PyTypeObject *type)
+{
+    if (share_static_type(type) < 0) {
+        return -1;
+    }
+    PyObject *subclasses = type->tp_subclasses;
+    if (subclasses == NULL) {
+        return 0;
+    }
+    Py_ssize_t i = 0;
+    PyObject *ref;
+    while (PyDict_Next(subclasses, &i, NULL, &ref)) {
+        PyObject *subclass = PyWeakref_GET_OBJECT(ref);
+        if (subclass == Py_None
+            || _PyType_HasFeature((PyTypeObject *)subclass, Py_TPFLAGS_HEAPTYPE))
+        {
+            continue;
+        }
+        if (share_static_subclasses((PyTypeObject *)subclass) < 0) {
+            return -1;
+        }
+    }
     return 0;
 }
 
+/* Share the static types which are ready, and those readied later.  Called
+   by the main interpreter before isolated subinterpreters can run. */
+int
+_PyTypes_Share(void)
+{
+    if (next_version_tag_lock == NULL) {
+        next_version_tag_lock = PyThread_allocate_lock();
+        if (next_version_tag_lock == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    if (share_static_subclasses(&PyBaseObject_Type) < 0) {
+        return -1;
+    }
+    static_types_shared = 1;
+    return 0;
+}
+
+/* Only the main interpreter registers the subclasses of static types: the
+   tp_subclasses dict of a static type is not protected by a lock. */
+static int
+is_shared_base(PyTypeObject *base)
+{
+    return (!_PyType_HasFeature(base, Py_TPFLAGS_HEAPTYPE)
+            && _PyInterpreterState_GET()->config._isolated_interpreter);
+}
+#endif
+
 
 static int
 add_subclass(PyTypeObject *base, PyTypeObject *type)
@@ -6466,6 +6586,11 @@ add_subclass(PyTypeObject *base, PyTypeObject *type)
     int result = -1;
     PyObject *dict, *key, *newobj;
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (is_shared_base(base)) {
+        return 0;
+    }
+#endif
     dict = base->tp_subclasses;
     if (dict == NULL) {
         base->tp_subclasses = dict = PyDict_New();
@@ -6508,6 +6633,11 @@ remove_subclass(PyTypeObject *base, PyTypeObject *type)
 {
     PyObject *dict, *key;
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (is_shared_base(base)) {
+        return;
+    }
+#endif
     dict = base->tp_subclasses;
     if (dict == NULL) {
         return;
@@ -15696,6 +15696,31 @@ _PyUnicode_ClearInterned(PyInterpreterState *interp)
 }
 
 
+void
+_PyUnicode_ImmortalizeInterned(PyInterpreterState *interp)
+{
+    struct _Py_unicode_state *state = &interp->unicode;
+    if (state->interned == NULL) {
+        return;
+    }
+
+    Py_ssize_t pos = 0;
+    PyObject *s, *ignored_value;
+    while (PyDict_Next(state->interned, &pos, &s, &ignored_value)) {
+        if (_Py_IsImmortal(s)) {
+            continue;
+        }
+#ifdef Py_REF_DEBUG
+        /* _Py_RefTotal counts the two references of the interned dict,
+           which refcnt doesn't count: _PyUnicode_ClearInterned() won't
+           release them. */
+        _Py_RefTotal -= 2;
+#endif
+        _Py_SetImmortal(s);
+    }
+}
+
+
 /********************* Unicode Iterator **************************/
 
 typedef struct {
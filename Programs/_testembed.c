@@ -539,6 +539,14 @@ static int test_init_from_config(void)
     putenv("PYTHONMALLOCSTATS=0");
     config.malloc_stats = 1;
 
+    putenv("PYTHONFREELISTS=float:1");
+    config.float_freelist_size = 200;
+    config.dict_freelist_size = 0;
+    config.adaptive_freelists = 1;
+
+    putenv("PYTHONMALLOCARENAS=retain=1");
+    config.malloc_arenas_retained = 2;
+
     putenv("PYTHONPYCACHEPREFIX=env_pycache_prefix");
     config_set_string(&config, &config.pycache_prefix, L"conf_pycache_prefix");
 
@@ -692,6 +700,8 @@ static void set_most_env_vars(void)
     putenv("PYTHONPROFILEIMPORTTIME=1");
     putenv("PYTHONNODEBUGRANGES=1");
     putenv("PYTHONMALLOCSTATS=1");
+    putenv("PYTHONFREELISTS=list:50,adaptive");
+    putenv("PYTHONMALLOCARENAS=retain=3");
     putenv("PYTHONUTF8=1");
     putenv("PYTHONVERBOSE=1");
     putenv("PYTHONINSPECT=1");
@@ -14,8 +14,10 @@
 #include "pycore_call.h"          // _PyObject_FastCallDictTstate()
 #include "pycore_ceval.h"         // _PyEval_SignalAsyncExc()
 #include "pycore_code.h"
+#include "pycore_descrobject.h"   // _PyPropertyObject
 #include "pycore_function.h"
 #include "pycore_initconfig.h"    // _PyStatus_OK()
+#include "pycore_list.h"          // _PyListIterObject
 #include "pycore_long.h"          // _PyLong_GetZero()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_moduleobject.h"  // PyModuleObject
@@ -23,6 +25,9 @@
 #include "pycore_pylifecycle.h"   // _PyErr_Print()
 #include "pycore_pymem.h"         // _PyMem_IsPtrFreed()
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
+#include "pycore_setobject.h"     // _PySet_Contains()
+#include "pycore_sliceobject.h"   // _PySlice_UnpackSmall()
+#include "pycore_range.h"         // _PyRangeIterObject
 #include "pycore_sysmodule.h"     // _PySys_Audit()
 #include "pycore_tuple.h"         // _PyTuple_ITEMS()
 
@@ -102,6 +107,10 @@ static InterpreterFrame *
 _PyEvalFramePushAndInit(PyThreadState *tstate, PyFunctionObject *func,
                         PyObject *locals, PyObject* const* args,
                         size_t argcount, PyObject *kwnames);
+static InterpreterFrame *
+_PyEvalFramePushAndInit_Ex(PyThreadState *tstate, PyFunctionObject *func,
+                           PyObject *locals, PyObject *callargs,
+                           PyObject *kwargs);
 static void
 _PyEvalFrameClearAndPop(PyThreadState *tstate, InterpreterFrame *frame);
 
@@ -305,7 +314,7 @@ _PyEval_InitGIL(PyThreadState *tstate)
     PyThread_init_thread();
     create_gil(gil);
 
-    take_gil(tstate);
+    take_gil(tstate, 0);
 
     assert(gil_created(gil));
     return _PyStatus_OK();
@@ -359,7 +368,7 @@ PyEval_AcquireLock(void)
     PyThreadState *tstate = _PyRuntimeState_GetThreadState(runtime);
     _Py_EnsureTstateNotNULL(tstate);
 
-    take_gil(tstate);
+    take_gil(tstate, 0);
 }
 
 void
@@ -380,7 +389,14 @@ _PyEval_ReleaseLock(PyThreadState *tstate)
 {
     struct _ceval_runtime_state *ceval = &tstate->interp->runtime->ceval;
     struct _ceval_state *ceval2 = &tstate->interp->ceval;
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    /* The thread state is being deleted: don't wait for another thread to
+       take the GIL, since the interpreter and its GIL may be finalized and
+       freed as soon as the GIL is released. */
+    drop_gil(ceval, ceval2, NULL);
+#else
     drop_gil(ceval, ceval2, tstate);
+#endif
 }
 
 void
@@ -388,7 +404,7 @@ PyEval_AcquireThread(PyThreadState *tstate)
 {
     _Py_EnsureTstateNotNULL(tstate);
 
-    take_gil(tstate);
+    take_gil(tstate, 0);
 
     struct _gilstate_runtime_state *gilstate = &tstate->interp->runtime->gilstate;
 #ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
@@ -434,7 +450,7 @@ _PyEval_ReInitThreads(PyThreadState *tstate)
     }
     recreate_gil(gil);
 
-    take_gil(tstate);
+    take_gil(tstate, 0);
 
     struct _pending_calls *pending = &tstate->interp->ceval.pending;
     if (_PyThread_at_fork_reinit(&pending->lock) < 0) {
@@ -484,7 +500,7 @@ PyEval_RestoreThread(PyThreadState *tstate)
 {
     _Py_EnsureTstateNotNULL(tstate);
 
-    take_gil(tstate);
+    take_gil(tstate, 1);
 
     struct _gilstate_runtime_state *gilstate = &tstate->interp->runtime->gilstate;
     _PyThreadState_Swap(gilstate, tstate);
@@ -1197,7 +1213,7 @@ eval_frame_handle_pending(PyThreadState *tstate)
 
         /* Other threads may run now */
 
-        take_gil(tstate);
+        take_gil(tstate, 0);
 
 #ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
         (void)_PyThreadState_Swap(&runtime->gilstate, tstate);
@@ -1319,11 +1335,20 @@ eval_frame_handle_pending(PyThreadState *tstate)
 /* RECORD_DXPROFILE()  records the dxprofile information, if enabled. Normally a no-op */
 #ifdef DYNAMIC_EXECUTION_PROFILE
 #ifdef DXPAIRS
+/* Pairs are recorded for the unquickened instructions, and only when the
+   second instruction directly follows the first one in the code, as only
+   those pairs can be turned into superinstructions.  See
+   Tools/scripts/generate_superinstructions.py. */
 #define RECORD_DXPROFILE() \
     do { \
-        dxpairs[lastopcode][opcode]++; \
-        lastopcode = opcode; \
-        dxp[opcode]++; \
+        int base_opcode = _Py_OPCODE(((_Py_CODEUNIT *)PyBytes_AS_STRING( \
+            frame->f_code->co_code))[INSTR_OFFSET()]); \
+        if (next_instr == lastinstr + 1) { \
+            dxpairs[lastopcode][base_opcode]++; \
+        } \
+        lastopcode = base_opcode; \
+        lastinstr = next_instr; \
+        dxp[base_opcode]++; \
     } while (0)
 #else
   #define RECORD_DXPROFILE() \
@@ -1664,6 +1689,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
 
 #ifdef DXPAIRS
     int lastopcode = 0;
+    _Py_CODEUNIT *lastinstr = NULL;
 #endif
     int opcode;        /* Current opcode */
     int oparg;         /* Current opcode argument, if any */
@@ -2286,6 +2312,179 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(BINARY_SUBSCR_BYTES_INT) {
+            PyObject *sub = TOP();
+            PyObject *bytes = SECOND();
+            DEOPT_IF(!PyLong_CheckExact(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyBytes_CheckExact(bytes), BINARY_SUBSCR);
+
+            // Deopt unless 0 <= sub < PyBytes_Size(bytes)
+            Py_ssize_t signed_magnitude = Py_SIZE(sub);
+            DEOPT_IF(((size_t)signed_magnitude) > 1, BINARY_SUBSCR);
+            assert(((PyLongObject *)_PyLong_GetZero())->ob_digit[0] == 0);
+            Py_ssize_t index = ((PyLongObject*)sub)->ob_digit[0];
+            DEOPT_IF(index >= PyBytes_GET_SIZE(bytes), BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            unsigned char c = PyBytes_AS_STRING(bytes)[index];
+            PyObject *res = _PyLong_GetUnsignedChar(c);
+            Py_INCREF(res);
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(bytes);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_BYTEARRAY_INT) {
+            PyObject *sub = TOP();
+            PyObject *bytearray = SECOND();
+            DEOPT_IF(!PyLong_CheckExact(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyByteArray_CheckExact(bytearray), BINARY_SUBSCR);
+
+            // Deopt unless 0 <= sub < PyByteArray_Size(bytearray)
+            Py_ssize_t signed_magnitude = Py_SIZE(sub);
+            DEOPT_IF(((size_t)signed_magnitude) > 1, BINARY_SUBSCR);
+            assert(((PyLongObject *)_PyLong_GetZero())->ob_digit[0] == 0);
+            Py_ssize_t index = ((PyLongObject*)sub)->ob_digit[0];
+            DEOPT_IF(index >= PyByteArray_GET_SIZE(bytearray), BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            unsigned char c = PyByteArray_AS_STRING(bytearray)[index];
+            PyObject *res = _PyLong_GetUnsignedChar(c);
+            Py_INCREF(res);
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(bytearray);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_STR_INT) {
+            PyObject *sub = TOP();
+            PyObject *str = SECOND();
+            DEOPT_IF(!PyLong_CheckExact(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyUnicode_CheckExact(str), BINARY_SUBSCR);
+            DEOPT_IF(!PyUnicode_IS_READY(str), BINARY_SUBSCR);
+            DEOPT_IF(PyUnicode_KIND(str) != PyUnicode_1BYTE_KIND, BINARY_SUBSCR);
+
+            // Deopt unless 0 <= sub < PyUnicode_GET_LENGTH(str)
+            Py_ssize_t signed_magnitude = Py_SIZE(sub);
+            DEOPT_IF(((size_t)signed_magnitude) > 1, BINARY_SUBSCR);
+            assert(((PyLongObject *)_PyLong_GetZero())->ob_digit[0] == 0);
+            Py_ssize_t index = ((PyLongObject*)sub)->ob_digit[0];
+            DEOPT_IF(index >= PyUnicode_GET_LENGTH(str), BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            Py_UCS1 c = PyUnicode_1BYTE_DATA(str)[index];
+            // One-character latin-1 strings are cached singletons
+            PyObject *res = tstate->interp->unicode.latin1[c];
+            if (res != NULL) {
+                Py_INCREF(res);
+            }
+            else {
+                res = PyUnicode_FromOrdinal(c);
+                if (res == NULL) {
+                    goto error;
+                }
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(str);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_SEQUENCE_INT) {
+            PyObject *sub = TOP();
+            PyObject *container = SECOND();
+            _PyAdaptiveEntry *cache0 = &GET_CACHE()->adaptive;
+            PyTypeObject *tp = Py_TYPE(container);
+            DEOPT_IF(tp->tp_version_tag != cache0->version, BINARY_SUBSCR);
+            DEOPT_IF(!PyLong_CheckExact(sub), BINARY_SUBSCR);
+
+            // Deopt unless 0 <= sub, sq_item checks the upper bound
+            DEOPT_IF(((size_t)Py_SIZE(sub)) > 1, BINARY_SUBSCR);
+            Py_ssize_t index = ((PyLongObject*)sub)->ob_digit[0];
+            STAT_INC(BINARY_SUBSCR, hit);
+            PyObject *res = tp->tp_as_sequence->sq_item(container, index);
+            if (res == NULL) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(container);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_LIST_SLICE) {
+            PyObject *sub = TOP();
+            PyObject *list = SECOND();
+            Py_ssize_t start, stop;
+            DEOPT_IF(!PySlice_Check(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyList_CheckExact(list), BINARY_SUBSCR);
+            DEOPT_IF(!_PySlice_UnpackSmall(sub, PyList_GET_SIZE(list),
+                                           &start, &stop), BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            PyObject *res = PyList_GetSlice(list, start, stop);
+            if (res == NULL) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(list);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_STR_SLICE) {
+            PyObject *sub = TOP();
+            PyObject *str = SECOND();
+            Py_ssize_t start, stop;
+            DEOPT_IF(!PySlice_Check(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyUnicode_CheckExact(str), BINARY_SUBSCR);
+            DEOPT_IF(!PyUnicode_IS_READY(str), BINARY_SUBSCR);
+            DEOPT_IF(!_PySlice_UnpackSmall(sub, PyUnicode_GET_LENGTH(str),
+                                           &start, &stop), BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            PyObject *res = PyUnicode_Substring(str, start, stop);
+            if (res == NULL) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(str);
+            DISPATCH();
+        }
+
+        TARGET(BINARY_SUBSCR_BYTES_SLICE) {
+            PyObject *sub = TOP();
+            PyObject *bytes = SECOND();
+            Py_ssize_t start, stop;
+            DEOPT_IF(!PySlice_Check(sub), BINARY_SUBSCR);
+            DEOPT_IF(!PyBytes_CheckExact(bytes), BINARY_SUBSCR);
+            Py_ssize_t size = PyBytes_GET_SIZE(bytes);
+            DEOPT_IF(!_PySlice_UnpackSmall(sub, size, &start, &stop),
+                     BINARY_SUBSCR);
+            STAT_INC(BINARY_SUBSCR, hit);
+            PyObject *res;
+            if (start == 0 && stop == size) {
+                res = bytes;
+                Py_INCREF(res);
+            }
+            else {
+                res = PyBytes_FromStringAndSize(
+                    PyBytes_AS_STRING(bytes) + start, stop - start);
+                if (res == NULL) {
+                    goto error;
+                }
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            Py_DECREF(bytes);
+            DISPATCH();
+        }
+
         TARGET(BINARY_SUBSCR_GETITEM) {
             PyObject *sub = TOP();
             PyObject *container = SECOND();
@@ -2402,6 +2601,33 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(STORE_SUBSCR_BYTEARRAY_INT) {
+            PyObject *sub = TOP();
+            PyObject *bytearray = SECOND();
+            PyObject *value = THIRD();
+            DEOPT_IF(!PyLong_CheckExact(sub), STORE_SUBSCR);
+            DEOPT_IF(!PyByteArray_CheckExact(bytearray), STORE_SUBSCR);
+            DEOPT_IF(!PyLong_CheckExact(value), STORE_SUBSCR);
+
+            // Ensure nonnegative, zero-or-one-digit ints.
+            DEOPT_IF(((size_t)Py_SIZE(sub)) > 1, STORE_SUBSCR);
+            Py_ssize_t index = ((PyLongObject*)sub)->ob_digit[0];
+            // Ensure index < len(bytearray)
+            DEOPT_IF(index >= PyByteArray_GET_SIZE(bytearray), STORE_SUBSCR);
+            // Ensure 0 <= value < 256
+            DEOPT_IF(((size_t)Py_SIZE(value)) > 1, STORE_SUBSCR);
+            digit byte = ((PyLongObject*)value)->ob_digit[0];
+            DEOPT_IF(byte > 255, STORE_SUBSCR);
+            STAT_INC(STORE_SUBSCR, hit);
+
+            PyByteArray_AS_STRING(bytearray)[index] = (char)byte;
+            STACK_SHRINK(3);
+            Py_DECREF(value);
+            Py_DECREF(sub);
+            Py_DECREF(bytearray);
+            DISPATCH();
+        }
+
         TARGET(STORE_SUBSCR_DICT) {
             PyObject *sub = TOP();
             PyObject *dict = SECOND();
@@ -2911,6 +3137,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
 
         TARGET(UNPACK_SEQUENCE) {
             PREDICTED(UNPACK_SEQUENCE);
+            STAT_INC(UNPACK_SEQUENCE, unquickened);
             PyObject *seq = POP(), *item, **items;
             if (PyTuple_CheckExact(seq) &&
                 PyTuple_GET_SIZE(seq) == oparg) {
@@ -2940,6 +3167,72 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(UNPACK_SEQUENCE_ADAPTIVE) {
+            SpecializedCacheEntry *cache = GET_CACHE();
+            if (cache->adaptive.counter == 0) {
+                PyObject *seq = TOP();
+                next_instr--;
+                _Py_Specialize_UnpackSequence(seq, next_instr, cache);
+                DISPATCH();
+            }
+            else {
+                STAT_INC(UNPACK_SEQUENCE, deferred);
+                cache->adaptive.counter--;
+                oparg = cache->adaptive.original_oparg;
+                STAT_DEC(UNPACK_SEQUENCE, unquickened);
+                JUMP_TO_INSTRUCTION(UNPACK_SEQUENCE);
+            }
+        }
+
+        TARGET(UNPACK_SEQUENCE_TWO_TUPLE) {
+            PyObject *seq = TOP();
+            DEOPT_IF(!PyTuple_CheckExact(seq), UNPACK_SEQUENCE);
+            DEOPT_IF(PyTuple_GET_SIZE(seq) != 2, UNPACK_SEQUENCE);
+            STAT_INC(UNPACK_SEQUENCE, hit);
+            PyObject *first = PyTuple_GET_ITEM(seq, 0);
+            PyObject *second = PyTuple_GET_ITEM(seq, 1);
+            Py_INCREF(first);
+            Py_INCREF(second);
+            SET_TOP(second);
+            PUSH(first);
+            Py_DECREF(seq);
+            DISPATCH();
+        }
+
+        TARGET(UNPACK_SEQUENCE_TUPLE) {
+            PyObject *seq = TOP();
+            int len = GET_CACHE()->adaptive.original_oparg;
+            DEOPT_IF(!PyTuple_CheckExact(seq), UNPACK_SEQUENCE);
+            DEOPT_IF(PyTuple_GET_SIZE(seq) != len, UNPACK_SEQUENCE);
+            STAT_INC(UNPACK_SEQUENCE, hit);
+            STACK_SHRINK(1);
+            PyObject **items = _PyTuple_ITEMS(seq);
+            while (len--) {
+                PyObject *item = items[len];
+                Py_INCREF(item);
+                PUSH(item);
+            }
+            Py_DECREF(seq);
+            DISPATCH();
+        }
+
+        TARGET(UNPACK_SEQUENCE_LIST) {
+            PyObject *seq = TOP();
+            int len = GET_CACHE()->adaptive.original_oparg;
+            DEOPT_IF(!PyList_CheckExact(seq), UNPACK_SEQUENCE);
+            DEOPT_IF(PyList_GET_SIZE(seq) != len, UNPACK_SEQUENCE);
+            STAT_INC(UNPACK_SEQUENCE, hit);
+            STACK_SHRINK(1);
+            PyObject **items = _PyList_ITEMS(seq);
+            while (len--) {
+                PyObject *item = items[len];
+                Py_INCREF(item);
+                PUSH(item);
+            }
+            Py_DECREF(seq);
+            DISPATCH();
+        }
+
         TARGET(UNPACK_EX) {
             int totalargs = 1 + (oparg & 0xFF) + (oparg >> 8);
             PyObject *seq = POP();
@@ -2983,6 +3276,8 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
         }
 
         TARGET(STORE_GLOBAL) {
+            PREDICTED(STORE_GLOBAL);
+            STAT_INC(STORE_GLOBAL, unquickened);
             PyObject *name = GETITEM(names, oparg);
             PyObject *v = POP();
             int err;
@@ -2993,6 +3288,50 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(STORE_GLOBAL_ADAPTIVE) {
+            assert(cframe.use_tracing == 0);
+            SpecializedCacheEntry *cache = GET_CACHE();
+            if (cache->adaptive.counter == 0) {
+                PyObject *name = GETITEM(names, cache->adaptive.original_oparg);
+                next_instr--;
+                if (_Py_Specialize_StoreGlobal(GLOBALS(), next_instr, name, cache) < 0) {
+                    goto error;
+                }
+                DISPATCH();
+            }
+            else {
+                STAT_INC(STORE_GLOBAL, deferred);
+                cache->adaptive.counter--;
+                oparg = cache->adaptive.original_oparg;
+                STAT_DEC(STORE_GLOBAL, unquickened);
+                JUMP_TO_INSTRUCTION(STORE_GLOBAL);
+            }
+        }
+
+        TARGET(STORE_GLOBAL_MODULE) {
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(!PyDict_CheckExact(GLOBALS()), STORE_GLOBAL);
+            PyDictObject *dict = (PyDictObject *)GLOBALS();
+            _PyAdaptiveEntry *cache0 = &GET_CACHE()->adaptive;
+            PyObject *name = GETITEM(names, cache0->original_oparg);
+            DEOPT_IF(cache0->index >= dict->ma_keys->dk_nentries, STORE_GLOBAL);
+            PyDictKeyEntry *ep = DK_ENTRIES(dict->ma_keys) + cache0->index;
+            DEOPT_IF(ep->me_key != name, STORE_GLOBAL);
+            PyObject *old_value = ep->me_value;
+            DEOPT_IF(old_value == NULL, STORE_GLOBAL);
+            STAT_INC(STORE_GLOBAL, hit);
+            PyObject *value = POP();
+            ep->me_value = value;
+            /* Ensure dict is GC tracked if it needs to be */
+            if (!_PyObject_GC_IS_TRACKED(dict) && _PyObject_GC_MAY_BE_TRACKED(value)) {
+                _PyObject_GC_TRACK(dict);
+            }
+            /* PEP 509 */
+            dict->ma_version_tag = DICT_NEXT_VERSION();
+            Py_DECREF(old_value);
+            DISPATCH();
+        }
+
         TARGET(DELETE_GLOBAL) {
             PyObject *name = GETITEM(names, oparg);
             int err;
@@ -3145,11 +3484,13 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             assert(cframe.use_tracing == 0);
             DEOPT_IF(!PyDict_CheckExact(GLOBALS()), LOAD_GLOBAL);
             PyDictObject *dict = (PyDictObject *)GLOBALS();
-            SpecializedCacheEntry *caches = GET_CACHE();
-            _PyAdaptiveEntry *cache0 = &caches[0].adaptive;
-            _PyLoadGlobalCache *cache1 = &caches[-1].load_global;
-            DEOPT_IF(dict->ma_keys->dk_version != cache1->module_keys_version, LOAD_GLOBAL);
+            _PyAdaptiveEntry *cache0 = &GET_CACHE()->adaptive;
+            PyObject *name = GETITEM(names, cache0->original_oparg);
+            // The entries of a keys object are never moved, so the entry
+            // is still ours if it has our key, whatever else was changed.
+            DEOPT_IF(cache0->index >= dict->ma_keys->dk_nentries, LOAD_GLOBAL);
             PyDictKeyEntry *ep = DK_ENTRIES(dict->ma_keys) + cache0->index;
+            DEOPT_IF(ep->me_key != name, LOAD_GLOBAL);
             PyObject *res = ep->me_value;
             DEOPT_IF(res == NULL, LOAD_GLOBAL);
             STAT_INC(LOAD_GLOBAL, hit);
@@ -3671,6 +4012,95 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(LOAD_ATTR_PROPERTY) {
+            assert(cframe.use_tracing == 0);
+            PyObject *owner = TOP();
+            PyTypeObject *tp = Py_TYPE(owner);
+            SpecializedCacheEntry *caches = GET_CACHE();
+            _PyAdaptiveEntry *cache0 = &caches[0].adaptive;
+            _PyAttrCache *cache1 = &caches[-1].attr;
+            _PyObjectCache *cache2 = &caches[-2].obj;
+            assert(cache1->tp_version != 0);
+            DEOPT_IF(tp->tp_version_tag != cache1->tp_version, LOAD_ATTR);
+            _PyPropertyObject *prop = (_PyPropertyObject *)cache2->obj;
+            assert(Py_IS_TYPE(prop, &PyProperty_Type));
+            PyObject *fget = prop->prop_get;
+            DEOPT_IF(fget == NULL || !PyFunction_Check(fget), LOAD_ATTR);
+            PyFunctionObject *func = (PyFunctionObject *)fget;
+            DEOPT_IF(func->func_version != cache0->version, LOAD_ATTR);
+            /* PEP 523 */
+            DEOPT_IF(tstate->interp->eval_frame != NULL, LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            /* Call the getter as CALL_FUNCTION_PY_SIMPLE would, with the
+               owner as its only argument. The result is pushed onto
+               this frame's stack when the getter returns. */
+            PyCodeObject *code = (PyCodeObject *)func->func_code;
+            assert(code->co_argcount == 1);
+            size_t size = code->co_nlocalsplus + code->co_stacksize + FRAME_SPECIALS_SIZE;
+            InterpreterFrame *new_frame = _PyThreadState_BumpFramePointer(tstate, size);
+            if (new_frame == NULL) {
+                goto error;
+            }
+            _PyFrame_InitializeSpecials(new_frame, func,
+                                        NULL, code->co_nlocalsplus);
+            STACK_SHRINK(1);
+            new_frame->localsplus[0] = owner;
+            for (int i = 1; i < code->co_nlocalsplus; i++) {
+                new_frame->localsplus[i] = NULL;
+            }
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            new_frame->previous = frame;
+            new_frame->depth = frame->depth + 1;
+            frame = cframe.current_frame = new_frame;
+            goto start_frame;
+        }
+
+        TARGET(LOAD_ATTR_CLASS) {
+            assert(cframe.use_tracing == 0);
+            PyObject *owner = TOP();
+            SpecializedCacheEntry *caches = GET_CACHE();
+            _PyAdaptiveEntry *cache0 = &caches[0].adaptive;
+            _PyAttrCache *cache1 = &caches[-1].attr;
+            _PyObjectCache *cache2 = &caches[-2].obj;
+            assert(cache1->tp_version != 0);
+            DEOPT_IF(!PyType_Check(owner), LOAD_ATTR);
+            DEOPT_IF(((PyTypeObject *)owner)->tp_version_tag != cache1->tp_version, LOAD_ATTR);
+            DEOPT_IF(Py_TYPE(owner)->tp_version_tag != cache0->version, LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            PyObject *res = cache2->obj;
+            assert(res != NULL);
+            Py_INCREF(res);
+            SET_TOP(res);
+            Py_DECREF(owner);
+            DISPATCH();
+        }
+
+        TARGET(LOAD_ATTR_NONDESCRIPTOR) {
+            assert(cframe.use_tracing == 0);
+            PyObject *owner = TOP();
+            PyTypeObject *tp = Py_TYPE(owner);
+            SpecializedCacheEntry *caches = GET_CACHE();
+            _PyAttrCache *cache1 = &caches[-1].attr;
+            _PyObjectCache *cache2 = &caches[-2].obj;
+            assert(cache1->tp_version != 0);
+            DEOPT_IF(tp->tp_version_tag != cache1->tp_version, LOAD_ATTR);
+            if (tp->tp_dictoffset) {
+                /* The instance has no dict and its values
+                   cannot hold the name */
+                assert(tp->tp_inline_values_offset > 0);
+                PyDictObject *dict = *(PyDictObject **)(((char *)owner) + tp->tp_dictoffset);
+                DEOPT_IF(dict != NULL, LOAD_ATTR);
+                DEOPT_IF(((PyHeapTypeObject *)tp)->ht_cached_keys->dk_version != cache1->dk_version_or_hint, LOAD_ATTR);
+            }
+            STAT_INC(LOAD_ATTR, hit);
+            PyObject *res = cache2->obj;
+            assert(res != NULL);
+            Py_INCREF(res);
+            SET_TOP(res);
+            Py_DECREF(owner);
+            DISPATCH();
+        }
+
         TARGET(STORE_ATTR_ADAPTIVE) {
             assert(cframe.use_tracing == 0);
             SpecializedCacheEntry *cache = GET_CACHE();
@@ -3928,6 +4358,8 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
         }
 
         TARGET(CONTAINS_OP) {
+            PREDICTED(CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, unquickened);
             PyObject *right = POP();
             PyObject *left = POP();
             int res = PySequence_Contains(right, left);
@@ -3944,9 +4376,204 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
-        TARGET(JUMP_IF_NOT_EXC_MATCH) {
-            PyObject *right = POP();
-            ASSERT_EXC_TYPE_IS_REDUNDANT(TOP(), SECOND());
+        TARGET(CONTAINS_OP_ADAPTIVE) {
+            assert(cframe.use_tracing == 0);
+            SpecializedCacheEntry *cache = GET_CACHE();
+            if (cache->adaptive.counter == 0) {
+                PyObject *right = TOP();
+                next_instr--;
+                _Py_Specialize_ContainsOp(right, next_instr, cache);
+                DISPATCH();
+            }
+            else {
+                STAT_INC(CONTAINS_OP, deferred);
+                cache->adaptive.counter--;
+                oparg = cache->adaptive.original_oparg;
+                STAT_DEC(CONTAINS_OP, unquickened);
+                JUMP_TO_INSTRUCTION(CONTAINS_OP);
+            }
+        }
+
+        TARGET(CONTAINS_OP_DICT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PyDict_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = PyDict_Contains(right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            int invert = GET_CACHE()->adaptive.original_oparg;
+            PyObject *b = (res^invert) ? Py_True : Py_False;
+            Py_INCREF(b);
+            PUSH(b);
+            DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_DICT_JUMP) {
+            assert(cframe.use_tracing == 0);
+            // Combined: CONTAINS_OP (dict) + POP_JUMP_IF_(true/false)
+            SpecializedCacheEntry *caches = GET_CACHE();
+            int when_to_jump = caches[0].adaptive.index;
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PyDict_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = PyDict_Contains(right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            NEXTOPARG();
+            assert(opcode == POP_JUMP_IF_TRUE || opcode == POP_JUMP_IF_FALSE);
+            if (res != when_to_jump) {
+                next_instr++;
+                NOTRACE_DISPATCH();
+            }
+            else {
+                JUMPTO(oparg);
+                CHECK_EVAL_BREAKER();
+                NOTRACE_DISPATCH();
+            }
+        }
+
+        TARGET(CONTAINS_OP_SET) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PySet_CheckExact(right) && !PyFrozenSet_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = _PySet_Contains((PySetObject *)right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            int invert = GET_CACHE()->adaptive.original_oparg;
+            PyObject *b = (res^invert) ? Py_True : Py_False;
+            Py_INCREF(b);
+            PUSH(b);
+            DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_SET_JUMP) {
+            assert(cframe.use_tracing == 0);
+            // Combined: CONTAINS_OP (set or frozenset) + POP_JUMP_IF_(true/false)
+            SpecializedCacheEntry *caches = GET_CACHE();
+            int when_to_jump = caches[0].adaptive.index;
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PySet_CheckExact(right) && !PyFrozenSet_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = _PySet_Contains((PySetObject *)right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            NEXTOPARG();
+            assert(opcode == POP_JUMP_IF_TRUE || opcode == POP_JUMP_IF_FALSE);
+            if (res != when_to_jump) {
+                next_instr++;
+                NOTRACE_DISPATCH();
+            }
+            else {
+                JUMPTO(oparg);
+                CHECK_EVAL_BREAKER();
+                NOTRACE_DISPATCH();
+            }
+        }
+
+        TARGET(CONTAINS_OP_STR) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PyUnicode_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = PyUnicode_Contains(right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            int invert = GET_CACHE()->adaptive.original_oparg;
+            PyObject *b = (res^invert) ? Py_True : Py_False;
+            Py_INCREF(b);
+            PUSH(b);
+            DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_STR_JUMP) {
+            assert(cframe.use_tracing == 0);
+            // Combined: CONTAINS_OP (str) + POP_JUMP_IF_(true/false)
+            SpecializedCacheEntry *caches = GET_CACHE();
+            int when_to_jump = caches[0].adaptive.index;
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PyUnicode_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = PyUnicode_Contains(right, left);
+            STACK_SHRINK(2);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            if (res < 0) {
+                goto error;
+            }
+            NEXTOPARG();
+            assert(opcode == POP_JUMP_IF_TRUE || opcode == POP_JUMP_IF_FALSE);
+            if (res != when_to_jump) {
+                next_instr++;
+                NOTRACE_DISPATCH();
+            }
+            else {
+                JUMPTO(oparg);
+                CHECK_EVAL_BREAKER();
+                NOTRACE_DISPATCH();
+            }
+        }
+
+        TARGET(IS_OP__POP_JUMP_IF_FALSE) {
+            PyObject *right = POP();
+            PyObject *left = POP();
+            int res = Py_Is(left, right) ^ oparg;
+            Py_DECREF(left);
+            Py_DECREF(right);
+            NEXTOPARG();
+            next_instr++;
+            if (!res) {
+                JUMPTO(oparg);
+                CHECK_EVAL_BREAKER();
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(IS_OP__POP_JUMP_IF_TRUE) {
+            PyObject *right = POP();
+            PyObject *left = POP();
+            int res = Py_Is(left, right) ^ oparg;
+            Py_DECREF(left);
+            Py_DECREF(right);
+            NEXTOPARG();
+            next_instr++;
+            if (res) {
+                JUMPTO(oparg);
+                CHECK_EVAL_BREAKER();
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(JUMP_IF_NOT_EXC_MATCH) {
+            PyObject *right = POP();
+            ASSERT_EXC_TYPE_IS_REDUNDANT(TOP(), SECOND());
             PyObject *left = SECOND();
             assert(PyExceptionInstance_Check(left));
             if (check_except_type_valid(tstate, right) < 0) {
@@ -4266,6 +4893,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
 
         TARGET(FOR_ITER) {
             PREDICTED(FOR_ITER);
+            STAT_INC(FOR_ITER, unquickened);
             /* before: [iter]; after: [iter, iter()] *or* [] */
             PyObject *iter = TOP();
             PyObject *next = (*Py_TYPE(iter)->tp_iternext)(iter);
@@ -4291,6 +4919,112 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             DISPATCH();
         }
 
+        TARGET(FOR_ITER_ADAPTIVE) {
+            SpecializedCacheEntry *cache = GET_CACHE();
+            if (cache->adaptive.counter == 0) {
+                PyObject *iter = TOP();
+                next_instr--;
+                _Py_Specialize_ForIter(iter, next_instr, cache);
+                DISPATCH();
+            }
+            else {
+                STAT_INC(FOR_ITER, deferred);
+                cache->adaptive.counter--;
+                oparg = cache->adaptive.original_oparg;
+                STAT_DEC(FOR_ITER, unquickened);
+                JUMP_TO_INSTRUCTION(FOR_ITER);
+            }
+        }
+
+        TARGET(FOR_ITER_LIST) {
+            _PyListIterObject *it = (_PyListIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(it) != &PyListIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            PyListObject *seq = it->it_seq;
+            if (seq != NULL) {
+                if (it->it_index < PyList_GET_SIZE(seq)) {
+                    PyObject *next = PyList_GET_ITEM(seq, it->it_index++);
+                    Py_INCREF(next);
+                    PUSH(next);
+                    DISPATCH();
+                }
+                it->it_seq = NULL;
+                Py_DECREF(seq);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(it);
+            JUMPBY(GET_CACHE()->adaptive.original_oparg);
+            DISPATCH();
+        }
+
+        TARGET(FOR_ITER_TUPLE) {
+            _PyTupleIterObject *it = (_PyTupleIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(it) != &PyTupleIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            PyTupleObject *seq = it->it_seq;
+            if (seq != NULL) {
+                if (it->it_index < PyTuple_GET_SIZE(seq)) {
+                    PyObject *next = PyTuple_GET_ITEM(seq, it->it_index++);
+                    Py_INCREF(next);
+                    PUSH(next);
+                    DISPATCH();
+                }
+                it->it_seq = NULL;
+                Py_DECREF(seq);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(it);
+            JUMPBY(GET_CACHE()->adaptive.original_oparg);
+            DISPATCH();
+        }
+
+        TARGET(FOR_ITER_RANGE) {
+            _PyRangeIterObject *r = (_PyRangeIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(r) != &PyRangeIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            if (r->index >= r->len) {
+                STACK_SHRINK(1);
+                Py_DECREF(r);
+                JUMPBY(GET_CACHE()->adaptive.original_oparg);
+                DISPATCH();
+            }
+            /* The following instruction is a STORE_FAST, or a
+             * superinstruction starting with one. Do the store here
+             * and skip it. */
+            _Py_CODEUNIT store = *next_instr;
+            long value = (long)(r->start +
+                                (unsigned long)(r->index++) * r->step);
+            if (_PyLong_AssignValue(&GETLOCAL(_Py_OPARG(store)), value) < 0) {
+                goto error;
+            }
+            JUMPBY(1);
+            DISPATCH();
+        }
+
+        TARGET(FOR_ITER_GEN) {
+            PyObject *gen = TOP();
+            DEOPT_IF(!PyGen_CheckExact(gen), FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            /* Resume the generator directly through its send slot, so
+             * that returning a value never materializes StopIteration. */
+            PyObject *next;
+            PySendResult gen_status = PyIter_Send(gen, Py_None, &next);
+            if (gen_status == PYGEN_NEXT) {
+                PUSH(next);
+                DISPATCH();
+            }
+            if (gen_status == PYGEN_ERROR) {
+                assert(next == NULL);
+                goto error;
+            }
+            assert(gen_status == PYGEN_RETURN);
+            Py_DECREF(next);
+            STACK_SHRINK(1);
+            Py_DECREF(gen);
+            JUMPBY(GET_CACHE()->adaptive.original_oparg);
+            DISPATCH();
+        }
+
         TARGET(BEFORE_ASYNC_WITH) {
             _Py_IDENTIFIER(__aenter__);
             _Py_IDENTIFIER(__aexit__);
@@ -4575,6 +5309,8 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
         }
 
         TARGET(CALL_METHOD) {
+            PREDICTED(CALL_METHOD);
+            STAT_INC(CALL_METHOD, unquickened);
             /* Designed to work in tamdem with LOAD_METHOD. */
             /* `meth` is NULL when LOAD_METHOD thinks that it's not
                 a method call.
@@ -4612,6 +5348,8 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
         TARGET(CALL_METHOD_KW) {
             /* Designed to work in tandem with LOAD_METHOD. Same as CALL_METHOD
             but pops TOS to get a tuple of keyword names. */
+            PREDICTED(CALL_METHOD_KW);
+            STAT_INC(CALL_METHOD_KW, unquickened);
             kwnames = POP();
             int is_method = (PEEK(oparg + 2) != NULL);
             oparg += is_method;
@@ -4620,6 +5358,276 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             goto call_function;
         }
 
+        TARGET(CALL_METHOD_ADAPTIVE) {
+            SpecializedCacheEntry *cache = GET_CACHE();
+            int original_oparg = cache->adaptive.original_oparg;
+            if (cache->adaptive.counter == 0) {
+                next_instr--;
+                int is_method = (PEEK(original_oparg + 2) != NULL);
+                int total_args = original_oparg + is_method;
+                if (_Py_Specialize_CallMethod(
+                    PEEK(total_args + 1), next_instr, total_args,
+                    is_method, cache) < 0) {
+                    goto error;
+                }
+                DISPATCH();
+            }
+            else {
+                STAT_INC(CALL_METHOD, deferred);
+                cache->adaptive.counter--;
+                oparg = original_oparg;
+                STAT_DEC(CALL_METHOD, unquickened);
+                JUMP_TO_INSTRUCTION(CALL_METHOD);
+            }
+        }
+
+        TARGET(CALL_METHOD_KW_ADAPTIVE) {
+            SpecializedCacheEntry *cache = GET_CACHE();
+            int original_oparg = cache->adaptive.original_oparg;
+            if (cache->adaptive.counter == 0) {
+                next_instr--;
+                PyObject *names = TOP();
+                int is_method = (PEEK(original_oparg + 3) != NULL);
+                int total_args = original_oparg + is_method;
+                if (_Py_Specialize_CallMethodKw(
+                    PEEK(total_args + 2), next_instr,
+                    total_args - (int)PyTuple_GET_SIZE(names), cache) < 0) {
+                    goto error;
+                }
+                DISPATCH();
+            }
+            else {
+                STAT_INC(CALL_METHOD_KW, deferred);
+                cache->adaptive.counter--;
+                oparg = original_oparg;
+                STAT_DEC(CALL_METHOD_KW, unquickened);
+                JUMP_TO_INSTRUCTION(CALL_METHOD_KW);
+            }
+        }
+
+        TARGET(CALL_METHOD_PY_SIMPLE) {
+            SpecializedCacheEntry *caches = GET_CACHE();
+            _PyAdaptiveEntry *cache0 = &caches[0].adaptive;
+            _PyCallCache *cache1 = &caches[-1].call;
+            int is_method = (PEEK(cache0->original_oparg + 2) != NULL);
+            DEOPT_IF(is_method != cache0->index, CALL_METHOD);
+            int argcount = cache0->original_oparg + is_method;
+            PyObject *callable = PEEK(argcount + 1);
+            DEOPT_IF(!PyFunction_Check(callable), CALL_METHOD);
+            PyFunctionObject *func = (PyFunctionObject *)callable;
+            DEOPT_IF(func->func_version != cache1->func_version, CALL_METHOD);
+            /* PEP 523 */
+            DEOPT_IF(tstate->interp->eval_frame != NULL, CALL_METHOD);
+            STAT_INC(CALL_METHOD, hit);
+            PyCodeObject *code = (PyCodeObject *)func->func_code;
+            size_t size = code->co_nlocalsplus + code->co_stacksize + FRAME_SPECIALS_SIZE;
+            InterpreterFrame *new_frame = _PyThreadState_BumpFramePointer(tstate, size);
+            if (new_frame == NULL) {
+                goto error;
+            }
+            _PyFrame_InitializeSpecials(new_frame, func,
+                                        NULL, code->co_nlocalsplus);
+            STACK_SHRINK(argcount);
+            for (int i = 0; i < argcount; i++) {
+                new_frame->localsplus[i] = stack_pointer[i];
+            }
+            int deflen = cache1->defaults_len;
+            for (int i = 0; i < deflen; i++) {
+                PyObject *def = PyTuple_GET_ITEM(func->func_defaults, cache1->defaults_start+i);
+                Py_INCREF(def);
+                new_frame->localsplus[argcount+i] = def;
+            }
+            for (int i = argcount+deflen; i < code->co_nlocalsplus; i++) {
+                new_frame->localsplus[i] = NULL;
+            }
+            /* Pop the function, and the NULL left by LOAD_METHOD if any */
+            STACK_SHRINK(2 - is_method);
+            Py_DECREF(func);
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            new_frame->previous = frame;
+            new_frame->depth = frame->depth + 1;
+            frame = cframe.current_frame = new_frame;
+            goto start_frame;
+        }
+
+        TARGET(CALL_METHOD_DESCRIPTOR_NOARGS) {
+            assert(cframe.use_tracing == 0);
+            /* Method descriptors with METH_NOARGS, called as self.meth() */
+            int original_oparg = GET_CACHE()->adaptive.original_oparg;
+            int is_method = (PEEK(original_oparg + 2) != NULL);
+            DEOPT_IF(original_oparg + is_method != 1, CALL_METHOD);
+            PyObject *self = TOP();
+            PyObject *callable = SECOND();
+            DEOPT_IF(!Py_IS_TYPE(callable, &PyMethodDescr_Type), CALL_METHOD);
+            PyMethodDescrObject *descr = (PyMethodDescrObject *)callable;
+            PyMethodDef *meth = descr->d_method;
+            DEOPT_IF(meth->ml_flags != METH_NOARGS, CALL_METHOD);
+            DEOPT_IF(!PyObject_TypeCheck(self, descr->d_common.d_type), CALL_METHOD);
+            STAT_INC(CALL_METHOD, hit);
+            PyCFunction cfunc = meth->ml_meth;
+            // This is slower but CPython promises to check all non-vectorcall
+            // function calls.
+            if (_Py_EnterRecursiveCall(tstate, " while calling a Python object")) {
+                goto error;
+            }
+            PyObject *res = cfunc(self, NULL);
+            _Py_LeaveRecursiveCall(tstate);
+            assert((res != NULL) ^ (_PyErr_Occurred(tstate) != NULL));
+
+            /* Clear the stack of the method and its NULL, if any. */
+            Py_DECREF(self);
+            Py_DECREF(callable);
+            STACK_SHRINK(original_oparg + 2);
+            PUSH(res);
+            if (res == NULL) {
+                goto error;
+            }
+            DISPATCH();
+        }
+
+        TARGET(CALL_METHOD_DESCRIPTOR_O) {
+            assert(cframe.use_tracing == 0);
+            /* Method descriptors with METH_O, called as self.meth(arg) */
+            int original_oparg = GET_CACHE()->adaptive.original_oparg;
+            int is_method = (PEEK(original_oparg + 2) != NULL);
+            DEOPT_IF(original_oparg + is_method != 2, CALL_METHOD);
+            PyObject *arg = TOP();
+            PyObject *self = SECOND();
+            PyObject *callable = THIRD();
+            DEOPT_IF(!Py_IS_TYPE(callable, &PyMethodDescr_Type), CALL_METHOD);
+            PyMethodDescrObject *descr = (PyMethodDescrObject *)callable;
+            PyMethodDef *meth = descr->d_method;
+            DEOPT_IF(meth->ml_flags != METH_O, CALL_METHOD);
+            DEOPT_IF(!PyObject_TypeCheck(self, descr->d_common.d_type), CALL_METHOD);
+            STAT_INC(CALL_METHOD, hit);
+            PyCFunction cfunc = meth->ml_meth;
+            // This is slower but CPython promises to check all non-vectorcall
+            // function calls.
+            if (_Py_EnterRecursiveCall(tstate, " while calling a Python object")) {
+                goto error;
+            }
+            PyObject *res = cfunc(self, arg);
+            _Py_LeaveRecursiveCall(tstate);
+            assert((res != NULL) ^ (_PyErr_Occurred(tstate) != NULL));
+
+            /* Clear the stack of the arguments, the method and its NULL, if any. */
+            Py_DECREF(arg);
+            Py_DECREF(self);
+            Py_DECREF(callable);
+            STACK_SHRINK(original_oparg + 2);
+            PUSH(res);
+            if (res == NULL) {
+                goto error;
+            }
+            DISPATCH();
+        }
+
+        TARGET(CALL_METHOD_DESCRIPTOR_FAST) {
+            assert(cframe.use_tracing == 0);
+            /* Method descriptors with METH_FASTCALL, without keywords */
+            int original_oparg = GET_CACHE()->adaptive.original_oparg;
+            int is_method = (PEEK(original_oparg + 2) != NULL);
+            int total_args = original_oparg + is_method;
+            DEOPT_IF(total_args == 0, CALL_METHOD);
+            PyObject **args = &PEEK(total_args);
+            PyObject *callable = args[-1];
+            DEOPT_IF(!Py_IS_TYPE(callable, &PyMethodDescr_Type), CALL_METHOD);
+            PyMethodDescrObject *descr = (PyMethodDescrObject *)callable;
+            PyMethodDef *meth = descr->d_method;
+            DEOPT_IF(meth->ml_flags != METH_FASTCALL, CALL_METHOD);
+            PyObject *self = args[0];
+            DEOPT_IF(!PyObject_TypeCheck(self, descr->d_common.d_type), CALL_METHOD);
+            STAT_INC(CALL_METHOD, hit);
+            _PyCFunctionFast cfunc = (_PyCFunctionFast)(void(*)(void))meth->ml_meth;
+            PyObject *res = cfunc(self, args + 1, total_args - 1);
+            assert((res != NULL) ^ (_PyErr_Occurred(tstate) != NULL));
+
+            /* Clear the stack of the arguments, the method and its NULL, if any. */
+            for (int i = 0; i < total_args; i++) {
+                Py_DECREF(args[i]);
+            }
+            Py_DECREF(callable);
+            STACK_SHRINK(original_oparg + 2);
+            PUSH(res);
+            if (res == NULL) {
+                goto error;
+            }
+            DISPATCH();
+        }
+
+        TARGET(CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS) {
+            assert(cframe.use_tracing == 0);
+            /* Method descriptors with METH_FASTCALL | METH_KEYWORDS,
+               called without keywords */
+            int original_oparg = GET_CACHE()->adaptive.original_oparg;
+            int is_method = (PEEK(original_oparg + 2) != NULL);
+            int total_args = original_oparg + is_method;
+            DEOPT_IF(total_args == 0, CALL_METHOD);
+            PyObject **args = &PEEK(total_args);
+            PyObject *callable = args[-1];
+            DEOPT_IF(!Py_IS_TYPE(callable, &PyMethodDescr_Type), CALL_METHOD);
+            PyMethodDescrObject *descr = (PyMethodDescrObject *)callable;
+            PyMethodDef *meth = descr->d_method;
+            DEOPT_IF(meth->ml_flags != (METH_FASTCALL | METH_KEYWORDS), CALL_METHOD);
+            PyObject *self = args[0];
+            DEOPT_IF(!PyObject_TypeCheck(self, descr->d_common.d_type), CALL_METHOD);
+            STAT_INC(CALL_METHOD, hit);
+            _PyCFunctionFastWithKeywords cfunc =
+                (_PyCFunctionFastWithKeywords)(void(*)(void))meth->ml_meth;
+            PyObject *res = cfunc(self, args + 1, total_args - 1, NULL);
+            assert((res != NULL) ^ (_PyErr_Occurred(tstate) != NULL));
+
+            /* Clear the stack of the arguments, the method and its NULL, if any. */
+            for (int i = 0; i < total_args; i++) {
+                Py_DECREF(args[i]);
+            }
+            Py_DECREF(callable);
+            STACK_SHRINK(original_oparg + 2);
+            PUSH(res);
+            if (res == NULL) {
+                goto error;
+            }
+            DISPATCH();
+        }
+
+        TARGET(CALL_METHOD_KW_DESCRIPTOR_FAST_WITH_KEYWORDS) {
+            assert(cframe.use_tracing == 0);
+            /* Method descriptors with METH_FASTCALL | METH_KEYWORDS */
+            int original_oparg = GET_CACHE()->adaptive.original_oparg;
+            PyObject *names = TOP();
+            int is_method = (PEEK(original_oparg + 3) != NULL);
+            int total_args = original_oparg + is_method;
+            int positional = total_args - (int)PyTuple_GET_SIZE(names);
+            DEOPT_IF(positional <= 0, CALL_METHOD_KW);
+            PyObject **args = &PEEK(total_args + 1);
+            PyObject *callable = args[-1];
+            DEOPT_IF(!Py_IS_TYPE(callable, &PyMethodDescr_Type), CALL_METHOD_KW);
+            PyMethodDescrObject *descr = (PyMethodDescrObject *)callable;
+            PyMethodDef *meth = descr->d_method;
+            DEOPT_IF(meth->ml_flags != (METH_FASTCALL | METH_KEYWORDS), CALL_METHOD_KW);
+            PyObject *self = args[0];
+            DEOPT_IF(!PyObject_TypeCheck(self, descr->d_common.d_type), CALL_METHOD_KW);
+            STAT_INC(CALL_METHOD_KW, hit);
+            _PyCFunctionFastWithKeywords cfunc =
+                (_PyCFunctionFastWithKeywords)(void(*)(void))meth->ml_meth;
+            PyObject *res = cfunc(self, args + 1, positional - 1, names);
+            assert((res != NULL) ^ (_PyErr_Occurred(tstate) != NULL));
+
+            /* Clear the stack of the names, the arguments,
+               the method and its NULL, if any. */
+            Py_DECREF(names);
+            for (int i = 0; i < total_args; i++) {
+                Py_DECREF(args[i]);
+            }
+            Py_DECREF(callable);
+            STACK_SHRINK(original_oparg + 3);
+            PUSH(res);
+            if (res == NULL) {
+                goto error;
+            }
+            DISPATCH();
+        }
+
         TARGET(CALL_FUNCTION_KW) {
             kwnames = POP();
             nargs = oparg - (int)PyTuple_GET_SIZE(kwnames);
@@ -4923,6 +5931,30 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
             }
             assert(PyTuple_CheckExact(callargs));
 
+            // Check if the call can be inlined or not
+            if (Py_IS_TYPE(func, &PyFunction_Type) && tstate->interp->eval_frame == NULL) {
+                int code_flags = ((PyCodeObject *)PyFunction_GET_CODE(func))->co_flags;
+                int is_generator = code_flags & (CO_GENERATOR | CO_COROUTINE | CO_ASYNC_GENERATOR);
+                if (!is_generator) {
+                    PyObject *locals = code_flags & CO_OPTIMIZED ? NULL : PyFunction_GET_GLOBALS(func);
+                    InterpreterFrame *new_frame = _PyEvalFramePushAndInit_Ex(
+                        tstate, (PyFunctionObject *)func, locals, callargs, kwargs
+                    );
+                    STACK_SHRINK(1);
+                    Py_DECREF(func);
+                    Py_DECREF(callargs);
+                    Py_XDECREF(kwargs);
+                    if (new_frame == NULL) {
+                        goto error;
+                    }
+                    _PyFrame_SetStackPointer(frame, stack_pointer);
+                    new_frame->previous = frame;
+                    new_frame->depth = frame->depth + 1;
+                    cframe.current_frame = frame = new_frame;
+                    goto start_frame;
+                }
+            }
+
             result = do_call_core(tstate, func, callargs, kwargs, cframe.use_tracing);
             Py_DECREF(func);
             Py_DECREF(callargs);
@@ -5166,6 +6198,13 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, InterpreterFrame *frame, int thr
 
 /* Specialization misses */
 
+/* The opcode profile takes a sample when the adaptive counter runs out,
+   before the instruction is deoptimized. */
+#define RECORD_PROFILE_MISS() \
+    if (tstate->interp->ceval.opcode_profile) { \
+        _PyOpcodeProfile_RecordMiss(frame->f_code, next_instr - 1); \
+    }
+
 #define MISS_WITH_CACHE(opname) \
 opname ## _miss: \
     { \
@@ -5173,6 +6212,7 @@ opname ## _miss: \
         _PyAdaptiveEntry *cache = &GET_CACHE()->adaptive; \
         cache->counter--; \
         if (cache->counter == 0) { \
+            RECORD_PROFILE_MISS(); \
             next_instr[-1] = _Py_MAKECODEUNIT(opname ## _ADAPTIVE, _Py_OPARG(next_instr[-1])); \
             STAT_INC(opname, deopt); \
             cache_backoff(cache); \
@@ -5190,6 +6230,7 @@ opname ## _miss: \
         UPDATE_PREV_INSTR_OPARG(next_instr, oparg); \
         assert(_Py_OPARG(next_instr[-1]) == oparg); \
         if (oparg == 0) /* too many cache misses */ { \
+            RECORD_PROFILE_MISS(); \
             oparg = ADAPTIVE_CACHE_BACKOFF; \
             next_instr[-1] = _Py_MAKECODEUNIT(opname ## _ADAPTIVE, oparg); \
             STAT_INC(opname, deopt); \
@@ -5201,11 +6242,17 @@ opname ## _miss: \
 MISS_WITH_CACHE(LOAD_ATTR)
 MISS_WITH_CACHE(STORE_ATTR)
 MISS_WITH_CACHE(LOAD_GLOBAL)
+MISS_WITH_CACHE(STORE_GLOBAL)
 MISS_WITH_CACHE(LOAD_METHOD)
 MISS_WITH_CACHE(CALL_FUNCTION)
+MISS_WITH_CACHE(CALL_METHOD)
+MISS_WITH_CACHE(CALL_METHOD_KW)
+MISS_WITH_CACHE(CONTAINS_OP)
 MISS_WITH_CACHE(BINARY_OP)
 MISS_WITH_CACHE(COMPARE_OP)
 MISS_WITH_CACHE(BINARY_SUBSCR)
+MISS_WITH_CACHE(FOR_ITER)
+MISS_WITH_CACHE(UNPACK_SEQUENCE)
 MISS_WITH_OPARG_COUNTER(STORE_SUBSCR)
 
 binary_subscr_dict_error:
@@ -5950,6 +6997,43 @@ _PyEvalFramePushAndInit(PyThreadState *tstate, PyFunctionObject *func,
     return NULL;
 }
 
+/* Same as _PyEvalFramePushAndInit, but takes the arguments as
+ * a tuple and an optional dict, as CALL_FUNCTION_EX has them.
+ * Unlike _PyEvalFramePushAndInit, does not consume any references. */
+static InterpreterFrame *
+_PyEvalFramePushAndInit_Ex(PyThreadState *tstate, PyFunctionObject *func,
+                           PyObject *locals, PyObject *callargs,
+                           PyObject *kwargs)
+{
+    assert(PyTuple_CheckExact(callargs));
+    assert(kwargs == NULL || PyDict_CheckExact(kwargs));
+    Py_ssize_t nargs = PyTuple_GET_SIZE(callargs);
+    PyObject *kwnames = NULL;
+    PyObject *const *newargs;
+    int has_dict = (kwargs != NULL && PyDict_GET_SIZE(kwargs) > 0);
+    if (has_dict) {
+        /* _PyStack_UnpackDict returns new references */
+        newargs = _PyStack_UnpackDict(tstate, _PyTuple_ITEMS(callargs),
+                                      nargs, kwargs, &kwnames);
+        if (newargs == NULL) {
+            return NULL;
+        }
+    }
+    else {
+        newargs = _PyTuple_ITEMS(callargs);
+        for (Py_ssize_t i = 0; i < nargs; i++) {
+            Py_INCREF(newargs[i]);
+        }
+    }
+    InterpreterFrame *new_frame = _PyEvalFramePushAndInit(
+        tstate, func, locals, newargs, nargs, kwnames);
+    if (has_dict) {
+        /* The frame has stolen the references held by the vector */
+        _PyStack_UnpackDict_FreeNoDecRef(newargs, kwnames);
+    }
+    return new_frame;
+}
+
 static void
 _PyEvalFrameClearAndPop(PyThreadState *tstate, InterpreterFrame * frame)
 {
@@ -47,6 +47,26 @@
      run and end up being the first to re-acquire it, making the "timeslices"
      much longer than expected.
      (Note: this mechanism is enabled with FORCE_SWITCHING above)
+
+   - Under the priority policy (see `sys._setgilpolicy()`), each waiting
+     thread queues a waiter with its own condition variable, in order of
+     priority (`sys._setgilpriority()`), then of whether it is taking the
+     GIL back after a blocking call, then of arrival.  A thread releasing
+     the GIL hands it over directly to the first waiter, which avoids
+     waking up every waiting thread only for one of them to win.
+
+     A waiter which outranks the GIL-holding thread sets gil_drop_request
+     right away instead of waiting for `interval` microseconds first.  This
+     mitigates the convoy effect, where a thread which released the GIL for
+     a short blocking call (like a recv()) waits a whole interval behind a
+     CPU-bound thread every time it needs to take the GIL back.
+
+   - The time that each acquisition waited for the GIL is counted in a
+     histogram, see `sys._getgilwaithistogram()`.  Each thread state also
+     counts how it waited for and held the GIL (gil_stats), see
+     `sys._getgilstats()`.  This costs a read of the monotonic clock when
+     the GIL is taken and one when it is released, and another one when
+     the thread has to wait.
 */
 
 #include "condvar.h"
@@ -95,6 +115,7 @@ static void _gil_initialize(struct _gil_runtime_state *gil)
     _Py_atomic_int uninitialized = {-1};
     gil->locked = uninitialized;
     gil->interval = DEFAULT_INTERVAL;
+    gil->policy = _Py_GIL_POLICY_DEFAULT;
 }
 
 static int gil_created(struct _gil_runtime_state *gil)
@@ -113,6 +134,10 @@ static void create_gil(struct _gil_runtime_state *gil)
     COND_INIT(gil->switch_cond);
 #endif
     _Py_atomic_store_relaxed(&gil->last_holder, 0);
+    gil->holder_priority = 0;
+    gil->holder_after_io = 0;
+    /* After a fork, the threads which were waiting are gone. */
+    gil->waiters = NULL;
     _Py_ANNOTATE_RWLOCK_CREATE(&gil->locked);
     _Py_atomic_store_explicit(&gil->locked, 0, _Py_memory_order_release);
 }
@@ -140,6 +165,19 @@ static void recreate_gil(struct _gil_runtime_state *gil)
     create_gil(gil);
 }
 
+/* Return the index of the bucket of the GIL histograms for a duration. */
+static inline int
+gil_histogram_bucket(_PyTime_t duration)
+{
+    _PyTime_t us = _PyTime_AsMicroseconds(duration, _PyTime_ROUND_FLOOR);
+    int bucket = 0;
+    while (us > 0 && bucket < _Py_GIL_HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
 static void
 drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
          PyThreadState *tstate)
@@ -159,16 +197,42 @@ drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
            under our feet using PyThreadState_Swap(). Fix the GIL last
            holder variable so that our heuristics work. */
         _Py_atomic_store_relaxed(&gil->last_holder, (uintptr_t)tstate);
+
+        _PyGILThreadStats *stats = &tstate->gil_stats;
+        int forced = _Py_atomic_load_relaxed(&ceval2->gil_drop_request);
+        if (forced) {
+            stats->forced_drops++;
+        }
+        if (stats->hold_start != 0) {
+            _PyTime_t hold = _PyTime_GetMonotonicClock() - stats->hold_start;
+            stats->hold_histogram[gil_histogram_bucket(hold)]++;
+            stats->hold_start = 0;
+            if (PyDTrace_GIL_RELEASE_ENABLED()) {
+                PyDTrace_GIL_RELEASE(hold, forced);
+            }
+        }
     }
 
     MUTEX_LOCK(gil->mutex);
     _Py_ANNOTATE_RWLOCK_RELEASED(&gil->locked, /*is_write=*/1);
-    _Py_atomic_store_relaxed(&gil->locked, 0);
-    COND_SIGNAL(gil->cond);
+    struct _gil_waiter *waiter = gil->waiters;
+    if (waiter != NULL) {
+        /* Hand the GIL over to the first waiter: it stays locked. */
+        gil->waiters = waiter->next;
+        waiter->granted = 1;
+        COND_SIGNAL(waiter->cond);
+    }
+    else {
+        _Py_atomic_store_relaxed(&gil->locked, 0);
+        COND_SIGNAL(gil->cond);
+    }
     MUTEX_UNLOCK(gil->mutex);
 
 #ifdef FORCE_SWITCHING
-    if (_Py_atomic_load_relaxed(&ceval2->gil_drop_request) && tstate != NULL) {
+    /* After a handoff, we can't take the GIL again before the waiter. */
+    if (waiter == NULL && tstate != NULL &&
+        _Py_atomic_load_relaxed(&ceval2->gil_drop_request))
+    {
         MUTEX_LOCK(gil->switch_mutex);
         /* Not switched yet => wait */
         if (((PyThreadState*)_Py_atomic_load_relaxed(&gil->last_holder)) == tstate)
@@ -206,13 +270,84 @@ tstate_must_exit(PyThreadState *tstate)
 }
 
 
+/* Return non-zero if a thread of the first rank must take the GIL before
+   a thread of the second one, under the priority policy. */
+static inline int
+gil_outranks(int priority, int after_io, int other_priority, int other_after_io)
+{
+    return (priority > other_priority
+            || (priority == other_priority && after_io > other_after_io));
+}
+
+/* Wait for the GIL to be handed over under the priority policy.
+
+   The GIL must be locked, and gil->mutex held. */
+static void
+wait_for_gil_handoff(PyThreadState *tstate, struct _gil_runtime_state *gil,
+                     int after_io)
+{
+    struct _gil_waiter waiter;
+    waiter.priority = tstate->gil_priority;
+    waiter.after_io = after_io;
+    waiter.granted = 0;
+    COND_INIT(waiter.cond);
+
+    struct _gil_waiter **link = &gil->waiters;
+    while (*link != NULL &&
+           !gil_outranks(waiter.priority, waiter.after_io,
+                         (*link)->priority, (*link)->after_io))
+    {
+        link = &(*link)->next;
+    }
+    waiter.next = *link;
+    *link = &waiter;
+
+    if (gil_outranks(waiter.priority, waiter.after_io,
+                     gil->holder_priority, gil->holder_after_io))
+    {
+        SET_GIL_DROP_REQUEST(tstate->interp);
+    }
+
+    while (!waiter.granted) {
+        unsigned long saved_switchnum = gil->switch_number;
+
+        unsigned long interval = (gil->interval >= 1 ? gil->interval : 1);
+        int timed_out = 0;
+        COND_TIMED_WAIT(waiter.cond, gil->mutex, interval, timed_out);
+
+        if (timed_out && !waiter.granted &&
+            gil->switch_number == saved_switchnum)
+        {
+            if (tstate_must_exit(tstate)) {
+                for (link = &gil->waiters; *link != &waiter;
+                     link = &(*link)->next)
+                {
+                }
+                *link = waiter.next;
+                COND_FINI(waiter.cond);
+                MUTEX_UNLOCK(gil->mutex);
+                PyThread_exit_thread();
+            }
+            assert(is_tstate_valid(tstate));
+
+            SET_GIL_DROP_REQUEST(tstate->interp);
+        }
+    }
+
+    COND_FINI(waiter.cond);
+}
+
 /* Take the GIL.
 
+   after_io is non-zero if the thread released the GIL for a blocking call
+   (see PyEval_RestoreThread()), which gives it precedence under the
+   priority policy.
+
    The function saves errno at entry and restores its value at exit.
 
    tstate must be non-NULL. */
 static void
-take_gil(PyThreadState *tstate)
+take_gil(PyThreadState *tstate, int after_io)
 {
     int err = errno;
 
@@ -243,9 +378,16 @@ take_gil(PyThreadState *tstate)
 
     MUTEX_LOCK(gil->mutex);
 
+    _PyTime_t wait_start = 0;
     if (!_Py_atomic_load_relaxed(&gil->locked)) {
         goto _ready;
     }
+    wait_start = _PyTime_GetMonotonicClock();
+
+    if (gil->policy == _Py_GIL_POLICY_PRIORITY) {
+        wait_for_gil_handoff(tstate, gil, after_io);
+        goto _ready;
+    }
 
     while (_Py_atomic_load_relaxed(&gil->locked)) {
         unsigned long saved_switchnum = gil->switch_number;
@@ -284,6 +426,9 @@ take_gil(PyThreadState *tstate)
         _Py_atomic_store_relaxed(&gil->last_holder, (uintptr_t)tstate);
         ++gil->switch_number;
     }
+    _PyTime_t now = _PyTime_GetMonotonicClock();
+    _PyTime_t wait = (wait_start != 0 ? now - wait_start : 0);
+    gil->wait_histogram[gil_histogram_bucket(wait)]++;
 
 #ifdef FORCE_SWITCHING
     COND_SIGNAL(gil->switch_cond);
@@ -299,11 +444,26 @@ take_gil(PyThreadState *tstate)
            in take_gil() while the main thread called
            wait_for_thread_shutdown() from Py_Finalize(). */
         MUTEX_UNLOCK(gil->mutex);
-        drop_gil(ceval, ceval2, tstate);
+        /* tstate can be a dangling pointer: don't let drop_gil() use it. */
+        drop_gil(ceval, ceval2, NULL);
         PyThread_exit_thread();
     }
     assert(is_tstate_valid(tstate));
 
+    gil->holder_priority = tstate->gil_priority;
+    gil->holder_after_io = after_io;
+
+    _PyGILThreadStats *stats = &tstate->gil_stats;
+    stats->acquisitions++;
+    stats->wait_total += wait;
+    if (wait > stats->wait_max) {
+        stats->wait_max = wait;
+    }
+    stats->hold_start = now;
+    if (PyDTrace_GIL_ACQUIRE_ENABLED()) {
+        PyDTrace_GIL_ACQUIRE(wait);
+    }
+
     if (_Py_atomic_load_relaxed(&ceval2->gil_drop_request)) {
         RESET_GIL_DROP_REQUEST(interp);
     }
@@ -347,3 +507,35 @@ unsigned long _PyEval_GetSwitchInterval()
 #endif
     return gil->interval;
 }
+
+static struct _gil_runtime_state *
+current_gil(void)
+{
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    PyInterpreterState *interp = PyInterpreterState_Get();
+    return &interp->ceval.gil;
+#else
+    return &_PyRuntime.ceval.gil;
+#endif
+}
+
+void _PyEval_SetGILPolicy(int policy)
+{
+    struct _gil_runtime_state *gil = current_gil();
+    MUTEX_LOCK(gil->mutex);
+    gil->policy = policy;
+    MUTEX_UNLOCK(gil->mutex);
+}
+
+int _PyEval_GetGILPolicy(void)
+{
+    return current_gil()->policy;
+}
+
+void _PyEval_GetGILWaitHistogram(uint64_t *buckets)
+{
+    struct _gil_runtime_state *gil = current_gil();
+    MUTEX_LOCK(gil->mutex);
+    memcpy(buckets, gil->wait_histogram, sizeof(gil->wait_histogram));
+    MUTEX_UNLOCK(gil->mutex);
+}
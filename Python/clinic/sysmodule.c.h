@@ -350,6 +350,184 @@ sys_getswitchinterval(PyObject *module, PyObject *Py_UNUSED(ignored))
     return return_value;
 }
 
+PyDoc_STRVAR(sys__setgilpolicy__doc__,
+"_setgilpolicy($module, policy, /)\n"
+"--\n"
+"\n"
+"Set the policy which decides which waiting thread takes the GIL next.\n"
+"\n"
+"With the \'default\' policy, threads compete for the GIL when it is\n"
+"released.  With the \'priority\' policy, the GIL is handed over to the\n"
+"waiting thread of the highest priority (see sys._setgilpriority()),\n"
+"favoring the threads returning from a blocking call, like I/O, among\n"
+"those of the same priority.  Such a thread asks the thread holding the\n"
+"GIL to release it without waiting for the switch interval if it ranks\n"
+"higher.");
+
+#define SYS__SETGILPOLICY_METHODDEF    \
+    {"_setgilpolicy", (PyCFunction)sys__setgilpolicy, METH_O, sys__setgilpolicy__doc__},
+
+static PyObject *
+sys__setgilpolicy_impl(PyObject *module, const char *policy);
+
+static PyObject *
+sys__setgilpolicy(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    const char *policy;
+
+    if (!PyUnicode_Check(arg)) {
+        _PyArg_BadArgument("_setgilpolicy", "argument", "str", arg);
+        goto exit;
+    }
+    Py_ssize_t policy_length;
+    policy = PyUnicode_AsUTF8AndSize(arg, &policy_length);
+    if (policy == NULL) {
+        goto exit;
+    }
+    if (strlen(policy) != (size_t)policy_length) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        goto exit;
+    }
+    return_value = sys__setgilpolicy_impl(module, policy);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__getgilpolicy__doc__,
+"_getgilpolicy($module, /)\n"
+"--\n"
+"\n"
+"Return the name of the current GIL policy; see sys._setgilpolicy().");
+
+#define SYS__GETGILPOLICY_METHODDEF    \
+    {"_getgilpolicy", (PyCFunction)sys__getgilpolicy, METH_NOARGS, sys__getgilpolicy__doc__},
+
+static PyObject *
+sys__getgilpolicy_impl(PyObject *module);
+
+static PyObject *
+sys__getgilpolicy(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__getgilpolicy_impl(module);
+}
+
+PyDoc_STRVAR(sys__setgilpriority__doc__,
+"_setgilpriority($module, priority, /)\n"
+"--\n"
+"\n"
+"Set the priority of the current thread under the \'priority\' GIL policy.\n"
+"\n"
+"Threads of a higher priority take the GIL first.  The default priority\n"
+"is 0.  The new priority applies from the next time the thread waits for\n"
+"the GIL.");
+
+#define SYS__SETGILPRIORITY_METHODDEF    \
+    {"_setgilpriority", (PyCFunction)sys__setgilpriority, METH_O, sys__setgilpriority__doc__},
+
+static PyObject *
+sys__setgilpriority_impl(PyObject *module, int priority);
+
+static PyObject *
+sys__setgilpriority(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int priority;
+
+    priority = _PyLong_AsInt(arg);
+    if (priority == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = sys__setgilpriority_impl(module, priority);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__getgilpriority__doc__,
+"_getgilpriority($module, /)\n"
+"--\n"
+"\n"
+"Return the priority of the current thread; see sys._setgilpriority().");
+
+#define SYS__GETGILPRIORITY_METHODDEF    \
+    {"_getgilpriority", (PyCFunction)sys__getgilpriority, METH_NOARGS, sys__getgilpriority__doc__},
+
+static int
+sys__getgilpriority_impl(PyObject *module);
+
+static PyObject *
+sys__getgilpriority(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = sys__getgilpriority_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__getgilstats__doc__,
+"_getgilstats($module, /)\n"
+"--\n"
+"\n"
+"Return a dictionary of how each thread of this interpreter used the GIL.\n"
+"\n"
+"It maps the identifier of each thread to a dictionary of counters:\n"
+"\n"
+"acquisitions\n"
+"    The number of times the thread took the GIL.\n"
+"wait_total, wait_max\n"
+"    The total and longest time in seconds that it waited to take it.\n"
+"forced_drops\n"
+"    The number of times it released the GIL while another thread was\n"
+"    requesting it, usually because it held it for longer than the\n"
+"    switch interval.\n"
+"hold_histogram\n"
+"    How long it held the GIL each time, in the same buckets as\n"
+"    sys._getgilwaithistogram().");
+
+#define SYS__GETGILSTATS_METHODDEF    \
+    {"_getgilstats", (PyCFunction)sys__getgilstats, METH_NOARGS, sys__getgilstats__doc__},
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module);
+
+static PyObject *
+sys__getgilstats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__getgilstats_impl(module);
+}
+
+PyDoc_STRVAR(sys__getgilwaithistogram__doc__,
+"_getgilwaithistogram($module, /)\n"
+"--\n"
+"\n"
+"Return a histogram of how long the threads waited to take the GIL.\n"
+"\n"
+"This is a tuple of counts of acquisitions.  The first item counts those\n"
+"which waited less than a microsecond, including all the acquisitions of\n"
+"a GIL which was free.  Item i counts those which waited from 2**(i-1) to\n"
+"2**i microseconds, and the last item all those which waited longer.");
+
+#define SYS__GETGILWAITHISTOGRAM_METHODDEF    \
+    {"_getgilwaithistogram", (PyCFunction)sys__getgilwaithistogram, METH_NOARGS, sys__getgilwaithistogram__doc__},
+
+static PyObject *
+sys__getgilwaithistogram_impl(PyObject *module);
+
+static PyObject *
+sys__getgilwaithistogram(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__getgilwaithistogram_impl(module);
+}
+
 PyDoc_STRVAR(sys_setrecursionlimit__doc__,
 "setrecursionlimit($module, limit, /)\n"
 "--\n"
@@ -992,4 +1170,4 @@ sys_getandroidapilevel(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=855fc93b2347710b input=a9049054013a1b77]*/
+/*[clinic end generated code: output=de009c0ddc8ddc7b input=a9049054013a1b77]*/
@@ -441,6 +441,14 @@ _PyImport_FixupExtensionObject(PyObject *mod, PyObject *name,
         return -1;
     }
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    /* An isolated interpreter runs in parallel with the main interpreter:
+       it must not replace the copy that the main interpreter reads. */
+    if (tstate->interp->config._isolated_interpreter) {
+        return 0;
+    }
+#endif
+
     // bpo-44050: Extensions and def->m_base.m_copy can be updated
     // when the extension module doesn't support sub-interpreters.
     if (_Py_IsMainInterpreter(tstate->interp) || def->m_size == -1) {
@@ -1318,7 +1326,16 @@ find_frozen(PyObject *nameobj, struct frozen_info *info)
 static PyObject *
 unmarshal_frozen_code(struct frozen_info *info)
 {
-    if (info->get_code) {
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    /* The deep-frozen code objects are static and shared by all the
+       interpreters, but running code writes to its code object: an isolated
+       interpreter, which runs in parallel with the others, unmarshals its
+       own copy. */
+    int use_static = !_PyInterpreterState_GET()->config._isolated_interpreter;
+#else
+    int use_static = 1;
+#endif
+    if (info->get_code && use_static) {
         PyObject *code = info->get_code();
         assert(code != NULL);
         return code;
@@ -99,6 +99,13 @@ static const char usage_3[] = "\
             when the interpreter displays tracebacks.\n\
          -X frozen_modules=[on|off]: whether or not frozen modules should be used.\n\
             The default is \"on\" (or \"off\" if you are running a local build).\n\
+         -X freelists=float:N,tuple:N,list:N,dict:N,adaptive: set the number of\n\
+            objects kept on the free lists of these types. \"adaptive\" lets the\n\
+            free lists grow when objects are allocated and freed in large bursts.\n\
+            Also PYTHONFREELISTS\n\
+         -X malloc_arenas=hugepage,hugetlb,retain=N: map the arenas of pymalloc\n\
+            from huge pages, and keep up to N free arenas mapped for reuse.\n\
+            Also PYTHONMALLOCARENAS\n\
 \n\
 --check-hash-based-pycs always|default|never:\n\
     control how Python invalidates hash-based .pyc files\n\
@@ -128,6 +135,10 @@ static const char usage_6[] =
 "PYTHONMALLOC: set the Python memory allocators and/or install debug hooks\n"
 "   on Python memory allocators. Use PYTHONMALLOC=debug to install debug\n"
 "   hooks.\n"
+"PYTHONFREELISTS: set the capacity of the free lists of builtin types,\n"
+"   as -X freelists.\n"
+"PYTHONMALLOCARENAS: set how the pymalloc arenas are mapped and given back,\n"
+"   as -X malloc_arenas.\n"
 "PYTHONCOERCECLOCALE: if this variable is set to 0, it disables the locale\n"
 "   coercion behavior. Use PYTHONCOERCECLOCALE=warn to request display of\n"
 "   locale coercion and locale compatibility warnings on stderr.\n"
@@ -613,6 +624,14 @@ config_check_consistency(const PyConfig *config)
     assert(config->show_ref_count >= 0);
     assert(config->dump_refs >= 0);
     assert(config->malloc_stats >= 0);
+    assert(config->float_freelist_size >= -1);
+    assert(config->tuple_freelist_size >= -1);
+    assert(config->list_freelist_size >= -1);
+    assert(config->dict_freelist_size >= -1);
+    assert(config->adaptive_freelists >= 0);
+    assert(0 <= config->malloc_arenas_huge_pages
+           && config->malloc_arenas_huge_pages <= 2);
+    assert(config->malloc_arenas_retained >= 0);
     assert(config->site_import >= 0);
     assert(config->bytes_warning >= 0);
     assert(config->warn_default_encoding >= 0);
@@ -709,6 +728,13 @@ _PyConfig_InitCompatConfig(PyConfig *config)
     config->use_hash_seed = -1;
     config->faulthandler = -1;
     config->tracemalloc = -1;
+    config->float_freelist_size = -1;
+    config->tuple_freelist_size = -1;
+    config->list_freelist_size = -1;
+    config->dict_freelist_size = -1;
+    config->adaptive_freelists = -1;
+    config->malloc_arenas_huge_pages = -1;
+    config->malloc_arenas_retained = -1;
     config->module_search_paths_set = 0;
     config->parse_argv = 0;
     config->site_import = -1;
@@ -904,6 +930,13 @@ _PyConfig_Copy(PyConfig *config, const PyConfig *config2)
     COPY_ATTR(dump_refs);
     COPY_ATTR(dump_refs_file);
     COPY_ATTR(malloc_stats);
+    COPY_ATTR(float_freelist_size);
+    COPY_ATTR(tuple_freelist_size);
+    COPY_ATTR(list_freelist_size);
+    COPY_ATTR(dict_freelist_size);
+    COPY_ATTR(adaptive_freelists);
+    COPY_ATTR(malloc_arenas_huge_pages);
+    COPY_ATTR(malloc_arenas_retained);
 
     COPY_WSTR_ATTR(pycache_prefix);
     COPY_WSTR_ATTR(pythonpath_env);
@@ -1012,6 +1045,13 @@ _PyConfig_AsDict(const PyConfig *config)
     SET_ITEM_INT(show_ref_count);
     SET_ITEM_INT(dump_refs);
     SET_ITEM_INT(malloc_stats);
+    SET_ITEM_INT(float_freelist_size);
+    SET_ITEM_INT(tuple_freelist_size);
+    SET_ITEM_INT(list_freelist_size);
+    SET_ITEM_INT(dict_freelist_size);
+    SET_ITEM_INT(adaptive_freelists);
+    SET_ITEM_INT(malloc_arenas_huge_pages);
+    SET_ITEM_INT(malloc_arenas_retained);
     SET_ITEM_WSTR(filesystem_encoding);
     SET_ITEM_WSTR(filesystem_errors);
     SET_ITEM_WSTR(pycache_prefix);
@@ -1251,6 +1291,13 @@ _PyConfig_FromDict(PyConfig *config, PyObject *dict)
         } \
         CHECK_VALUE(#KEY, config->KEY >= 0); \
     } while (0)
+#define GET_FREELIST_SIZE(KEY) \
+    do { \
+        if (config_dict_get_int(dict, #KEY, &config->KEY) < 0) { \
+            return -1; \
+        } \
+        CHECK_VALUE(#KEY, config->KEY >= -1); \
+    } while (0)
 #define GET_WSTR(KEY) \
     do { \
         if (config_dict_get_wstr(dict, #KEY, config, &config->KEY) < 0) { \
@@ -1292,6 +1339,15 @@ _PyConfig_FromDict(PyConfig *config, PyObject *dict)
     GET_UINT(show_ref_count);
     GET_UINT(dump_refs);
     GET_UINT(malloc_stats);
+    GET_FREELIST_SIZE(float_freelist_size);
+    GET_FREELIST_SIZE(tuple_freelist_size);
+    GET_FREELIST_SIZE(list_freelist_size);
+    GET_FREELIST_SIZE(dict_freelist_size);
+    GET_UINT(adaptive_freelists);
+    GET_UINT(malloc_arenas_huge_pages);
+    CHECK_VALUE("malloc_arenas_huge_pages",
+                config->malloc_arenas_huge_pages <= 2);
+    GET_UINT(malloc_arenas_retained);
     GET_WSTR(filesystem_encoding);
     GET_WSTR(filesystem_errors);
     GET_WSTR_OPT(pycache_prefix);
@@ -1350,6 +1406,7 @@ _PyConfig_FromDict(PyConfig *config, PyObject *dict)
 
 #undef CHECK_VALUE
 #undef GET_UINT
+#undef GET_FREELIST_SIZE
 #undef GET_WSTR
 #undef GET_WSTR_OPT
     return 0;
@@ -1676,6 +1733,170 @@ config_init_tracemalloc(PyConfig *config)
 }
 
 
+/* Parse a comma-separated list of "type:capacity" items and of "adaptive".
+   Options already set in the configuration are left unchanged. */
+static PyStatus
+config_parse_freelists(PyConfig *config, const wchar_t *spec,
+                       const char *err_msg)
+{
+    static const wchar_t *names[] = {L"float", L"tuple", L"list", L"dict"};
+    int *sizes[] = {
+        &config->float_freelist_size,
+        &config->tuple_freelist_size,
+        &config->list_freelist_size,
+        &config->dict_freelist_size,
+    };
+
+    while (*spec != L'\0') {
+        const wchar_t *end = wcschr(spec, L',');
+        size_t len = end ? (size_t)(end - spec) : wcslen(spec);
+        if (len == 8 && wcsncmp(spec, L"adaptive", len) == 0) {
+            if (config->adaptive_freelists < 0) {
+                config->adaptive_freelists = 1;
+            }
+        }
+        else {
+            const wchar_t *sep = wcschr(spec, L':');
+            if (sep == NULL || sep >= spec + len) {
+                return _PyStatus_ERR(err_msg);
+            }
+            size_t name_len = sep - spec;
+            size_t i;
+            for (i = 0; i < Py_ARRAY_LENGTH(names); i++) {
+                if (wcsncmp(spec, names[i], name_len) == 0
+                    && names[i][name_len] == L'\0')
+                {
+                    break;
+                }
+            }
+            wchar_t value[16];
+            size_t value_len = len - name_len - 1;
+            if (i == Py_ARRAY_LENGTH(names)
+                || value_len == 0 || value_len >= Py_ARRAY_LENGTH(value))
+            {
+                return _PyStatus_ERR(err_msg);
+            }
+            wcsncpy(value, sep + 1, value_len);
+            value[value_len] = L'\0';
+            int size;
+            if (config_wstr_to_int(value, &size) < 0 || size < 0) {
+                return _PyStatus_ERR(err_msg);
+            }
+            if (*sizes[i] < 0) {
+                *sizes[i] = size;
+            }
+        }
+        spec += len;
+        if (*spec == L',') {
+            spec++;
+        }
+    }
+    return _PyStatus_OK();
+}
+
+
+static PyStatus
+config_init_freelists(PyConfig *config)
+{
+    const wchar_t *xoption = config_get_xoption(config, L"freelists");
+    if (xoption) {
+        const wchar_t *sep = wcschr(xoption, L'=');
+        return config_parse_freelists(config, sep ? sep + 1 : L"",
+                                      "-X freelists: invalid free list "
+                                      "specification");
+    }
+
+    wchar_t *env = NULL;
+    PyStatus status = CONFIG_GET_ENV_DUP(config, &env,
+                                         L"PYTHONFREELISTS",
+                                         "PYTHONFREELISTS");
+    if (_PyStatus_EXCEPTION(status) || env == NULL) {
+        return status;
+    }
+    status = config_parse_freelists(config, env,
+                                    "PYTHONFREELISTS: invalid free list "
+                                    "specification");
+    PyMem_RawFree(env);
+    return status;
+}
+
+
+/* Parse a comma-separated list of "hugepage", "hugetlb" and "retain=N".
+   Options already set in the configuration are left unchanged. */
+static PyStatus
+config_parse_malloc_arenas(PyConfig *config, const wchar_t *spec,
+                           const char *err_msg)
+{
+    int huge_pages = -1;
+    int retained = -1;
+
+    while (*spec != L'\0') {
+        const wchar_t *end = wcschr(spec, L',');
+        size_t len = end ? (size_t)(end - spec) : wcslen(spec);
+        if (len == 8 && wcsncmp(spec, L"hugepage", len) == 0) {
+            /* "hugetlb" takes precedence */
+            huge_pages = Py_MAX(huge_pages, 1);
+        }
+        else if (len == 7 && wcsncmp(spec, L"hugetlb", len) == 0) {
+            huge_pages = 2;
+        }
+        else if (len > 7 && wcsncmp(spec, L"retain=", 7) == 0) {
+            wchar_t value[16];
+            size_t value_len = len - 7;
+            if (value_len >= Py_ARRAY_LENGTH(value)) {
+                return _PyStatus_ERR(err_msg);
+            }
+            wcsncpy(value, spec + 7, value_len);
+            value[value_len] = L'\0';
+            if (config_wstr_to_int(value, &retained) < 0 || retained < 0) {
+                return _PyStatus_ERR(err_msg);
+            }
+        }
+        else {
+            return _PyStatus_ERR(err_msg);
+        }
+        spec += len;
+        if (*spec == L',') {
+            spec++;
+        }
+    }
+
+    if (config->malloc_arenas_huge_pages < 0 && huge_pages >= 0) {
+        config->malloc_arenas_huge_pages = huge_pages;
+    }
+    if (config->malloc_arenas_retained < 0 && retained >= 0) {
+        config->malloc_arenas_retained = retained;
+    }
+    return _PyStatus_OK();
+}
+
+
+static PyStatus
+config_init_malloc_arenas(PyConfig *config)
+{
+    const wchar_t *xoption = config_get_xoption(config, L"malloc_arenas");
+    if (xoption) {
+        const wchar_t *sep = wcschr(xoption, L'=');
+        return config_parse_malloc_arenas(config, sep ? sep + 1 : L"",
+                                          "-X malloc_arenas: invalid arena "
+                                          "option");
+    }
+
+    wchar_t *env = NULL;
+    PyStatus status = CONFIG_GET_ENV_DUP(config, &env,
+                                         L"PYTHONMALLOCARENAS",
+                                         "PYTHONMALLOCARENAS");
+    if (_PyStatus_EXCEPTION(status) || env == NULL) {
+        return status;
+    }
+    status = config_parse_malloc_arenas(config, env,
+                                        "PYTHONMALLOCARENAS: invalid arena "
+                                        "option");
+    PyMem_RawFree(env);
+    return status;
+}
+
+
 static PyStatus
 config_init_pycache_prefix(PyConfig *config)
 {
@@ -1738,6 +1959,16 @@ config_read_complex_options(PyConfig *config)
             return status;
         }
     }
+
+    status = config_init_freelists(config);
+    if (_PyStatus_EXCEPTION(status)) {
+        return status;
+    }
+
+    status = config_init_malloc_arenas(config);
+    if (_PyStatus_EXCEPTION(status)) {
+        return status;
+    }
     return _PyStatus_OK();
 }
 
@@ -2015,6 +2246,8 @@ const wchar_t* known_xoptions[] = {
     L"warn_default_encoding",
     L"no_debug_ranges",
     L"frozen_modules",
+    L"freelists",
+    L"malloc_arenas",
     NULL,
 };
 
@@ -2091,6 +2324,15 @@ config_read(PyConfig *config, int compute_path_config)
     if (config->tracemalloc < 0) {
         config->tracemalloc = 0;
     }
+    if (config->adaptive_freelists < 0) {
+        config->adaptive_freelists = 0;
+    }
+    if (config->malloc_arenas_huge_pages < 0) {
+        config->malloc_arenas_huge_pages = 0;
+    }
+    if (config->malloc_arenas_retained < 0) {
+        config->malloc_arenas_retained = 0;
+    }
     if (config->use_hash_seed < 0) {
         config->use_hash_seed = 0;
         config->hash_seed = 0;
@@ -2177,7 +2419,8 @@ config_init_stdio(const PyConfig *config)
 /* Write the configuration:
 
    - set Py_xxx global configuration variables
-   - initialize C standard streams (stdin, stdout, stderr) */
+   - initialize C standard streams (stdin, stdout, stderr)
+   - set the options of the pymalloc arenas */
 PyStatus
 _PyConfig_Write(const PyConfig *config, _PyRuntimeState *runtime)
 {
@@ -2193,6 +2436,9 @@ _PyConfig_Write(const PyConfig *config, _PyRuntimeState *runtime)
     preconfig->use_environment = config->use_environment;
     preconfig->dev_mode = config->dev_mode;
 
+    _PyObject_SetArenaOptions(config->malloc_arenas_huge_pages,
+                              config->malloc_arenas_retained);
+
     if (_Py_SetArgcArgv(config->orig_argv.length,
                         config->orig_argv.items) < 0)
     {
@@ -5,6 +5,7 @@
 #include "pycore_ceval.h"         // _PyEval_FiniGIL()
 #include "pycore_context.h"       // _PyContext_Init()
 #include "pycore_fileutils.h"     // _Py_ResetForceASCII()
+#include "pycore_gc.h"            // _PyGC_ShareObject()
 #include "pycore_import.h"        // _PyImport_BootstrapImp()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
 #include "pycore_object.h"        // _PyDebug_PrintTotalRefs()
@@ -658,6 +659,26 @@ pycore_create_interpreter(_PyRuntimeState *runtime,
 }
 
 
+static PyStatus
+pycore_init_freelists(PyInterpreterState *interp)
+{
+    const PyConfig *config = _PyInterpreterState_GetConfig(interp);
+    int adaptive = config->adaptive_freelists;
+
+    _PyFloat_InitFreeList(interp, config->float_freelist_size, adaptive);
+    _PyTuple_InitFreeList(interp, config->tuple_freelist_size, adaptive);
+    if (_PyList_InitFreeList(interp, config->list_freelist_size,
+                             adaptive) < 0) {
+        return _PyStatus_NO_MEMORY();
+    }
+    if (_PyDict_InitFreeList(interp, config->dict_freelist_size,
+                             adaptive) < 0) {
+        return _PyStatus_NO_MEMORY();
+    }
+    return _PyStatus_OK();
+}
+
+
 static PyStatus
 pycore_init_singletons(PyInterpreterState *interp)
 {
@@ -669,6 +690,11 @@ pycore_init_singletons(PyInterpreterState *interp)
         _PyFloat_Init();
     }
 
+    status = pycore_init_freelists(interp);
+    if (_PyStatus_EXCEPTION(status)) {
+        return status;
+    }
+
     status = _PyBytes_Init(interp);
     if (_PyStatus_EXCEPTION(status)) {
         return status;
@@ -1057,6 +1083,32 @@ pyinit_main_reconfigure(PyThreadState *tstate)
 }
 
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+/* Isolated subinterpreters run in parallel with the main interpreter but
+   share its singletons, small integers and static types: make them
+   immortal, so that their reference counts are never written. */
+static PyStatus
+init_shared_objects(_PyRuntimeState *runtime)
+{
+    PyObject *singletons[] = {
+        Py_None, Py_True, Py_False, Py_Ellipsis, Py_NotImplemented,
+    };
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(singletons); i++) {
+        if (_PyGC_ShareObject(singletons[i]) < 0) {
+            return _PyStatus_NO_MEMORY();
+        }
+    }
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(runtime->small_ints); i++) {
+        _Py_SetImmortal((PyObject *)&runtime->small_ints[i]);
+    }
+    if (_PyTypes_Share() < 0) {
+        return _PyStatus_ERR("can't share the static types");
+    }
+    return _PyStatus_OK();
+}
+#endif
+
+
 static PyStatus
 init_interp_main(PyThreadState *tstate)
 {
@@ -1163,6 +1215,15 @@ init_interp_main(PyThreadState *tstate)
 #endif
     }
 
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (is_main_interp) {
+        status = init_shared_objects(interp->runtime);
+        if (_PyStatus_EXCEPTION(status)) {
+            return status;
+        }
+    }
+#endif
+
     // Warn about PYTHONTHREADDEBUG deprecation
     _PyThread_debug_deprecation();
 
@@ -3,6 +3,7 @@
 
 #include "Python.h"
 #include "pycore_ceval.h"
+#include "pycore_code.h"          // _PyOpcodeProfile_Clear()
 #include "pycore_frame.h"
 #include "pycore_initconfig.h"
 #include "pycore_object.h"        // _PyType_InitCache()
@@ -312,6 +313,7 @@ interpreter_clear(PyInterpreterState *interp, PyThreadState *tstate)
     Py_CLEAR(interp->importlib);
     Py_CLEAR(interp->import_func);
     Py_CLEAR(interp->dict);
+    _PyOpcodeProfile_Clear(interp);
 #ifdef HAVE_FORK
     Py_CLEAR(interp->before_forkers);
     Py_CLEAR(interp->after_forkers_parent);
@@ -692,6 +694,9 @@ new_threadstate(PyInterpreterState *interp, int init)
     /* If top points to entry 0, then _PyThreadState_PopFrame will try to pop this chunk */
     tstate->datastack_top = &tstate->datastack_chunk->data[1];
     tstate->datastack_limit = (PyObject **)(((char *)tstate->datastack_chunk) + DATA_STACK_CHUNK_SIZE);
+    tstate->obmalloc_cache = NULL;
+    tstate->gil_priority = 0;
+    memset(&tstate->gil_stats, 0, sizeof(tstate->gil_stats));
     /* Mark trace_info as uninitialized */
     tstate->trace_info.code = NULL;
 
@@ -908,6 +913,10 @@ PyThreadState_Clear(PyThreadState *tstate)
     if (tstate->on_delete != NULL) {
         tstate->on_delete(tstate->on_delete_data);
     }
+
+    /* Flush the pymalloc cache while the GIL is held: PyThreadState_Delete()
+       doesn't require it. */
+    _PyObject_ClearThreadCache(tstate);
 }
 
 
@@ -1305,6 +1314,75 @@ _PyThread_CurrentFrames(void)
     return result;
 }
 
+static PyObject *
+gil_thread_stats_as_dict(_PyGILThreadStats *stats)
+{
+    PyObject *hold_histogram = PyTuple_New(_Py_GIL_HISTOGRAM_BUCKETS);
+    if (hold_histogram == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _Py_GIL_HISTOGRAM_BUCKETS; i++) {
+        PyObject *count = PyLong_FromUnsignedLongLong(
+            stats->hold_histogram[i]);
+        if (count == NULL) {
+            Py_DECREF(hold_histogram);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(hold_histogram, i, count);
+    }
+    return Py_BuildValue(
+        "{sKsdsdsKsN}",
+        "acquisitions", (unsigned long long)stats->acquisitions,
+        "wait_total", _PyTime_AsSecondsDouble(stats->wait_total),
+        "wait_max", _PyTime_AsSecondsDouble(stats->wait_max),
+        "forced_drops", (unsigned long long)stats->forced_drops,
+        "hold_histogram", hold_histogram);
+}
+
+/* The implementation of sys._getgilstats().  Threads only update their own
+   GIL stats while they hold the GIL of their interpreter, so only the threads
+   of the current interpreter are reported: the caller holds their GIL, which
+   keeps the counters consistent. */
+PyObject *
+_PyThread_GetGILStats(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    PyInterpreterState *interp = tstate->interp;
+
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    _PyRuntimeState *runtime = interp->runtime;
+    HEAD_LOCK(runtime);
+    for (PyThreadState *t = interp->tstate_head; t != NULL; t = t->next) {
+        PyObject *stats = gil_thread_stats_as_dict(&t->gil_stats);
+        if (stats == NULL) {
+            goto fail;
+        }
+        PyObject *id = PyLong_FromUnsignedLong(t->thread_id);
+        if (id == NULL) {
+            Py_DECREF(stats);
+            goto fail;
+        }
+        int stat = PyDict_SetItem(result, id, stats);
+        Py_DECREF(id);
+        Py_DECREF(stats);
+        if (stat < 0) {
+            goto fail;
+        }
+    }
+    goto done;
+
+fail:
+    Py_CLEAR(result);
+
+done:
+    HEAD_UNLOCK(runtime);
+    return result;
+}
+
 PyObject *
 _PyThread_CurrentExceptions(void)
 {
@@ -1416,7 +1494,14 @@ _PyGILState_SetTstate(PyThreadState *tstate)
     struct _gilstate_runtime_state *gilstate = &tstate->interp->runtime->gilstate;
 
     gilstate->autoInterpreterState = tstate->interp;
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    /* autoTSSkey also holds the current thread state, which
+       PyThreadState_Swap() already set */
+    assert(PyThread_tss_get(&gilstate->autoTSSkey) == NULL
+           || PyThread_tss_get(&gilstate->autoTSSkey) == tstate);
+#else
     assert(PyThread_tss_get(&gilstate->autoTSSkey) == NULL);
+#endif
     assert(tstate->gilstate_counter == 0);
 
     _PyGILState_NoteThreadState(gilstate, tstate);
@@ -1764,9 +1849,14 @@ _PyCrossInterpreterData_Release(_PyCrossInterpreterData *data)
     }
 
     // Switch to the original interpreter.
+    int had_error = (PyErr_Occurred() != NULL);
     PyInterpreterState *interp = _PyInterpreterState_LookUpID(data->interp);
     if (interp == NULL) {
         // The interpreter was already destroyed.
+        if (!had_error) {
+            // Don't leak the lookup error to the caller.
+            PyErr_Clear();
+        }
         if (data->free != NULL) {
             // XXX Someone leaked some memory...
         }
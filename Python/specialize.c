@@ -1,9 +1,12 @@
 #include "Python.h"
 #include "pycore_code.h"
+#include "pycore_descrobject.h"
 #include "pycore_dict.h"
 #include "pycore_long.h"
 #include "pycore_moduleobject.h"
 #include "pycore_object.h"
+#include "pycore_pystate.h"       // _PyInterpreterState_GET()
+#include "pycore_sliceobject.h"   // _PySlice_UnpackSmall()
 #include "opcode.h"
 #include "structmember.h"         // struct PyMemberDef, T_OFFSET_EX
 
@@ -130,6 +133,12 @@ _Py_GetSpecializationStats(void) {
     err += add_stat_dict(stats, CALL_FUNCTION, "call_function");
     err += add_stat_dict(stats, BINARY_OP, "binary_op");
     err += add_stat_dict(stats, COMPARE_OP, "compare_op");
+    err += add_stat_dict(stats, FOR_ITER, "for_iter");
+    err += add_stat_dict(stats, UNPACK_SEQUENCE, "unpack_sequence");
+    err += add_stat_dict(stats, CALL_METHOD, "call_method");
+    err += add_stat_dict(stats, CALL_METHOD_KW, "call_method_kw");
+    err += add_stat_dict(stats, CONTAINS_OP, "contains_op");
+    err += add_stat_dict(stats, STORE_GLOBAL, "store_global");
     if (err < 0) {
         Py_DECREF(stats);
         return NULL;
@@ -189,6 +198,12 @@ _Py_PrintSpecializationStats(void)
     print_stats(out, &_specialization_stats[CALL_FUNCTION], "call_function");
     print_stats(out, &_specialization_stats[BINARY_OP], "binary_op");
     print_stats(out, &_specialization_stats[COMPARE_OP], "compare_op");
+    print_stats(out, &_specialization_stats[FOR_ITER], "for_iter");
+    print_stats(out, &_specialization_stats[UNPACK_SEQUENCE], "unpack_sequence");
+    print_stats(out, &_specialization_stats[CALL_METHOD], "call_method");
+    print_stats(out, &_specialization_stats[CALL_METHOD_KW], "call_method_kw");
+    print_stats(out, &_specialization_stats[CONTAINS_OP], "contains_op");
+    print_stats(out, &_specialization_stats[STORE_GLOBAL], "store_global");
     if (out != stderr) {
         fclose(out);
     }
@@ -196,16 +211,199 @@ _Py_PrintSpecializationStats(void)
 
 #if COLLECT_SPECIALIZATION_STATS_DETAILED
 
-#define SPECIALIZATION_FAIL(opcode, kind) _specialization_stats[opcode].specialization_failure_kinds[kind]++
+#define SPECIALIZATION_FAIL_STAT(opcode, kind) _specialization_stats[opcode].specialization_failure_kinds[kind]++
 
 
 #endif
 #endif
 
-#ifndef SPECIALIZATION_FAIL
-#define SPECIALIZATION_FAIL(opcode, kind) ((void)0)
+/* Runtime opcode profile.
+ *
+ * Unlike the stats above, the opcode profile is always compiled in and is
+ * switched on and off at runtime.  It samples the specialization misses:
+ * while it is enabled, the miss handlers take a sample when the adaptive
+ * counter of the missing instruction runs out and the instruction is
+ * deoptimized, that is once every initial_counter_value() misses.  When
+ * the adaptive instruction then fails to specialize, SPECIALIZATION_FAIL()
+ * gives the reason of the sample.
+ *
+ * The samples are counted in interp->ceval.opcode_profile_misses, a dict
+ * mapping (code, offset, opcode, reason) to the number of samples, where
+ * opcode is the specialized opcode that missed and reason is a SPEC_FAIL_*
+ * kind, or None until a specialization of the instruction fails.  The
+ * samples waiting for a reason are in interp->ceval.opcode_profile_pending,
+ * which maps the address of their instruction to their key.  Profiled code
+ * objects are kept alive until the profile is reset.
+ */
+
+static int
+add_opcode_profile_sample(PyObject *misses, PyObject *key, Py_ssize_t n)
+{
+    PyObject *count = PyDict_GetItemWithError(misses, key);
+    if (count == NULL && PyErr_Occurred()) {
+        return -1;
+    }
+    n += count == NULL ? 0 : PyLong_AsSsize_t(count);
+    if (n == 0) {
+        return PyDict_DelItem(misses, key);
+    }
+    count = PyLong_FromSsize_t(n);
+    if (count == NULL) {
+        return -1;
+    }
+    int res = PyDict_SetItem(misses, key, count);
+    Py_DECREF(count);
+    return res;
+}
+
+static int
+record_miss(PyInterpreterState *interp, PyCodeObject *co, _Py_CODEUNIT *instr)
+{
+    if (interp->ceval.opcode_profile_misses == NULL) {
+        interp->ceval.opcode_profile_misses = PyDict_New();
+        if (interp->ceval.opcode_profile_misses == NULL) {
+            return -1;
+        }
+        interp->ceval.opcode_profile_pending = PyDict_New();
+        if (interp->ceval.opcode_profile_pending == NULL) {
+            Py_CLEAR(interp->ceval.opcode_profile_misses);
+            return -1;
+        }
+    }
+    Py_ssize_t offset = (instr - co->co_firstinstr) * sizeof(_Py_CODEUNIT);
+    PyObject *key = Py_BuildValue("(OniO)", co, offset, _Py_OPCODE(*instr),
+                                  Py_None);
+    if (key == NULL) {
+        return -1;
+    }
+    PyObject *address = PyLong_FromVoidPtr(instr);
+    if (address == NULL) {
+        Py_DECREF(key);
+        return -1;
+    }
+    int res = add_opcode_profile_sample(interp->ceval.opcode_profile_misses,
+                                        key, 1);
+    if (res == 0) {
+        res = PyDict_SetItem(interp->ceval.opcode_profile_pending,
+                             address, key);
+    }
+    Py_DECREF(address);
+    Py_DECREF(key);
+    return res;
+}
+
+/* Take a sample of the misses of the specialized instruction instr of co,
+ * which is being deoptimized. */
+void
+_PyOpcodeProfile_RecordMiss(PyCodeObject *co, _Py_CODEUNIT *instr)
+{
+    if (record_miss(_PyInterpreterState_GET(), co, instr) < 0) {
+        PyErr_Clear();
+    }
+}
+
+static int
+record_failure(PyInterpreterState *interp, _Py_CODEUNIT *instr, int kind)
+{
+    PyObject *pending = interp->ceval.opcode_profile_pending;
+    if (pending == NULL) {
+        return 0;
+    }
+    PyObject *address = PyLong_FromVoidPtr(instr);
+    if (address == NULL) {
+        return -1;
+    }
+    PyObject *key = PyDict_GetItemWithError(pending, address);
+    if (key == NULL) {
+        Py_DECREF(address);
+        return PyErr_Occurred() ? -1 : 0;
+    }
+    Py_INCREF(key);
+    int res = PyDict_DelItem(pending, address);
+    Py_DECREF(address);
+    PyObject *reason = NULL;
+    if (res == 0) {
+        reason = Py_BuildValue("(OOOi)", PyTuple_GET_ITEM(key, 0),
+                               PyTuple_GET_ITEM(key, 1),
+                               PyTuple_GET_ITEM(key, 2), kind);
+        res = reason == NULL ? -1 : 0;
+    }
+    PyObject *misses = interp->ceval.opcode_profile_misses;
+    if (res == 0) {
+        res = add_opcode_profile_sample(misses, key, -1);
+    }
+    if (res == 0) {
+        res = add_opcode_profile_sample(misses, reason, 1);
+    }
+    Py_XDECREF(reason);
+    Py_DECREF(key);
+    return res;
+}
+
+/* Give the reason of the last sample of instr, if it has no reason yet:
+ * the instruction couldn't be specialized again. */
+void
+_PyOpcodeProfile_RecordFailure(_Py_CODEUNIT *instr, int kind)
+{
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    if (record_failure(_PyInterpreterState_GET(), instr, kind) < 0) {
+        PyErr_Clear();
+    }
+    PyErr_Restore(type, value, traceback);
+}
+
+void
+_PyOpcodeProfile_Clear(PyInterpreterState *interp)
+{
+    Py_CLEAR(interp->ceval.opcode_profile_misses);
+    Py_CLEAR(interp->ceval.opcode_profile_pending);
+}
+
+void
+_PyOpcodeProfile_SetEnabled(int enabled)
+{
+    _PyInterpreterState_GET()->ceval.opcode_profile = enabled;
+}
+
+int
+_PyOpcodeProfile_IsEnabled(void)
+{
+    return _PyInterpreterState_GET()->ceval.opcode_profile;
+}
+
+/* Return a copy of the samples of the opcode profile: a dict mapping
+ * (code, offset, opcode, reason) to a number of samples. */
+PyObject *
+_PyOpcodeProfile_Get(void)
+{
+    PyObject *misses = _PyInterpreterState_GET()->ceval.opcode_profile_misses;
+    if (misses == NULL) {
+        return PyDict_New();
+    }
+    return PyDict_Copy(misses);
+}
+
+void
+_PyOpcodeProfile_Reset(void)
+{
+    _PyOpcodeProfile_Clear(_PyInterpreterState_GET());
+}
+
+#ifndef SPECIALIZATION_FAIL_STAT
+#define SPECIALIZATION_FAIL_STAT(opcode, kind) ((void)0)
 #endif
 
+/* Record why the instruction instr could not be specialized.  The kind is
+ * only computed for the stats or while the opcode profile is enabled. */
+#define SPECIALIZATION_FAIL(opcode, kind) \
+    do { \
+        SPECIALIZATION_FAIL_STAT(opcode, kind); \
+        if (_PyInterpreterState_GET()->ceval.opcode_profile) { \
+            _PyOpcodeProfile_RecordFailure(instr, (kind)); \
+        } \
+    } while (0)
+
 static SpecializedCacheOrInstruction *
 allocate(int cache_count, int instruction_count)
 {
@@ -242,11 +440,17 @@ static uint8_t adaptive_opcodes[256] = {
     [STORE_ATTR] = STORE_ATTR_ADAPTIVE,
     [BINARY_OP] = BINARY_OP_ADAPTIVE,
     [COMPARE_OP] = COMPARE_OP_ADAPTIVE,
+    [FOR_ITER] = FOR_ITER_ADAPTIVE,
+    [UNPACK_SEQUENCE] = UNPACK_SEQUENCE_ADAPTIVE,
+    [CALL_METHOD] = CALL_METHOD_ADAPTIVE,
+    [CALL_METHOD_KW] = CALL_METHOD_KW_ADAPTIVE,
+    [CONTAINS_OP] = CONTAINS_OP_ADAPTIVE,
+    [STORE_GLOBAL] = STORE_GLOBAL_ADAPTIVE,
 };
 
 /* The number of cache entries required for a "family" of instructions. */
 static uint8_t cache_requirements[256] = {
-    [LOAD_ATTR] = 2, /* _PyAdaptiveEntry and _PyAttrCache */
+    [LOAD_ATTR] = 3, /* _PyAdaptiveEntry, _PyAttrCache and _PyObjectCache */
     [LOAD_GLOBAL] = 2, /* _PyAdaptiveEntry and _PyLoadGlobalCache */
     [LOAD_METHOD] = 3, /* _PyAdaptiveEntry, _PyAttrCache and _PyObjectCache */
     [BINARY_SUBSCR] = 2, /* _PyAdaptiveEntry, _PyObjectCache */
@@ -255,6 +459,12 @@ static uint8_t cache_requirements[256] = {
     [STORE_ATTR] = 2, /* _PyAdaptiveEntry and _PyAttrCache */
     [BINARY_OP] = 1,  // _PyAdaptiveEntry
     [COMPARE_OP] = 1, /* _PyAdaptiveEntry */
+    [FOR_ITER] = 1, /* _PyAdaptiveEntry */
+    [UNPACK_SEQUENCE] = 1, /* _PyAdaptiveEntry */
+    [CALL_METHOD] = 2, /* _PyAdaptiveEntry and _PyCallCache */
+    [CALL_METHOD_KW] = 1, /* _PyAdaptiveEntry */
+    [CONTAINS_OP] = 1, /* _PyAdaptiveEntry */
+    [STORE_GLOBAL] = 1, /* _PyAdaptiveEntry */
 };
 
 /* Return the oparg for the cache_offset and instruction index.
@@ -313,6 +523,14 @@ first_instruction(SpecializedCacheOrInstruction *quickened)
     return &quickened[get_cache_count(quickened)].code[0];
 }
 
+/* Pair-profiling builds leave the pairs of instructions unfused,
+ * so that both halves of each pair are counted. */
+#if defined(DYNAMIC_EXECUTION_PROFILE) && defined(DXPAIRS)
+#define INSERT_SUPERINSTRUCTIONS 0
+#else
+#define INSERT_SUPERINSTRUCTIONS 1
+#endif
+
 /** Insert adaptive instructions and superinstructions.
  *
  * Skip instruction preceded by EXTENDED_ARG for adaptive
@@ -325,7 +543,9 @@ optimize(SpecializedCacheOrInstruction *quickened, int len)
     _Py_CODEUNIT *instructions = first_instruction(quickened);
     int cache_offset = 0;
     int previous_opcode = -1;
+#if INSERT_SUPERINSTRUCTIONS
     int previous_oparg = 0;
+#endif
     for(int i = 0; i < len; i++) {
         int opcode = _Py_OPCODE(instructions[i]);
         int oparg = _Py_OPARG(instructions[i]);
@@ -361,6 +581,7 @@ optimize(SpecializedCacheOrInstruction *quickened, int len)
                 case JUMP_ABSOLUTE:
                     instructions[i] = _Py_MAKECODEUNIT(JUMP_ABSOLUTE_QUICK, oparg);
                     break;
+#if INSERT_SUPERINSTRUCTIONS
                 case LOAD_FAST:
                     switch(previous_opcode) {
                         case LOAD_FAST:
@@ -384,9 +605,22 @@ optimize(SpecializedCacheOrInstruction *quickened, int len)
                         instructions[i-1] = _Py_MAKECODEUNIT(LOAD_FAST__LOAD_CONST, previous_oparg);
                     }
                     break;
+                case POP_JUMP_IF_FALSE:
+                    if (previous_opcode == IS_OP) {
+                        instructions[i-1] = _Py_MAKECODEUNIT(IS_OP__POP_JUMP_IF_FALSE, previous_oparg);
+                    }
+                    break;
+                case POP_JUMP_IF_TRUE:
+                    if (previous_opcode == IS_OP) {
+                        instructions[i-1] = _Py_MAKECODEUNIT(IS_OP__POP_JUMP_IF_TRUE, previous_oparg);
+                    }
+                    break;
+#endif
             }
             previous_opcode = opcode;
+#if INSERT_SUPERINSTRUCTIONS
             previous_oparg = oparg;
+#endif
         }
     }
     assert(cache_offset+1 == get_cache_count(quickened));
@@ -451,6 +685,12 @@ initial_counter_value(void) {
 #define SPEC_FAIL_NON_OBJECT_SLOT 14
 #define SPEC_FAIL_READ_ONLY 15
 #define SPEC_FAIL_AUDITED_SLOT 16
+#define SPEC_FAIL_METACLASS_ATTRIBUTE 17
+#define SPEC_FAIL_PROPERTY_NOT_SIMPLE_FUNCTION 18
+
+/* Globals */
+
+#define SPEC_FAIL_NOT_INTERNED 8
 
 /* Methods */
 
@@ -491,11 +731,35 @@ initial_counter_value(void) {
 #define SPEC_FAIL_BAD_CALL_FLAGS 17
 #define SPEC_FAIL_CLASS 18
 
+/* CALL_METHOD */
+#define SPEC_FAIL_NO_SELF 19
+
 /* COMPARE_OP */
 #define SPEC_FAIL_STRING_COMPARE 13
 #define SPEC_FAIL_NOT_FOLLOWED_BY_COND_JUMP 14
 #define SPEC_FAIL_BIG_INT 15
 
+/* FOR_ITER */
+#define SPEC_FAIL_ITER_LIST_REVERSED 10
+#define SPEC_FAIL_ITER_RANGE_NO_STORE 11
+#define SPEC_FAIL_ITER_LONG_RANGE 12
+#define SPEC_FAIL_ITER_DICT_KEYS 13
+#define SPEC_FAIL_ITER_DICT_ITEMS 14
+#define SPEC_FAIL_ITER_DICT_VALUES 15
+#define SPEC_FAIL_ITER_ENUMERATE 16
+
+/* UNPACK_SEQUENCE */
+#define SPEC_FAIL_UNPACK_SEQUENCE_ITERATOR 8
+#define SPEC_FAIL_UNPACK_SEQUENCE_SEQUENCE 9
+
+/* CONTAINS_OP */
+#define SPEC_FAIL_CONTAINS_OP_LIST 8
+#define SPEC_FAIL_CONTAINS_OP_TUPLE 9
+#define SPEC_FAIL_CONTAINS_OP_DICT_SUBCLASS 10
+#define SPEC_FAIL_CONTAINS_OP_SET_SUBCLASS 11
+#define SPEC_FAIL_CONTAINS_OP_DICT_VIEW 12
+#define SPEC_FAIL_CONTAINS_OP_BYTES 13
+
 static int
 specialize_module_load_attr(
     PyObject *owner, _Py_CODEUNIT *instr, PyObject *name,
@@ -549,6 +813,23 @@ specialize_module_load_attr(
 
 /* Attribute specialization */
 
+#define SIMPLE_FUNCTION 0
+
+static int
+function_kind(PyCodeObject *code) {
+    int flags = code->co_flags;
+    if (flags & (CO_GENERATOR | CO_COROUTINE | CO_ASYNC_GENERATOR)) {
+        return SPEC_FAIL_GENERATOR;
+    }
+    if ((flags & (CO_VARKEYWORDS | CO_VARARGS)) || code->co_kwonlyargcount) {
+        return SPEC_FAIL_COMPLEX_PARAMETERS;
+    }
+    if ((flags & CO_OPTIMIZED) == 0) {
+        return SPEC_FAIL_CO_NOT_OPTIMIZED;
+    }
+    return SIMPLE_FUNCTION;
+}
+
 typedef enum {
     OVERRIDING, /* Is an overriding descriptor, and will remain so. */
     METHOD, /* Attribute has Py_TPFLAGS_METHOD_DESCRIPTOR set */
@@ -696,11 +977,133 @@ specialize_dict_access(
     }
 }
 
+/* Attribute of a class, looked up on the class itself: C.attr.
+ * The value is borrowed from the class dict (or that of a base class);
+ * it is kept alive as long as the version tag of the class is unchanged. */
+static int
+specialize_class_load_attr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name,
+                           _PyAdaptiveEntry *cache0, _PyAttrCache *cache1,
+                           _PyObjectCache *cache2)
+{
+    PyTypeObject *cls = (PyTypeObject *)owner;
+    PyTypeObject *metaclass = Py_TYPE(owner);
+    if (metaclass->tp_getattro != PyType_Type.tp_getattro) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OVERRIDDEN);
+        return -1;
+    }
+    if (_PyType_Lookup(metaclass, name) != NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_METACLASS_ATTRIBUTE);
+        return -1;
+    }
+    PyObject *descr = _PyType_Lookup(cls, name);
+    if (descr == NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_EXPECTED_ERROR);
+        return -1;
+    }
+    PyTypeObject *desc_cls = Py_TYPE(descr);
+    if (!(desc_cls->tp_flags & Py_TPFLAGS_IMMUTABLETYPE)) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_MUTABLE_CLASS);
+        return -1;
+    }
+    /* Functions and method descriptors return themselves
+     * when looked up on the class. */
+    if (desc_cls->tp_descr_get != NULL &&
+        desc_cls != &PyFunction_Type && desc_cls != &PyMethodDescr_Type)
+    {
+        SPECIALIZATION_FAIL(LOAD_ATTR, desc_cls->tp_descr_set ?
+            SPEC_FAIL_OVERRIDING_DESCRIPTOR : SPEC_FAIL_NON_OVERRIDING_DESCRIPTOR);
+        return -1;
+    }
+    if (!_PyType_HasFeature(cls, Py_TPFLAGS_VALID_VERSION_TAG) ||
+        !_PyType_HasFeature(metaclass, Py_TPFLAGS_VALID_VERSION_TAG))
+    {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    cache0->version = metaclass->tp_version_tag;
+    cache1->tp_version = cls->tp_version_tag;
+    cache2->obj = descr;
+    *instr = _Py_MAKECODEUNIT(LOAD_ATTR_CLASS, _Py_OPARG(*instr));
+    return 0;
+}
+
+/* A property whose getter is a simple Python function taking only self.
+ * The property object is borrowed from the class, like the value in
+ * specialize_class_load_attr(); the getter is checked by its version,
+ * as it can be replaced by calling property.__init__() again. */
+static int
+specialize_property(PyTypeObject *type, PyObject *descr, _Py_CODEUNIT *instr,
+                    _PyAdaptiveEntry *cache0, _PyAttrCache *cache1,
+                    _PyObjectCache *cache2)
+{
+    assert(Py_IS_TYPE(descr, &PyProperty_Type));
+    PyObject *fget = ((_PyPropertyObject *)descr)->prop_get;
+    if (fget == NULL || !PyFunction_Check(fget)) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_PROPERTY);
+        return -1;
+    }
+    PyCodeObject *code = (PyCodeObject *)((PyFunctionObject *)fget)->func_code;
+    if (function_kind(code) != SIMPLE_FUNCTION || code->co_argcount != 1) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_PROPERTY_NOT_SIMPLE_FUNCTION);
+        return -1;
+    }
+    uint32_t version = _PyFunction_GetVersionForCurrentState((PyFunctionObject *)fget);
+    if (version == 0 || !_PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    cache0->version = version;
+    cache1->tp_version = type->tp_version_tag;
+    cache2->obj = descr;
+    *instr = _Py_MAKECODEUNIT(LOAD_ATTR_PROPERTY, _Py_OPARG(*instr));
+    return 0;
+}
+
+/* A non-descriptor class attribute, loaded through an instance
+ * that cannot have an attribute of the same name.
+ * Returns 1 if specialized, 0 if the instance may hold the attribute. */
+static int
+specialize_nondescriptor(PyObject *owner, PyTypeObject *type, PyObject *name,
+                         PyObject *descr, _Py_CODEUNIT *instr,
+                         _PyAttrCache *cache1, _PyObjectCache *cache2)
+{
+    if (!_PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+        return 0;
+    }
+    if (type->tp_dictoffset == 0) {
+        cache1->dk_version_or_hint = 0;
+    }
+    else if (type->tp_inline_values_offset) {
+        PyObject **dictptr = _PyObject_DictPointer(owner);
+        assert(dictptr);
+        if (*dictptr != NULL) {
+            return 0;
+        }
+        PyDictKeysObject *keys = ((PyHeapTypeObject *)type)->ht_cached_keys;
+        if (_PyDictKeys_StringLookup(keys, name) != DKIX_EMPTY) {
+            return 0;
+        }
+        uint32_t keys_version = _PyDictKeys_GetVersionForCurrentState(keys);
+        if (keys_version == 0) {
+            return 0;
+        }
+        cache1->dk_version_or_hint = keys_version;
+    }
+    else {
+        return 0;
+    }
+    cache1->tp_version = type->tp_version_tag;
+    cache2->obj = descr;
+    *instr = _Py_MAKECODEUNIT(LOAD_ATTR_NONDESCRIPTOR, _Py_OPARG(*instr));
+    return 1;
+}
+
 int
 _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, SpecializedCacheEntry *cache)
 {
     _PyAdaptiveEntry *cache0 = &cache->adaptive;
     _PyAttrCache *cache1 = &cache[-1].attr;
+    _PyObjectCache *cache2 = &cache[-2].obj;
     if (PyModule_CheckExact(owner)) {
         int err = specialize_module_load_attr(owner, instr, name, cache0, cache1,
             LOAD_ATTR, LOAD_ATTR_MODULE);
@@ -715,6 +1118,14 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, Sp
             return -1;
         }
     }
+    if (PyType_Check(owner)) {
+        int err = specialize_class_load_attr(owner, instr, name,
+                                             cache0, cache1, cache2);
+        if (err) {
+            goto fail;
+        }
+        goto success;
+    }
     PyObject *descr;
     DesciptorClassification kind = analyze_descriptor(type, name, &descr, 0);
     switch(kind) {
@@ -725,8 +1136,10 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, Sp
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_METHOD);
             goto fail;
         case PROPERTY:
-            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_PROPERTY);
-            goto fail;
+            if (specialize_property(type, descr, instr, cache0, cache1, cache2)) {
+                goto fail;
+            }
+            goto success;
         case OBJECT_SLOT:
         {
             PyMemberDescrObject *member = (PyMemberDescrObject *)descr;
@@ -765,10 +1178,15 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, Sp
         case GETSET_OVERRIDDEN:
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OVERRIDDEN);
             goto fail;
+        case NON_DESCRIPTOR:
+            if (specialize_nondescriptor(owner, type, name, descr, instr,
+                                         cache1, cache2)) {
+                goto success;
+            }
+            break;
         case BUILTIN_CLASSMETHOD:
         case PYTHON_CLASSMETHOD:
         case NON_OVERRIDING:
-        case NON_DESCRIPTOR:
         case ABSENT:
             break;
     }
@@ -877,7 +1295,6 @@ _Py_Specialize_StoreAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name, S
 }
 
 
-#if COLLECT_SPECIALIZATION_STATS_DETAILED
 static int
 load_method_fail_kind(DesciptorClassification kind)
 {
@@ -911,7 +1328,6 @@ load_method_fail_kind(DesciptorClassification kind)
     }
     Py_UNREACHABLE();
 }
-#endif
 
 static int
 specialize_class_load_method(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name,
@@ -1062,11 +1478,13 @@ _Py_Specialize_LoadGlobal(
         if (index != (uint16_t)index) {
             goto fail;
         }
-        uint32_t keys_version = _PyDictKeys_GetVersionForCurrentState(globals_keys);
-        if (keys_version == 0) {
+        /* LOAD_GLOBAL_MODULE checks the key of the entry rather than the
+         * version of the keys, so that adding or removing other globals
+         * does not invalidate it. */
+        if (DK_ENTRIES(globals_keys)[index].me_key != name) {
+            SPECIALIZATION_FAIL(LOAD_GLOBAL, SPEC_FAIL_NOT_INTERNED);
             goto fail;
         }
-        cache1->module_keys_version = keys_version;
         cache0->index = (uint16_t)index;
         *instr = _Py_MAKECODEUNIT(LOAD_GLOBAL_MODULE, _Py_OPARG(*instr));
         goto success;
@@ -1110,7 +1528,48 @@ _Py_Specialize_LoadGlobal(
     return 0;
 }
 
-#if COLLECT_SPECIALIZATION_STATS_DETAILED
+int
+_Py_Specialize_StoreGlobal(
+    PyObject *globals, _Py_CODEUNIT *instr, PyObject *name,
+    SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *cache0 = &cache->adaptive;
+    assert(PyUnicode_CheckExact(name));
+    if (!PyDict_CheckExact(globals)) {
+        SPECIALIZATION_FAIL(STORE_GLOBAL, SPEC_FAIL_OTHER);
+        goto fail;
+    }
+    PyDictKeysObject *globals_keys = ((PyDictObject *)globals)->ma_keys;
+    Py_ssize_t index = _PyDictKeys_StringLookup(globals_keys, name);
+    if (index == DKIX_ERROR) {
+        SPECIALIZATION_FAIL(STORE_GLOBAL, SPEC_FAIL_NON_STRING_OR_SPLIT);
+        goto fail;
+    }
+    if (index == DKIX_EMPTY) {
+        SPECIALIZATION_FAIL(STORE_GLOBAL, SPEC_FAIL_MODULE_ATTR_NOT_FOUND);
+        goto fail;
+    }
+    if (index != (uint16_t)index) {
+        SPECIALIZATION_FAIL(STORE_GLOBAL, SPEC_FAIL_OUT_OF_RANGE);
+        goto fail;
+    }
+    if (DK_ENTRIES(globals_keys)[index].me_key != name) {
+        SPECIALIZATION_FAIL(STORE_GLOBAL, SPEC_FAIL_NOT_INTERNED);
+        goto fail;
+    }
+    cache0->index = (uint16_t)index;
+    *instr = _Py_MAKECODEUNIT(STORE_GLOBAL_MODULE, _Py_OPARG(*instr));
+    STAT_INC(STORE_GLOBAL, specialization_success);
+    assert(!PyErr_Occurred());
+    cache0->counter = initial_counter_value();
+    return 0;
+fail:
+    STAT_INC(STORE_GLOBAL, specialization_failure);
+    assert(!PyErr_Occurred());
+    cache_backoff(cache0);
+    return 0;
+}
+
 static int
 binary_subscr_fail_kind(PyTypeObject *container_type, PyObject *sub)
 {
@@ -1148,38 +1607,25 @@ binary_subscr_fail_kind(PyTypeObject *container_type, PyObject *sub)
     }
     return SPEC_FAIL_OTHER;
 }
-#endif
 
 _Py_IDENTIFIER(__getitem__);
 
-#define SIMPLE_FUNCTION 0
-
-static int
-function_kind(PyCodeObject *code) {
-    int flags = code->co_flags;
-    if (flags & (CO_GENERATOR | CO_COROUTINE | CO_ASYNC_GENERATOR)) {
-        return SPEC_FAIL_GENERATOR;
-    }
-    if ((flags & (CO_VARKEYWORDS | CO_VARARGS)) || code->co_kwonlyargcount) {
-        return SPEC_FAIL_COMPLEX_PARAMETERS;
-    }
-    if ((flags & CO_OPTIMIZED) == 0) {
-        return SPEC_FAIL_CO_NOT_OPTIMIZED;
-    }
-    return SIMPLE_FUNCTION;
-}
-
 int
 _Py_Specialize_BinarySubscr(
      PyObject *container, PyObject *sub, _Py_CODEUNIT *instr, SpecializedCacheEntry *cache)
 {
     _PyAdaptiveEntry *cache0 = &cache->adaptive;
     PyTypeObject *container_type = Py_TYPE(container);
+    Py_ssize_t start, stop;
     if (container_type == &PyList_Type) {
         if (PyLong_CheckExact(sub)) {
             *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_LIST_INT, _Py_OPARG(*instr));
             goto success;
         }
+        if (PySlice_Check(sub) && _PySlice_UnpackSmall(sub, 0, &start, &stop)) {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_LIST_SLICE, _Py_OPARG(*instr));
+            goto success;
+        }
         SPECIALIZATION_FAIL(BINARY_SUBSCR,
             PySlice_Check(sub) ? SPEC_FAIL_LIST_SLICE : SPEC_FAIL_OTHER);
         goto fail;
@@ -1197,6 +1643,45 @@ _Py_Specialize_BinarySubscr(
         *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_DICT, _Py_OPARG(*instr));
         goto success;
     }
+    if (container_type == &PyBytes_Type) {
+        if (PyLong_CheckExact(sub)) {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_BYTES_INT, _Py_OPARG(*instr));
+            goto success;
+        }
+        if (PySlice_Check(sub) && _PySlice_UnpackSmall(sub, 0, &start, &stop)) {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_BYTES_SLICE, _Py_OPARG(*instr));
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_BUFFER_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
+    if (container_type == &PyByteArray_Type) {
+        if (PyLong_CheckExact(sub)) {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_BYTEARRAY_INT, _Py_OPARG(*instr));
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_BUFFER_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
+    if (container_type == &PyUnicode_Type) {
+        /* Only strings of latin-1 characters, for which indexing returns
+           a cached one-character string. */
+        if (PyLong_CheckExact(sub) && PyUnicode_IS_READY(container) &&
+            PyUnicode_KIND(container) == PyUnicode_1BYTE_KIND)
+        {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_STR_INT, _Py_OPARG(*instr));
+            goto success;
+        }
+        if (PySlice_Check(sub) && _PySlice_UnpackSmall(sub, 0, &start, &stop)) {
+            *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_STR_SLICE, _Py_OPARG(*instr));
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+                            binary_subscr_fail_kind(container_type, sub));
+        goto fail;
+    }
     PyTypeObject *cls = Py_TYPE(container);
     PyObject *descriptor = _PyType_LookupId(cls, &PyId___getitem__);
     if (descriptor && Py_TYPE(descriptor) == &PyFunction_Type) {
@@ -1223,6 +1708,22 @@ _Py_Specialize_BinarySubscr(
         *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_GETITEM, _Py_OPARG(*instr));
         goto success;
     }
+    if (PyLong_CheckExact(sub) &&
+        _PyType_HasFeature(container_type, Py_TPFLAGS_SEQUENCE) &&
+        container_type->tp_as_sequence != NULL &&
+        container_type->tp_as_sequence->sq_item != NULL)
+    {
+        /* For sequences, such as memoryview, range, deque and array.array,
+           indexing with a non-negative int is equivalent to calling sq_item,
+           which skips the conversion of the index. */
+        if (!_PyType_HasFeature(container_type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+            SPECIALIZATION_FAIL(BINARY_SUBSCR, SPEC_FAIL_OUT_OF_VERSIONS);
+            goto fail;
+        }
+        cache0->version = container_type->tp_version_tag;
+        *instr = _Py_MAKECODEUNIT(BINARY_SUBSCR_SEQUENCE_INT, _Py_OPARG(*instr));
+        goto success;
+    }
     SPECIALIZATION_FAIL(BINARY_SUBSCR,
                         binary_subscr_fail_kind(container_type, sub));
 fail:
@@ -1269,6 +1770,26 @@ _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *ins
                                   initial_counter_value());
          goto success;
     }
+    else if (container_type == &PyByteArray_Type) {
+        if (PyLong_CheckExact(sub)) {
+            if ((Py_SIZE(sub) == 0 || Py_SIZE(sub) == 1)
+                && ((PyLongObject *)sub)->ob_digit[0] < PyByteArray_GET_SIZE(container))
+            {
+                *instr = _Py_MAKECODEUNIT(STORE_SUBSCR_BYTEARRAY_INT,
+                                          initial_counter_value());
+                goto success;
+            }
+            else {
+                SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_OUT_OF_RANGE);
+                goto fail;
+            }
+        }
+        else {
+            SPECIALIZATION_FAIL(STORE_SUBSCR,
+                PySlice_Check(sub) ? SPEC_FAIL_BUFFER_SLICE : SPEC_FAIL_OTHER);
+            goto fail;
+        }
+    }
     else {
         SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_OTHER);
         goto fail;
@@ -1296,13 +1817,14 @@ specialize_class_call(
 static int
 specialize_py_call(
     PyFunctionObject *func, _Py_CODEUNIT *instr,
-    int nargs, SpecializedCacheEntry *cache)
+    int nargs, SpecializedCacheEntry *cache,
+    int base_op, int specialized_op)
 {
     _PyCallCache *cache1 = &cache[-1].call;
     PyCodeObject *code = (PyCodeObject *)func->func_code;
     int kind = function_kind(code);
     if (kind != SIMPLE_FUNCTION) {
-        SPECIALIZATION_FAIL(CALL_FUNCTION, kind);
+        SPECIALIZATION_FAIL(base_op, kind);
         return -1;
     }
     int argcount = code->co_argcount;
@@ -1310,7 +1832,7 @@ specialize_py_call(
     assert(defcount <= argcount);
     int min_args = argcount-defcount;
     if (nargs > argcount || nargs < min_args) {
-        SPECIALIZATION_FAIL(CALL_FUNCTION, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+        SPECIALIZATION_FAIL(base_op, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
         return -1;
     }
     assert(nargs <= argcount && nargs >= min_args);
@@ -1319,22 +1841,21 @@ specialize_py_call(
     assert(defstart >= 0 && deflen >= 0);
     assert(deflen == 0 || func->func_defaults != NULL);
     if (defstart > 0xffff || deflen > 0xffff) {
-        SPECIALIZATION_FAIL(CALL_FUNCTION, SPEC_FAIL_OUT_OF_RANGE);
+        SPECIALIZATION_FAIL(base_op, SPEC_FAIL_OUT_OF_RANGE);
         return -1;
     }
     int version = _PyFunction_GetVersionForCurrentState(func);
     if (version == 0) {
-        SPECIALIZATION_FAIL(CALL_FUNCTION, SPEC_FAIL_OUT_OF_VERSIONS);
+        SPECIALIZATION_FAIL(base_op, SPEC_FAIL_OUT_OF_VERSIONS);
         return -1;
     }
     cache1->func_version = version;
     cache1->defaults_start = defstart;
     cache1->defaults_len = deflen;
-    *instr = _Py_MAKECODEUNIT(CALL_FUNCTION_PY_SIMPLE, _Py_OPARG(*instr));
+    *instr = _Py_MAKECODEUNIT(specialized_op, _Py_OPARG(*instr));
     return 0;
 }
 
-#if COLLECT_SPECIALIZATION_STATS_DETAILED
 static int
 builtin_call_fail_kind(int ml_flags)
 {
@@ -1356,7 +1877,6 @@ builtin_call_fail_kind(int ml_flags)
             return SPEC_FAIL_BAD_CALL_FLAGS;
     }
 }
-#endif
 
 static int
 specialize_c_call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
@@ -1409,7 +1929,6 @@ specialize_c_call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
     }
 }
 
-#if COLLECT_SPECIALIZATION_STATS_DETAILED
 static int
 call_fail_kind(PyObject *callable)
 {
@@ -1428,7 +1947,6 @@ call_fail_kind(PyObject *callable)
     }
     return SPEC_FAIL_OTHER;
 }
-#endif
 
 /* TODO:
     - Specialize calling classes.
@@ -1444,7 +1962,8 @@ _Py_Specialize_CallFunction(
         fail = specialize_c_call(callable, instr, nargs, cache, builtins);
     }
     else if (PyFunction_Check(callable)) {
-        fail = specialize_py_call((PyFunctionObject *)callable, instr, nargs, cache);
+        fail = specialize_py_call((PyFunctionObject *)callable, instr, nargs,
+                                  cache, CALL_FUNCTION, CALL_FUNCTION_PY_SIMPLE);
     }
     else if (PyType_Check(callable)) {
         fail = specialize_class_call(callable, instr, nargs, cache);
@@ -1467,6 +1986,124 @@ _Py_Specialize_CallFunction(
     return 0;
 }
 
+/* Method descriptors are called with self as the first argument.
+ * The specialized instructions check the exact flags and the type of self,
+ * then call the C function directly rather than through vectorcall. */
+static int
+specialize_method_descriptor(
+    PyMethodDescrObject *descr, _Py_CODEUNIT *instr,
+    int nargs, int base_op)
+{
+    if (nargs == 0) {
+        SPECIALIZATION_FAIL(base_op, SPEC_FAIL_NO_SELF);
+        return -1;
+    }
+    int flags = descr->d_method->ml_flags;
+    if (base_op == CALL_METHOD_KW) {
+        if (flags != (METH_FASTCALL | METH_KEYWORDS)) {
+            SPECIALIZATION_FAIL(base_op, builtin_call_fail_kind(flags));
+            return -1;
+        }
+        *instr = _Py_MAKECODEUNIT(CALL_METHOD_KW_DESCRIPTOR_FAST_WITH_KEYWORDS,
+                                  _Py_OPARG(*instr));
+        return 0;
+    }
+    switch (flags) {
+        case METH_NOARGS:
+            if (nargs != 1) {
+                SPECIALIZATION_FAIL(base_op, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+                return -1;
+            }
+            *instr = _Py_MAKECODEUNIT(CALL_METHOD_DESCRIPTOR_NOARGS,
+                                      _Py_OPARG(*instr));
+            return 0;
+        case METH_O:
+            if (nargs != 2) {
+                SPECIALIZATION_FAIL(base_op, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+                return -1;
+            }
+            *instr = _Py_MAKECODEUNIT(CALL_METHOD_DESCRIPTOR_O,
+                                      _Py_OPARG(*instr));
+            return 0;
+        case METH_FASTCALL:
+            *instr = _Py_MAKECODEUNIT(CALL_METHOD_DESCRIPTOR_FAST,
+                                      _Py_OPARG(*instr));
+            return 0;
+        case METH_FASTCALL | METH_KEYWORDS:
+            *instr = _Py_MAKECODEUNIT(CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS,
+                                      _Py_OPARG(*instr));
+            return 0;
+        default:
+            SPECIALIZATION_FAIL(base_op, builtin_call_fail_kind(flags));
+            return -1;
+    }
+}
+
+/* nargs includes self, if LOAD_METHOD found a method. */
+int
+_Py_Specialize_CallMethod(
+    PyObject *callable, _Py_CODEUNIT *instr,
+    int nargs, int is_method, SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *cache0 = &cache->adaptive;
+    int fail;
+    if (Py_IS_TYPE(callable, &PyMethodDescr_Type)) {
+        fail = specialize_method_descriptor(
+            (PyMethodDescrObject *)callable, instr, nargs, CALL_METHOD);
+    }
+    else if (PyFunction_Check(callable)) {
+        fail = specialize_py_call((PyFunctionObject *)callable, instr, nargs,
+                                  cache, CALL_METHOD, CALL_METHOD_PY_SIMPLE);
+        /* The number of arguments depends on whether LOAD_METHOD
+         * found a method, so record which case we specialized for. */
+        cache0->index = is_method;
+    }
+    else {
+        SPECIALIZATION_FAIL(CALL_METHOD, call_fail_kind(callable));
+        fail = -1;
+    }
+    if (fail) {
+        STAT_INC(CALL_METHOD, specialization_failure);
+        assert(!PyErr_Occurred());
+        cache_backoff(cache0);
+    }
+    else {
+        STAT_INC(CALL_METHOD, specialization_success);
+        assert(!PyErr_Occurred());
+        cache0->counter = initial_counter_value();
+    }
+    return 0;
+}
+
+/* nargs is the number of positional arguments, including self. */
+int
+_Py_Specialize_CallMethodKw(
+    PyObject *callable, _Py_CODEUNIT *instr,
+    int nargs, SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *cache0 = &cache->adaptive;
+    int fail;
+    if (Py_IS_TYPE(callable, &PyMethodDescr_Type)) {
+        fail = specialize_method_descriptor(
+            (PyMethodDescrObject *)callable, instr, nargs, CALL_METHOD_KW);
+    }
+    else {
+        SPECIALIZATION_FAIL(CALL_METHOD_KW, call_fail_kind(callable));
+        fail = -1;
+    }
+    if (fail) {
+        STAT_INC(CALL_METHOD_KW, specialization_failure);
+        assert(!PyErr_Occurred());
+        cache_backoff(cache0);
+    }
+    else {
+        STAT_INC(CALL_METHOD_KW, specialization_success);
+        assert(!PyErr_Occurred());
+        cache0->counter = initial_counter_value();
+    }
+    return 0;
+}
+
 void
 _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
                         SpecializedCacheEntry *cache)
@@ -1615,3 +2252,190 @@ _Py_Specialize_CompareOp(PyObject *lhs, PyObject *rhs,
     STAT_INC(COMPARE_OP, specialization_success);
     adaptive->counter = initial_counter_value();
 }
+
+static int
+for_iter_fail_kind(PyTypeObject *type)
+{
+    if (type == &PyListRevIter_Type) {
+        return SPEC_FAIL_ITER_LIST_REVERSED;
+    }
+    if (type == &PyLongRangeIter_Type) {
+        return SPEC_FAIL_ITER_LONG_RANGE;
+    }
+    if (type == &PyDictIterKey_Type) {
+        return SPEC_FAIL_ITER_DICT_KEYS;
+    }
+    if (type == &PyDictIterItem_Type) {
+        return SPEC_FAIL_ITER_DICT_ITEMS;
+    }
+    if (type == &PyDictIterValue_Type) {
+        return SPEC_FAIL_ITER_DICT_VALUES;
+    }
+    if (type == &PyEnum_Type) {
+        return SPEC_FAIL_ITER_ENUMERATE;
+    }
+    return SPEC_FAIL_OTHER;
+}
+
+static int
+is_store_fast(_Py_CODEUNIT instr)
+{
+    /* The superinstructions starting with STORE_FAST keep the oparg
+     * of the STORE_FAST, and leave the second instruction in place. */
+    switch (_Py_OPCODE(instr)) {
+        case STORE_FAST:
+        case STORE_FAST__LOAD_FAST:
+        case STORE_FAST__STORE_FAST:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+void
+_Py_Specialize_ForIter(PyObject *iter, _Py_CODEUNIT *instr,
+                       SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *adaptive = &cache->adaptive;
+    PyTypeObject *tp = Py_TYPE(iter);
+    if (tp == &PyListIter_Type) {
+        *instr = _Py_MAKECODEUNIT(FOR_ITER_LIST, _Py_OPARG(*instr));
+        goto success;
+    }
+    if (tp == &PyTupleIter_Type) {
+        *instr = _Py_MAKECODEUNIT(FOR_ITER_TUPLE, _Py_OPARG(*instr));
+        goto success;
+    }
+    if (tp == &PyRangeIter_Type) {
+        /* FOR_ITER_RANGE stores the value directly into the local
+         * variable, skipping the following STORE_FAST. */
+        if (!is_store_fast(instr[1])) {
+            SPECIALIZATION_FAIL(FOR_ITER, SPEC_FAIL_ITER_RANGE_NO_STORE);
+            goto failure;
+        }
+        *instr = _Py_MAKECODEUNIT(FOR_ITER_RANGE, _Py_OPARG(*instr));
+        goto success;
+    }
+    if (tp == &PyGen_Type) {
+        *instr = _Py_MAKECODEUNIT(FOR_ITER_GEN, _Py_OPARG(*instr));
+        goto success;
+    }
+    SPECIALIZATION_FAIL(FOR_ITER, for_iter_fail_kind(tp));
+failure:
+    STAT_INC(FOR_ITER, specialization_failure);
+    cache_backoff(adaptive);
+    return;
+success:
+    STAT_INC(FOR_ITER, specialization_success);
+    adaptive->counter = initial_counter_value();
+}
+
+static int
+unpack_sequence_fail_kind(PyObject *seq)
+{
+    if (PySequence_Check(seq)) {
+        return SPEC_FAIL_UNPACK_SEQUENCE_SEQUENCE;
+    }
+    if (PyIter_Check(seq)) {
+        return SPEC_FAIL_UNPACK_SEQUENCE_ITERATOR;
+    }
+    return SPEC_FAIL_OTHER;
+}
+
+void
+_Py_Specialize_UnpackSequence(PyObject *seq, _Py_CODEUNIT *instr,
+                              SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *adaptive = &cache->adaptive;
+    if (PyTuple_CheckExact(seq)) {
+        if (PyTuple_GET_SIZE(seq) != adaptive->original_oparg) {
+            SPECIALIZATION_FAIL(UNPACK_SEQUENCE, SPEC_FAIL_EXPECTED_ERROR);
+            goto failure;
+        }
+        if (PyTuple_GET_SIZE(seq) == 2) {
+            *instr = _Py_MAKECODEUNIT(UNPACK_SEQUENCE_TWO_TUPLE,
+                                      _Py_OPARG(*instr));
+            goto success;
+        }
+        *instr = _Py_MAKECODEUNIT(UNPACK_SEQUENCE_TUPLE, _Py_OPARG(*instr));
+        goto success;
+    }
+    if (PyList_CheckExact(seq)) {
+        if (PyList_GET_SIZE(seq) != adaptive->original_oparg) {
+            SPECIALIZATION_FAIL(UNPACK_SEQUENCE, SPEC_FAIL_EXPECTED_ERROR);
+            goto failure;
+        }
+        *instr = _Py_MAKECODEUNIT(UNPACK_SEQUENCE_LIST, _Py_OPARG(*instr));
+        goto success;
+    }
+    SPECIALIZATION_FAIL(UNPACK_SEQUENCE, unpack_sequence_fail_kind(seq));
+failure:
+    STAT_INC(UNPACK_SEQUENCE, specialization_failure);
+    cache_backoff(adaptive);
+    return;
+success:
+    STAT_INC(UNPACK_SEQUENCE, specialization_success);
+    adaptive->counter = initial_counter_value();
+}
+
+static int
+contains_op_fail_kind(PyObject *container)
+{
+    if (PyList_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_LIST;
+    }
+    if (PyTuple_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_TUPLE;
+    }
+    if (PyDict_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_DICT_SUBCLASS;
+    }
+    if (PyAnySet_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_SET_SUBCLASS;
+    }
+    if (PyDictKeys_Check(container) || PyDictItems_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_DICT_VIEW;
+    }
+    if (PyBytes_Check(container) || PyByteArray_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_BYTES;
+    }
+    return SPEC_FAIL_OTHER;
+}
+
+void
+_Py_Specialize_ContainsOp(PyObject *container, _Py_CODEUNIT *instr,
+                          SpecializedCacheEntry *cache)
+{
+    _PyAdaptiveEntry *adaptive = &cache->adaptive;
+    int next_opcode = _Py_OPCODE(instr[1]);
+    /* As for COMPARE_OP, fuse with a following conditional jump.
+     * index records the result of the containment test that jumps. */
+    int jump = (next_opcode == POP_JUMP_IF_FALSE ||
+                next_opcode == POP_JUMP_IF_TRUE);
+    if (jump) {
+        adaptive->index = (next_opcode == POP_JUMP_IF_TRUE) ^
+                          adaptive->original_oparg;
+    }
+    if (PyDict_CheckExact(container)) {
+        *instr = _Py_MAKECODEUNIT(jump ? CONTAINS_OP_DICT_JUMP : CONTAINS_OP_DICT,
+                                  _Py_OPARG(*instr));
+        goto success;
+    }
+    if (PySet_CheckExact(container) || PyFrozenSet_CheckExact(container)) {
+        *instr = _Py_MAKECODEUNIT(jump ? CONTAINS_OP_SET_JUMP : CONTAINS_OP_SET,
+                                  _Py_OPARG(*instr));
+        goto success;
+    }
+    if (PyUnicode_CheckExact(container)) {
+        *instr = _Py_MAKECODEUNIT(jump ? CONTAINS_OP_STR_JUMP : CONTAINS_OP_STR,
+                                  _Py_OPARG(*instr));
+        goto success;
+    }
+    SPECIALIZATION_FAIL(CONTAINS_OP, contains_op_fail_kind(container));
+    STAT_INC(CONTAINS_OP, specialization_failure);
+    cache_backoff(adaptive);
+    return;
+success:
+    STAT_INC(CONTAINS_OP, specialization_success);
+    adaptive->counter = initial_counter_value();
+}
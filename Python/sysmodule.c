@@ -1157,6 +1157,154 @@ sys_getswitchinterval_impl(PyObject *module)
     return 1e-6 * _PyEval_GetSwitchInterval();
 }
 
+static const char * const gil_policy_names[] = {
+    [_Py_GIL_POLICY_DEFAULT] = "default",
+    [_Py_GIL_POLICY_PRIORITY] = "priority",
+};
+
+/*[clinic input]
+sys._setgilpolicy
+
+    policy: str
+    /
+
+Set the policy which decides which waiting thread takes the GIL next.
+
+With the 'default' policy, threads compete for the GIL when it is
+released.  With the 'priority' policy, the GIL is handed over to the
+waiting thread of the highest priority (see sys._setgilpriority()),
+favoring the threads returning from a blocking call, like I/O, among
+those of the same priority.  Such a thread asks the thread holding the
+GIL to release it without waiting for the switch interval if it ranks
+higher.
+[clinic start generated code]*/
+
+static PyObject *
+sys__setgilpolicy_impl(PyObject *module, const char *policy)
+/*[clinic end generated code: output=783d506c8a5ac5a7 input=85427e203e70f444]*/
+{
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(gil_policy_names); i++) {
+        if (strcmp(policy, gil_policy_names[i]) == 0) {
+            _PyEval_SetGILPolicy((int)i);
+            Py_RETURN_NONE;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "unknown GIL policy: '%s'", policy);
+    return NULL;
+}
+
+
+/*[clinic input]
+sys._getgilpolicy
+
+Return the name of the current GIL policy; see sys._setgilpolicy().
+[clinic start generated code]*/
+
+static PyObject *
+sys__getgilpolicy_impl(PyObject *module)
+/*[clinic end generated code: output=2566df1806c8d0b6 input=e876a83d3a6bbd19]*/
+{
+    return PyUnicode_FromString(gil_policy_names[_PyEval_GetGILPolicy()]);
+}
+
+
+/*[clinic input]
+sys._setgilpriority
+
+    priority: int
+    /
+
+Set the priority of the current thread under the 'priority' GIL policy.
+
+Threads of a higher priority take the GIL first.  The default priority
+is 0.  The new priority applies from the next time the thread waits for
+the GIL.
+[clinic start generated code]*/
+
+static PyObject *
+sys__setgilpriority_impl(PyObject *module, int priority)
+/*[clinic end generated code: output=d91af7a97bd1da66 input=a495f1f5ac5b0be8]*/
+{
+    _PyThreadState_GET()->gil_priority = priority;
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+sys._getgilpriority -> int
+
+Return the priority of the current thread; see sys._setgilpriority().
+[clinic start generated code]*/
+
+static int
+sys__getgilpriority_impl(PyObject *module)
+/*[clinic end generated code: output=49f675852fd3c85f input=ff9eb6d7d5690659]*/
+{
+    return _PyThreadState_GET()->gil_priority;
+}
+
+
+/*[clinic input]
+sys._getgilstats
+
+Return a dictionary of how each thread of this interpreter used the GIL.
+
+It maps the identifier of each thread to a dictionary of counters:
+
+acquisitions
+    The number of times the thread took the GIL.
+wait_total, wait_max
+    The total and longest time in seconds that it waited to take it.
+forced_drops
+    The number of times it released the GIL while another thread was
+    requesting it, usually because it held it for longer than the
+    switch interval.
+hold_histogram
+    How long it held the GIL each time, in the same buckets as
+    sys._getgilwaithistogram().
+[clinic start generated code]*/
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module)
+/*[clinic end generated code: output=6cfe4e3b51e0e160 input=897c78b92f22e040]*/
+{
+    return _PyThread_GetGILStats();
+}
+
+
+/*[clinic input]
+sys._getgilwaithistogram
+
+Return a histogram of how long the threads waited to take the GIL.
+
+This is a tuple of counts of acquisitions.  The first item counts those
+which waited less than a microsecond, including all the acquisitions of
+a GIL which was free.  Item i counts those which waited from 2**(i-1) to
+2**i microseconds, and the last item all those which waited longer.
+[clinic start generated code]*/
+
+static PyObject *
+sys__getgilwaithistogram_impl(PyObject *module)
+/*[clinic end generated code: output=477871a252586416 input=6c34ec07d0a3b956]*/
+{
+    uint64_t buckets[_Py_GIL_HISTOGRAM_BUCKETS];
+    _PyEval_GetGILWaitHistogram(buckets);
+
+    PyObject *result = PyTuple_New(_Py_GIL_HISTOGRAM_BUCKETS);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _Py_GIL_HISTOGRAM_BUCKETS; i++) {
+        PyObject *count = PyLong_FromUnsignedLongLong(buckets[i]);
+        if (count == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(result, i, count);
+    }
+    return result;
+}
+
 /*[clinic input]
 sys.setrecursionlimit
 
@@ -1994,6 +2142,12 @@ static PyMethodDef sys_methods[] = {
     SYS_MDEBUG_METHODDEF
     SYS_SETSWITCHINTERVAL_METHODDEF
     SYS_GETSWITCHINTERVAL_METHODDEF
+    SYS__SETGILPOLICY_METHODDEF
+    SYS__GETGILPOLICY_METHODDEF
+    SYS__SETGILPRIORITY_METHODDEF
+    SYS__GETGILPRIORITY_METHODDEF
+    SYS__GETGILSTATS_METHODDEF
+    SYS__GETGILWAITHISTOGRAM_METHODDEF
     SYS_SETDLOPENFLAGS_METHODDEF
     {"setprofile",      sys_setprofile, METH_O, setprofile_doc},
     SYS_GETPROFILE_METHODDEF
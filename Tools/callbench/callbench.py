@@ -0,0 +1,127 @@
+"""Benchmark the overhead of Python-to-Python calls.
+
+Each benchmark makes a large number of calls to small Python functions,
+through the different call instructions, and reports the time per call.
+Python-to-Python calls are executed without recursing into the C
+evaluation loop, so the deep recursion benchmark also checks that call
+chains close to the recursion limit do not exhaust the C stack.
+
+"""
+import argparse
+import sys
+import time
+
+
+def f0():
+    return 1
+
+def f1(a):
+    return a
+
+def f2(a, b=2):
+    return b
+
+class C:
+    def m1(self, a):
+        return a
+
+def call_positional(loops):
+    """f(a) via CALL_FUNCTION"""
+    f = f1
+    for _ in range(loops):
+        f(1); f(1); f(1); f(1); f(1)
+        f(1); f(1); f(1); f(1); f(1)
+    return loops * 10
+
+def call_defaults(loops):
+    """f(a) with defaults"""
+    f = f2
+    for _ in range(loops):
+        f(1); f(1); f(1); f(1); f(1)
+        f(1); f(1); f(1); f(1); f(1)
+    return loops * 10
+
+def call_keywords(loops):
+    """f(a, b=b) via CALL_FUNCTION_KW"""
+    f = f2
+    for _ in range(loops):
+        f(1, b=2); f(1, b=2); f(1, b=2); f(1, b=2); f(1, b=2)
+        f(1, b=2); f(1, b=2); f(1, b=2); f(1, b=2); f(1, b=2)
+    return loops * 10
+
+def call_method(loops):
+    """obj.m(a) via CALL_METHOD"""
+    o = C()
+    for _ in range(loops):
+        o.m1(1); o.m1(1); o.m1(1); o.m1(1); o.m1(1)
+        o.m1(1); o.m1(1); o.m1(1); o.m1(1); o.m1(1)
+    return loops * 10
+
+def call_ex(loops):
+    """f(*args, **kwargs) via CALL_FUNCTION_EX"""
+    f = f2
+    args = (1,)
+    kwargs = {'b': 2}
+    for _ in range(loops):
+        f(*args, **kwargs); f(*args, **kwargs); f(*args, **kwargs)
+        f(*args, **kwargs); f(*args, **kwargs); f(*args, **kwargs)
+        f(*args, **kwargs); f(*args, **kwargs); f(*args, **kwargs)
+        f(*args, **kwargs)
+    return loops * 10
+
+def _recurse(n):
+    if n == 0:
+        return 0
+    return _recurse(n - 1) + 1
+
+def deep_recursion(loops):
+    """recursion close to the recursion limit"""
+    depth = sys.getrecursionlimit() - 50
+    for _ in range(loops // depth + 1):
+        _recurse(depth)
+    return (loops // depth + 1) * depth
+
+
+BENCHMARKS = [
+    call_positional,
+    call_defaults,
+    call_keywords,
+    call_method,
+    call_ex,
+    deep_recursion,
+]
+
+
+def bench(func, loops, repeat):
+    """Return the best time per call, in nanoseconds."""
+    func(loops // 10 or 1)  # warm up and specialize
+    best = None
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        calls = func(loops)
+        elapsed = time.perf_counter() - t0
+        per_call = elapsed / calls * 1e9
+        if best is None or per_call < best:
+            best = per_call
+    return best
+
+
+def main(loops, repeat, benchmarks):
+    for func in BENCHMARKS:
+        if benchmarks and func.__name__ not in benchmarks:
+            continue
+        per_call = bench(func, loops, repeat)
+        print("{:<40} {:8.1f} ns/call".format(func.__doc__, per_call),
+              flush=True)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--loops", type=int, default=100_000,
+                        help="number of loop iterations (default: 100000)")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of repetitions (default: 5)")
+    parser.add_argument("benchmarks", nargs="*",
+                        help="names of the benchmarks to run (default: all)")
+    args = parser.parse_args()
+    main(args.loops, args.repeat, args.benchmarks)
@@ -17,6 +17,11 @@
 from optparse import OptionParser, SUPPRESS_HELP
 import platform
 
+try:
+    import _xxsubinterpreters as interpreters
+except ImportError:
+    interpreters = None
+
 # Compatibility
 try:
     xrange
@@ -237,7 +242,84 @@ def run():
 
     return results
 
-def run_throughput_tests(max_threads):
+# Scripts run in each subinterpreter: the first one prepares the task outside
+# of the measurement, the second one runs it and sends back the result.
+SUBINTERP_SETUP = """if 1:
+    import sys
+    sys.path.insert(0, %(path)r)
+    import ccbench
+    func, args = ccbench.%(task)s()
+    # Warm up
+    func(*args)
+    loop = ccbench.TimedLoop(func, args)
+"""
+
+SUBINTERP_RUN = """if 1:
+    import _xxsubinterpreters as interpreters
+    niters, duration = loop(%(start_time)r, %(duration)r, [], do_yield=False)
+    interpreters.channel_send(cid, "%%d %%r" %% (niters, duration))
+"""
+
+def run_subinterp_throughput_test(task, ninterps):
+    """Run the task in `ninterps` subinterpreters, one per thread.
+
+    Unlike threads, the subinterpreters cannot tell each other when the
+    measurement ends: each one runs the task for the whole duration.
+    """
+    assert ninterps >= 1
+
+    setup = SUBINTERP_SETUP % dict(
+        path=os.path.dirname(os.path.abspath(__file__)),
+        task=task.__name__)
+    interps = [interpreters.create() for i in range(ninterps)]
+    cid = interpreters.channel_create()
+    try:
+        for interp in interps:
+            interpreters.run_string(interp, setup, dict(cid=cid))
+
+        started = False
+        ready_cond = threading.Condition()
+        start_cond = threading.Condition()
+        ready = []
+
+        def run(interp):
+            with ready_cond:
+                ready.append(None)
+                ready_cond.notify()
+            with start_cond:
+                while not started:
+                    start_cond.wait()
+            script = SUBINTERP_RUN % dict(start_time=start_time,
+                                          duration=THROUGHPUT_DURATION)
+            interpreters.run_string(interp, script)
+
+        threads = []
+        for interp in interps:
+            threads.append(threading.Thread(target=run, args=(interp,)))
+        for t in threads:
+            t.daemon = True
+            t.start()
+        with ready_cond:
+            while len(ready) < ninterps:
+                ready_cond.wait()
+        with start_cond:
+            start_time = time.time()
+            started = True
+            start_cond.notify(ninterps)
+        for t in threads:
+            t.join()
+
+        results = []
+        for interp in interps:
+            niters, duration = interpreters.channel_recv(cid).split()
+            results.append((int(niters), float(duration)))
+        return results
+    finally:
+        interpreters.channel_destroy(cid)
+        for interp in interps:
+            interpreters.destroy(interp)
+
+def run_throughput_tests(max_threads, subinterpreters=False):
     for task in throughput_tasks:
         print(task.__doc__)
         print()
@@ -245,11 +327,15 @@ def run_throughput_tests(max_threads):
         nthreads = 1
         baseline_speed = None
         while nthreads <= max_threads:
-            results = run_throughput_test(func, args, nthreads)
+            if subinterpreters:
+                results = run_subinterp_throughput_test(task, nthreads)
+            else:
+                results = run_throughput_test(func, args, nthreads)
             # Taking the max duration rather than average gives pessimistic
             # results rather than optimistic.
             speed = sum(r[0] for r in results) / max(r[1] for r in results)
-            print("threads=%d: %d" % (nthreads, speed), end="")
+            print("%s=%d: %d" % ("interpreters" if subinterpreters
+                                 else "threads", nthreads, speed), end="")
             if baseline_speed is None:
                 print(" iterations/s.")
                 baseline_speed = speed
@@ -543,6 +629,10 @@ def main():
     parser.add_option("-n", "--num-threads",
                       action="store", type="int", dest="nthreads", default=4,
                       help="max number of threads in tests")
+    parser.add_option("-s", "--subinterpreters",
+                      action="store_true", dest="subinterpreters", default=False,
+                      help="run each thread of the throughput tests in its own "
+                           "subinterpreter")
 
     # Hidden option to run the pinging and bandwidth clients
     parser.add_option("", "--latclient",
@@ -566,6 +656,10 @@ def main():
         bandwidth_client(**kwargs)
         return
 
+    if options.subinterpreters:
+        if interpreters is None:
+            parser.error("subinterpreters are not supported")
+        options.throughput = True
     if not options.throughput and not options.latency and not options.bandwidth:
         options.throughput = options.latency = options.bandwidth = True
     if options.check_interval:
@@ -590,7 +684,7 @@ def main():
     if options.throughput:
         print("--- Throughput ---")
         print()
-        run_throughput_tests(options.nthreads)
+        run_throughput_tests(options.nthreads, options.subinterpreters)
 
     if options.latency:
         print("--- Latency ---")
@@ -0,0 +1,133 @@
+"""Measure the memory that forked children stop sharing with their parent.
+
+The parent process builds a heap of dicts, lists, instances and strings,
+as a server does when it loads its application, then forks children which
+all read the whole heap and run a full garbage collection.  Each page of the
+heap that a child writes to, if only to update a reference count or a GC
+header, is copied: the benchmark reports the private memory that each
+child gained, for each way of preparing the heap before forking:
+
+* none: fork without calling gc.freeze();
+* freeze: call gc.freeze() before forking;
+* immortal: call gc.freeze(immortal=True) before forking.
+
+Each mode runs in a fresh interpreter, since immortal objects cannot be
+made mortal again.  Linux only: the private memory is read from
+/proc/self/smaps_rollup.
+"""
+import argparse
+import gc
+import os
+import subprocess
+import sys
+
+
+MODES = ("none", "freeze", "immortal")
+
+
+class Record:
+    def __init__(self, key, values):
+        self.key = key
+        self.values = values
+        self.attrs = {"name": key, "size": len(values)}
+
+
+def build_heap(size):
+    """Build a heap of about `size` records, referenced by a single list."""
+    heap = []
+    for i in range(size):
+        key = "record-%d" % i
+        values = [i, i * 2.0, str(i), (i, key)]
+        heap.append(Record(key, values))
+        heap.append({"index": i, "key": key, "values": values})
+    return heap
+
+
+def read_heap(heap):
+    """Access every object of the heap, as requests served by a child do."""
+    total = 0
+    for item in heap:
+        if isinstance(item, Record):
+            total += item.attrs["size"] + len(item.key)
+            for value in item.values:
+                total += value is not None
+        else:
+            total += item["index"] + len(item["values"])
+    return total
+
+
+def private_memory():
+    """Return the private memory of the process, in bytes."""
+    total = 0
+    with open("/proc/self/smaps_rollup") as fp:
+        for line in fp:
+            if line.startswith(("Private_Clean:", "Private_Dirty:")):
+                total += int(line.split()[1]) * 1024
+    return total
+
+
+def child(heap, rounds, wfd):
+    before = private_memory()
+    for i in range(rounds):
+        read_heap(heap)
+        gc.collect()
+    after = private_memory()
+    os.write(wfd, b"%d\n" % (after - before))
+    os._exit(0)
+
+
+def run_mode(mode, size, children, rounds):
+    """Fork children after preparing the heap and print their mean growth."""
+    heap = build_heap(size)
+    gc.collect()
+    if mode == "freeze":
+        gc.freeze()
+    elif mode == "immortal":
+        gc.freeze(immortal=True)
+
+    growth = []
+    for i in range(children):
+        rfd, wfd = os.pipe()
+        pid = os.fork()
+        if pid == 0:
+            os.close(rfd)
+            child(heap, rounds, wfd)
+        os.close(wfd)
+        with os.fdopen(rfd) as fp:
+            growth.append(int(fp.read()))
+        os.waitpid(pid, 0)
+    print(sum(growth) / len(growth))
+
+
+def main(modes, size, children, rounds):
+    print("{:<12}{:>20}".format("mode", "child growth (MiB)"))
+    for mode in modes:
+        cmd = [sys.executable, __file__, "--run", mode,
+               "-n", str(size), "-c", str(children), "-r", str(rounds)]
+        out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE,
+                             text=True).stdout
+        print("{:<12}{:>20.1f}".format(mode, float(out) / 2**20), flush=True)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--size", type=int, default=200_000,
+                        help="number of records of the heap "
+                             "(default: 200000)")
+    parser.add_argument("-c", "--children", type=int, default=4,
+                        help="number of forked children (default: 4)")
+    parser.add_argument("-r", "--rounds", type=int, default=3,
+                        help="number of times each child reads the heap "
+                             "(default: 3)")
+    parser.add_argument("--run", choices=MODES, help=argparse.SUPPRESS)
+    parser.add_argument("modes", nargs="*",
+                        help="modes to compare: none, freeze or immortal "
+                             "(default: all)")
+    args = parser.parse_args()
+    for mode in args.modes:
+        if mode not in MODES:
+            parser.error("unknown mode: %r" % mode)
+    if args.run:
+        run_mode(args.run, args.size, args.children, args.rounds)
+    else:
+        main(args.modes or MODES, args.size, args.children, args.rounds)
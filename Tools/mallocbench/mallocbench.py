@@ -0,0 +1,127 @@
+"""Benchmark the throughput of small object allocation with several threads.
+
+Each thread repeatedly allocates and frees small objects, and releases
+the GIL between batches of allocations, as C extensions do, so that the
+GIL is passed back and forth between the threads.  The benchmark reports
+the number of allocations per second for each number of threads.
+"""
+import argparse
+import sys
+import threading
+import time
+
+
+def alloc_tuples(n):
+    """tuples of 2 items"""
+    for i in range(n):
+        (i, i); (i, i); (i, i); (i, i); (i, i)
+        (i, i); (i, i); (i, i); (i, i); (i, i)
+    return n * 10
+
+def alloc_lists(n):
+    """lists of 3 items"""
+    for i in range(n):
+        [i, i, i]; [i, i, i]; [i, i, i]; [i, i, i]; [i, i, i]
+        [i, i, i]; [i, i, i]; [i, i, i]; [i, i, i]; [i, i, i]
+    return n * 10
+
+def alloc_dicts(n):
+    """dicts of 2 items"""
+    for i in range(n):
+        {1: i, 2: i}; {1: i, 2: i}; {1: i, 2: i}; {1: i, 2: i}
+        {1: i, 2: i}; {1: i, 2: i}; {1: i, 2: i}; {1: i, 2: i}
+    return n * 8
+
+class Point:
+    __slots__ = ('x', 'y')
+
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+def alloc_instances(n):
+    """instances with __slots__"""
+    for i in range(n):
+        Point(i, i); Point(i, i); Point(i, i); Point(i, i); Point(i, i)
+    return n * 5
+
+def alloc_retained(n):
+    """lists kept alive for a while"""
+    keep = [None] * 256
+    for i in range(n):
+        keep[i & 255] = [i, i]
+        keep[(i + 128) & 255] = (i, i, i)
+    return n * 2
+
+
+BENCHMARKS = [
+    alloc_tuples,
+    alloc_lists,
+    alloc_dicts,
+    alloc_instances,
+    alloc_retained,
+]
+
+
+def run_threads(func, nthreads, duration, batch):
+    """Return the number of allocations per second of nthreads threads."""
+    counts = [0] * nthreads
+    start = threading.Barrier(nthreads + 1)
+    stop = False
+
+    def worker(index):
+        count = 0
+        start.wait()
+        while not stop:
+            count += func(batch)
+            # Release the GIL, as a C extension doing some I/O would do.
+            time.sleep(0)
+        counts[index] = count
+
+    threads = [threading.Thread(target=worker, args=(i,))
+               for i in range(nthreads)]
+    for thread in threads:
+        thread.start()
+    start.wait()
+    t0 = time.perf_counter()
+    time.sleep(duration)
+    stop = True
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - t0
+    return sum(counts) / elapsed
+
+
+def main(threads, duration, batch, benchmarks):
+    print("{:<32}".format("allocations/s"), end="")
+    for nthreads in threads:
+        print("{:>12}".format(f"{nthreads} threads"), end="")
+    print()
+    for func in BENCHMARKS:
+        if benchmarks and func.__name__ not in benchmarks:
+            continue
+        print("{:<32}".format(func.__doc__), end="", flush=True)
+        for nthreads in threads:
+            rate = run_threads(func, nthreads, duration, batch)
+            print("{:>12.3g}".format(rate), end="", flush=True)
+        print()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-t", "--threads", type=int, nargs="+",
+                        default=[1, 2, 4, 8],
+                        help="numbers of threads (default: 1 2 4 8)")
+    parser.add_argument("-d", "--duration", type=float, default=2.0,
+                        help="duration of each run in seconds (default: 2)")
+    parser.add_argument("-b", "--batch", type=int, default=100,
+                        help="loop iterations between GIL releases "
+                             "(default: 100)")
+    parser.add_argument("-i", "--switch-interval", type=float,
+                        help="set sys.setswitchinterval() (in seconds)")
+    parser.add_argument("benchmarks", nargs="*",
+                        help="names of the benchmarks to run (default: all)")
+    args = parser.parse_args()
+    if args.switch_interval is not None:
+        sys.setswitchinterval(args.switch_interval)
+    main(args.threads, args.duration, args.batch, args.benchmarks)
@@ -0,0 +1,106 @@
+"""Measure the throughput of queue.SimpleQueue between threads.
+
+The same number of producer and consumer threads pass items through a
+single queue, for each number of threads.  Each producer puts its share of
+the items, one at a time with put() or in batches with put_many(), then a
+sentinel; each consumer gets items with get() or get_many() until it sees
+a sentinel.  With --release-gil, the producers release and take back the
+GIL before each put, as threads which read their items from a socket or a
+file do.  The benchmark reports the number of items passed per second, for
+the C implementation and for the pure Python one.
+"""
+import argparse
+import queue
+import threading
+import time
+
+
+THREADS = (1, 2, 4, 8, 16, 32)
+IMPLEMENTATIONS = {
+    "c": queue.SimpleQueue,
+    "py": queue._PySimpleQueue,
+}
+
+
+def produce(q, count, batch, release_gil):
+    if batch > 1:
+        items = list(range(batch))
+        for i in range(count // batch):
+            if release_gil:
+                time.sleep(0)
+            q.put_many(items)
+    else:
+        for i in range(count):
+            if release_gil:
+                time.sleep(0)
+            q.put(i)
+    q.put(None)
+
+
+def consume(q, batch):
+    if batch > 1:
+        while True:
+            items = q.get_many(batch)
+            if None in items:
+                # Leave the other items to the other consumers
+                q.put_many(items[items.index(None) + 1:])
+                return
+    else:
+        while q.get() is not None:
+            pass
+
+
+def run(impl, nthreads, items, batch, release_gil):
+    """Return the number of items passed per second."""
+    q = IMPLEMENTATIONS[impl]()
+    count = items // nthreads // batch * batch
+    threads = [threading.Thread(target=produce,
+                                args=(q, count, batch, release_gil))
+               for i in range(nthreads)]
+    threads += [threading.Thread(target=consume, args=(q, batch))
+                for i in range(nthreads)]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return count * nthreads / (time.perf_counter() - start)
+
+
+def main(impls, threads, items, batch, release_gil):
+    print("{:<8}".format("threads")
+          + "".join("{:>16}".format(impl + " (items/s)") for impl in impls))
+    for nthreads in threads:
+        line = "{:<8}".format(nthreads)
+        for impl in impls:
+            rate = run(impl, nthreads, items, batch, release_gil)
+            line += "{:>16.0f}".format(rate)
+        print(line, flush=True)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--items", type=int, default=200_000,
+                        help="number of items passed through the queue "
+                             "(default: 200000)")
+    parser.add_argument("-b", "--batch", type=int, default=1,
+                        help="number of items put and got by each call, "
+                             "using put_many() and get_many() when it is "
+                             "more than 1 (default: 1)")
+    parser.add_argument("-t", "--threads", type=int, action="append",
+                        help="number of producers and of consumers; can be "
+                             "repeated (default: 1, 2, 4, 8, 16 and 32)")
+    parser.add_argument("--release-gil", action="store_true",
+                        help="release the GIL in the producers before "
+                             "each put")
+    parser.add_argument("impls", nargs="*",
+                        help="implementations to compare: c or py "
+                             "(default: both)")
+    args = parser.parse_args()
+    for impl in args.impls:
+        if impl not in IMPLEMENTATIONS:
+            parser.error("unknown implementation: %r" % impl)
+    if args.batch < 1:
+        parser.error("the batch size must be positive")
+    main(args.impls or list(IMPLEMENTATIONS), args.threads or THREADS,
+         args.items, args.batch, args.release_gil)
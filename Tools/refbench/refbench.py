@@ -0,0 +1,185 @@
+"""Compare the speed of Python interpreters on reference counting heavy code.
+
+The workloads are small versions of pyperformance benchmarks: recursive
+calls, method calls on small objects, float arithmetic on lists, JSON and
+regular expressions, sequence unpacking, generators and string methods.
+They spend most of their time creating, sharing and dropping references,
+so they show the cost of a change to Py_INCREF() and Py_DECREF(), such as
+the check for immortal objects.
+
+Run without arguments, the script times each workload with the running
+interpreter.  With --compare, it runs itself with each of the given
+interpreters in turn, alternating their order on each round, and reports
+the median time of each workload and its ratio to the first interpreter,
+with their geometric mean.
+"""
+import argparse
+import json
+import math
+import re
+import statistics
+import subprocess
+import sys
+import time
+
+
+def fib(n):
+    return n if n < 2 else fib(n - 1) + fib(n - 2)
+
+def bench_fib():
+    fib(23)
+
+
+class Task:
+    def __init__(self, prio, data):
+        self.prio = prio
+        self.data = data
+
+    def run(self, x):
+        return self.data + x * self.prio
+
+def bench_methods():
+    tasks = [Task(i % 7, i) for i in range(200)]
+    total = 0
+    for r in range(300):
+        for task in tasks:
+            total += task.run(r)
+
+
+def bench_nbody():
+    bodies = [[float(i), i * 0.5, i * 0.25, 0.1, 0.2, 0.3, 1.0 + i]
+              for i in range(5)]
+    for step in range(20000):
+        for i in range(5):
+            bi = bodies[i]
+            for j in range(i + 1, 5):
+                bj = bodies[j]
+                dx = bi[0] - bj[0]
+                dy = bi[1] - bj[1]
+                dz = bi[2] - bj[2]
+                mag = 0.001 / (dx * dx + dy * dy + dz * dz + 0.01) ** 1.5
+                bi[3] -= dx * bj[6] * mag
+                bj[3] += dx * bi[6] * mag
+                bi[4] -= dy * bj[6] * mag
+                bj[4] += dy * bi[6] * mag
+        for b in bodies:
+            b[0] += 0.001 * b[3]
+            b[1] += 0.001 * b[4]
+            b[2] += 0.001 * b[5]
+
+
+DOC = json.dumps([{"id": i, "name": "n%d" % i, "tags": ["a", "b"],
+                   "value": i / 3} for i in range(3000)])
+
+def bench_json():
+    for i in range(10):
+        json.dumps(json.loads(DOC))
+
+
+PATTERN = re.compile(r"(\w+)@(\w+)\.com")
+TEXT = " ".join("user%d@host%d.com and some words" % (i, i)
+                for i in range(3000))
+
+def bench_regex():
+    for i in range(20):
+        [m.groups() for m in PATTERN.finditer(TEXT)]
+
+
+def bench_unpack_sequence():
+    t = (1, 2, 3, 4, 5)
+    for i in range(300000):
+        a, b, c, d, e = t
+        a, b = b, a
+
+
+def bench_generators():
+    def items(n):
+        for i in range(n):
+            yield i, str(i)
+    for r in range(10):
+        d = dict(items(20000))
+        sorted(d.items(), key=lambda item: item[1])
+
+
+def bench_strings():
+    words = ["alpha", "beta", "gamma", "delta"] * 1000
+    for r in range(30):
+        s = ",".join(w.upper() for w in words)
+        s.split(",")
+        s.replace("ALPHA", "x").count("x")
+
+
+BENCHMARKS = {
+    "fib": bench_fib,
+    "methods": bench_methods,
+    "nbody": bench_nbody,
+    "json": bench_json,
+    "regex": bench_regex,
+    "unpack_sequence": bench_unpack_sequence,
+    "generators": bench_generators,
+    "strings": bench_strings,
+}
+
+
+def run_benchmarks(repeat):
+    """Print the best CPU time of each workload, in seconds."""
+    for name, func in BENCHMARKS.items():
+        func()
+        best = float("inf")
+        for i in range(repeat):
+            start = time.process_time()
+            func()
+            best = min(best, time.process_time() - start)
+        print(name, best, flush=True)
+
+
+def compare(pythons, rounds, repeat):
+    times = {python: {} for python in pythons}
+    for r in range(rounds):
+        order = pythons if r % 2 == 0 else pythons[::-1]
+        for python in order:
+            cmd = [python, __file__, "--repeat", str(repeat)]
+            out = subprocess.run(cmd, capture_output=True, text=True,
+                                 check=True).stdout
+            for line in out.splitlines():
+                name, seconds = line.split()
+                times[python].setdefault(name, []).append(float(seconds))
+
+    base = pythons[0]
+    print("{:<16}".format("benchmark")
+          + "".join("{:>24}".format(python[-24:]) for python in pythons))
+    ratios = {python: [] for python in pythons[1:]}
+    for name in BENCHMARKS:
+        base_time = statistics.median(times[base][name])
+        line = "{:<16}{:>21.1f} ms".format(name, base_time * 1e3)
+        for python in pythons[1:]:
+            ratio = statistics.median(times[python][name]) / base_time
+            ratios[python].append(ratio)
+            line += "{:>23.3f}x".format(ratio)
+        print(line)
+    line = "{:<16}{:>24}".format("geometric mean", "")
+    for python in pythons[1:]:
+        mean = math.exp(sum(map(math.log, ratios[python]))
+                        / len(ratios[python]))
+        line += "{:>23.3f}x".format(mean)
+    print(line)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--compare", metavar="PYTHON", nargs="+",
+                        help="interpreters to compare, the first one being "
+                             "the reference")
+    parser.add_argument("-r", "--rounds", type=int, default=20,
+                        help="number of runs of each interpreter with "
+                             "--compare (default: 20)")
+    parser.add_argument("--repeat", type=int, default=5,
+                        help="number of timings of each workload in a run, "
+                             "of which the best is kept (default: 5)")
+    args = parser.parse_args()
+    if args.compare:
+        if len(args.compare) < 2:
+            parser.error("--compare needs at least two interpreters")
+        compare(args.compare, args.rounds, args.repeat)
+    else:
+        run_benchmarks(args.repeat)
@@ -0,0 +1,321 @@
+"""Generate superinstructions from a dynamic instruction pair profile.
+
+A superinstruction executes two adjacent instructions in one dispatch.
+This script picks the pairs to fuse from the pair profile recorded by a
+Python built with -DDYNAMIC_EXECUTION_PROFILE -DDXPAIRS (see
+Misc/SpecialBuilds.txt), and emits the code to add them to the
+interpreter: the names for Lib/opcode.py, the cases for Python/ceval.c
+and the cases for optimize() in Python/specialize.c.
+
+Record the profile of each benchmark with the pair-profiling build;
+counts are added to those already in the profile file:
+
+    ./python Tools/scripts/generate_superinstructions.py \\
+        record -o pairs.json bench.py [args ...]
+
+Then generate the code with any build:
+
+    python3 Tools/scripts/generate_superinstructions.py \\
+        generate [-n COUNT] pairs.json [pairs2.json ...]
+
+Only pairs of unspecialized instructions whose first instruction always
+falls through to the second one can be fused.  Pairs that are rejected
+are listed, with the reason, on stderr.
+"""
+
+import argparse
+import collections
+import json
+import os.path
+import re
+import sys
+import tokenize
+
+ROOT = os.path.join(os.path.dirname(__file__), "..", "..")
+OPCODE_PY = os.path.join(ROOT, "Lib", "opcode.py")
+CEVAL_C = os.path.join(ROOT, "Python", "ceval.c")
+SPECIALIZE_C = os.path.join(ROOT, "Python", "specialize.c")
+
+# Instructions that never fall through to the next one, or that leave
+# the current frame.
+NO_FALLTHROUGH = {
+    "EXTENDED_ARG",
+    "RAISE_VARARGS",
+    "RERAISE",
+    "RETURN_VALUE",
+    "YIELD_VALUE",
+}
+
+# Code in the body of an instruction that moves away from the next one.
+CONTROL_TRANSFER = re.compile(
+    r"\b(JUMPTO|JUMPBY)\(|\bgoto (start_frame|resume_frame|exit_unwind|"
+    r"exiting|error_exit)\b|\breturn\b|\bframe = "
+)
+LABEL = re.compile(r"^\s*(?!default\b)[A-Za-z_]\w*:(?!:)", re.MULTILINE)
+PREDICTED = re.compile(r"^\s*PREDICTED\(\w+\);\n", re.MULTILINE)
+PREDICT = re.compile(r"^\s*PREDICT\(\w+\);\n", re.MULTILINE)
+TRAILING_DISPATCH = re.compile(r"\s*(NOTRACE_)?DISPATCH\(\);\s*$")
+
+
+def load_opcode_module():
+    namespace = {}
+    with tokenize.open(OPCODE_PY) as fp:
+        exec(fp.read(), namespace)
+    return namespace
+
+
+def read_file(path):
+    with open(path, encoding="utf-8") as fp:
+        return fp.read()
+
+
+def instruction_bodies(ceval):
+    """Map instruction names to the body of their TARGET in ceval.c.
+
+    The body is the text between the braces that follow TARGET(name).
+    """
+    bodies = {}
+    for match in re.finditer(r"TARGET\((\w+)\) \{\n", ceval):
+        depth = 1
+        pos = match.end()
+        while depth:
+            char = ceval[pos]
+            if ceval.startswith("//", pos):
+                pos = ceval.index("\n", pos)
+            elif ceval.startswith("/*", pos):
+                pos = ceval.index("*/", pos) + 1
+            elif char in "\"'":
+                # Skip string and character literals.
+                end = pos + 1
+                while ceval[end] != char:
+                    end += 2 if ceval[end] == "\\" else 1
+                pos = end
+            elif char == "{":
+                depth += 1
+            elif char == "}":
+                depth -= 1
+            pos += 1
+        bodies[match.group(1)] = ceval[match.end():pos - 1].rstrip() + "\n"
+    return bodies
+
+
+def adaptive_instructions(specialize):
+    """Return the names of the instructions that are specialized."""
+    table = re.search(r"adaptive_opcodes\[256\] = \{(.*?)\};",
+                      specialize, re.DOTALL)
+    return set(re.findall(r"\[(\w+)\] =", table.group(1)))
+
+
+def optimize_cases(specialize):
+    """Return the opcodes already handled by the switch of optimize()."""
+    body = re.search(r"\noptimize\(.*?\n\}\n", specialize, re.DOTALL)
+    return set(re.findall(r"^                case (\w+):", body.group(0),
+                          re.MULTILINE))
+
+
+def reject_reason(first, second, context):
+    """Return why the pair cannot be fused, or None if it can."""
+    opcode, bodies, adaptive = context
+    name = f"{first}__{second}"
+    if name in opcode["_specialized_instructions"]:
+        return "already a superinstruction"
+    for op in (first, second):
+        if op in adaptive:
+            return f"{op} is specialized"
+        if op not in bodies:
+            return f"{op} has no TARGET in ceval.c"
+        if LABEL.search(PREDICTED.sub("", bodies[op])):
+            return f"{op} defines a label"
+    if second == "EXTENDED_ARG":
+        return "EXTENDED_ARG"
+    opmap = opcode["opmap"]
+    if (first in NO_FALLTHROUGH or opmap[first] in opcode["hasjrel"]
+            or opmap[first] in opcode["hasjabs"]):
+        return f"{first} does not fall through"
+    body = bodies[first]
+    if CONTROL_TRANSFER.search(body):
+        return f"{first} may not fall through"
+    if (not TRAILING_DISPATCH.search(body)
+            or len(re.findall(r"DISPATCH\(\);", body)) != 1):
+        return f"{first} does not end with its only DISPATCH()"
+    return None
+
+
+def load_profiles(paths):
+    pairs = collections.Counter()
+    for path in paths:
+        with open(path, encoding="utf-8") as fp:
+            profile = json.load(fp)
+        for first, row in profile.items():
+            for second, count in row.items():
+                pairs[first, second] += count
+    return pairs
+
+
+def select_pairs(pairs, count, min_share, context):
+    """Return the pairs to fuse and the rejected pairs, by frequency."""
+    total = sum(pairs.values()) or 1
+    selected = []
+    rejected = []
+    for (first, second), executions in pairs.most_common():
+        if len(selected) == count or executions / total < min_share:
+            break
+        reason = reject_reason(first, second, context)
+        if reason is None:
+            selected.append((first, second, executions / total))
+        else:
+            rejected.append((first, second, executions / total, reason))
+    return selected, rejected
+
+
+def indent(text, prefix):
+    return "".join(prefix + line if line.strip() else line
+                   for line in text.splitlines(True))
+
+
+def emit_target(first, second, bodies, out):
+    first_body = TRAILING_DISPATCH.sub("\n", PREDICT.sub("", bodies[first]))
+    first_body = PREDICTED.sub("", first_body)
+    second_body = PREDICTED.sub("", bodies[second])
+    out.write(f"        TARGET({first}__{second}) {{\n")
+    out.write("            {\n")
+    out.write(indent(first_body, "    "))
+    out.write("            }\n")
+    out.write("            NEXTOPARG();\n")
+    out.write("            INSTRUCTION_START();\n")
+    out.write("            {\n")
+    out.write(indent(second_body, "    "))
+    out.write("            }\n")
+    out.write("        }\n\n")
+
+
+def emit_optimize_case(second, firsts, existing, out):
+    if second in existing:
+        out.write("                /* Merge into the existing case. */\n")
+    out.write(f"                case {second}:\n")
+    if len(firsts) == 1:
+        first, = firsts
+        out.write(f"                    if (previous_opcode == {first}) {{\n")
+        out.write(f"                        instructions[i-1] = "
+                  f"_Py_MAKECODEUNIT({first}__{second}, previous_oparg);\n")
+        out.write("                    }\n")
+    else:
+        out.write("                    switch(previous_opcode) {\n")
+        for first in firsts:
+            out.write(f"                        case {first}:\n")
+            out.write(f"                            instructions[i-1] = "
+                      f"_Py_MAKECODEUNIT({first}__{second}, "
+                      f"previous_oparg);\n")
+            out.write("                            break;\n")
+        out.write("                    }\n")
+    out.write("                    break;\n")
+
+
+def generate(args):
+    opcode = load_opcode_module()
+    ceval = read_file(CEVAL_C)
+    specialize = read_file(SPECIALIZE_C)
+    bodies = instruction_bodies(ceval)
+    context = (opcode, bodies, adaptive_instructions(specialize))
+    pairs = load_profiles(args.profiles)
+    selected, rejected = select_pairs(pairs, args.count, args.min_share,
+                                      context)
+
+    for first, second, share, reason in rejected:
+        print(f"skipped {first}__{second} ({share:.1%}): {reason}",
+              file=sys.stderr)
+    for first, second, share in selected:
+        print(f"selected {first}__{second} ({share:.1%})", file=sys.stderr)
+    if not selected:
+        return
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    sources = ", ".join(os.path.basename(path) for path in args.profiles)
+    out.write("/* Generated by Tools/scripts/generate_superinstructions.py "
+              f"from {sources} */\n\n")
+
+    out.write("/* Lib/opcode.py: add to _specialized_instructions */\n\n")
+    for first, second, _ in selected:
+        out.write(f'    "{first}__{second}",\n')
+
+    out.write("\n/* Python/ceval.c: add to _PyEval_EvalFrameDefault() */\n\n")
+    for first, second, _ in selected:
+        emit_target(first, second, bodies, out)
+
+    out.write("/* Python/specialize.c: add to the switch of optimize() */\n\n")
+    by_second = collections.defaultdict(list)
+    for first, second, _ in selected:
+        by_second[second].append(first)
+    existing = optimize_cases(specialize)
+    for second, firsts in by_second.items():
+        emit_optimize_case(second, firsts, existing, out)
+
+    if out is not sys.stdout:
+        out.close()
+
+
+def record(args):
+    import runpy
+
+    if not hasattr(sys, "getdxp") or not isinstance(sys.getdxp()[0], list):
+        sys.exit("recording requires a Python built with "
+                 "-DDYNAMIC_EXECUTION_PROFILE -DDXPAIRS")
+    import opcode
+
+    profile = {}
+    if os.path.exists(args.output):
+        with open(args.output, encoding="utf-8") as fp:
+            profile = json.load(fp)
+
+    sys.argv = [args.script] + args.args
+    sys.path[0] = os.path.dirname(os.path.abspath(args.script))
+    sys.getdxp()  # Reset the profile
+    try:
+        runpy.run_path(args.script, run_name="__main__")
+    finally:
+        counts = sys.getdxp()
+        for first, row in enumerate(counts[:-1]):
+            for second, count in enumerate(row):
+                if count:
+                    first_row = profile.setdefault(opcode.opname[first], {})
+                    name = opcode.opname[second]
+                    first_row[name] = first_row.get(name, 0) + count
+        with open(args.output, "w", encoding="utf-8") as fp:
+            json.dump(profile, fp, indent=1, sort_keys=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    parser_record = commands.add_parser(
+        "record", help="record the pair profile of a script")
+    parser_record.add_argument("-o", "--output", default="pairs.json",
+                               help="profile file (default: pairs.json)")
+    parser_record.add_argument("script", help="the script to profile")
+    parser_record.add_argument("args", nargs=argparse.REMAINDER,
+                               help="arguments passed to the script")
+
+    parser_generate = commands.add_parser(
+        "generate", help="generate superinstructions from profiles")
+    parser_generate.add_argument("-n", "--count", type=int, default=8,
+                                 help="number of superinstructions to "
+                                      "generate (default: 8)")
+    parser_generate.add_argument("--min-share", type=float, default=0.005,
+                                 help="minimum share of all executed pairs "
+                                      "for a pair to be fused "
+                                      "(default: 0.005)")
+    parser_generate.add_argument("-o", "--output",
+                                 help="output file (default: stdout)")
+    parser_generate.add_argument("profiles", nargs="+",
+                                 help="profiles written by 'record'")
+
+    args = parser.parse_args()
+    if args.command == "record":
+        record(args)
+    else:
+        generate(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,97 @@
+"""Run a script with the runtime opcode profile enabled and print a summary.
+
+The profile samples the misses of the specialized instructions, with the
+reason why they could not be specialized again.  Each sample stands for
+about 50 misses.  See _opcode.enable_profile().
+
+usage: summarize_opcode_profile.py [-n TOP] script.py [args ...]
+"""
+
+import argparse
+import collections
+import dis
+import opcode
+import os.path
+import runpy
+import sys
+
+import _opcode
+
+def specialized_opnames():
+    """Map opcode numbers to names, including specialized instructions.
+
+    This mirrors the numbering done by Tools/scripts/generate_opcode_h.py.
+    """
+    names = list(opcode.opname)
+    used = [not name.startswith("<") for name in names]
+    next_op = 1
+    for name in opcode._specialized_instructions:
+        while used[next_op]:
+            next_op += 1
+        names[next_op] = name
+        used[next_op] = True
+    return names
+
+
+def location(code, offset):
+    filename = os.path.basename(code.co_filename)
+    for start, end, line in code.co_lines():
+        if start <= offset < end:
+            return f"{filename}:{line} {code.co_qualname}"
+    return f"{filename} {code.co_qualname}"
+
+
+def format_reason(reason):
+    # The failure kinds are numbered as in the specialization stats.  There
+    # is no reason if the instruction was specialized again, or not yet.
+    return "-" if reason is None else f"kind {reason}"
+
+
+def print_summary(profile, top):
+    names = specialized_opnames()
+    total = sum(profile.values())
+    if not total:
+        print("No specialization misses were sampled.")
+        return
+
+    by_opcode = collections.Counter()
+    for (code, offset, specialized, reason), count in profile.items():
+        by_opcode[names[specialized], format_reason(reason)] += count
+    print("Sampled misses by specialized opcode and reason:")
+    print(f"{'opcode':<36}{'reason':<16}{'samples':>10}")
+    for (name, reason), count in by_opcode.most_common():
+        print(f"{name:<36}{reason:<16}{count:>10}{100*count/total:>7.1f}%")
+
+    by_instruction = collections.Counter()
+    for (code, offset, specialized, reason), count in profile.items():
+        by_instruction[code, offset] += count
+    print()
+    print(f"Top {top} instructions by sampled misses:")
+    for (code, offset), count in by_instruction.most_common(top):
+        name = dis.opname[code.co_code[offset]]
+        print(f"{count:>10} {name:<24} @{offset:<5} {location(code, offset)}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--top", type=int, default=20,
+                        help="number of instructions to list (default: 20)")
+    parser.add_argument("script", help="the script to profile")
+    parser.add_argument("args", nargs=argparse.REMAINDER,
+                        help="arguments passed to the script")
+    args = parser.parse_args()
+
+    sys.argv = [args.script] + args.args
+    sys.path[0] = os.path.dirname(os.path.abspath(args.script))
+    _opcode.reset_profile()
+    _opcode.enable_profile()
+    try:
+        runpy.run_path(args.script, run_name="__main__")
+    finally:
+        _opcode.disable_profile()
+        print_summary(_opcode.get_profile(), args.top)
+        _opcode.reset_profile()
+
+
+if __name__ == "__main__":
+    main()